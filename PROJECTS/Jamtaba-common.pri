@@ -39,6 +39,7 @@ PRECOMPILED_HEADER += PreCompiledHeaders.h
 HEADERS += midi/MidiDriver.h
 HEADERS += midi/MidiMessage.h
 HEADERS += midi/MidiMessageBuffer.h
+HEADERS += midi/MidiEventQueue.h
 HEADERS += audio/core/AudioDriver.h
 HEADERS += audio/core/AudioNode.h
 HEADERS += audio/core/LocalInputNode.h
@@ -46,6 +47,7 @@ HEADERS += audio/core/LocalInputGroup.h
 HEADERS += audio/core/AudioNodeProcessor.h
 HEADERS += audio/core/AudioMixer.h
 HEADERS += audio/core/SamplesBuffer.h
+HEADERS += audio/core/SamplesRingBuffer.h
 HEADERS += audio/core/AudioPeak.h
 HEADERS += audio/core/Plugins.h
 HEADERS += audio/core/Filters.h
@@ -124,14 +126,23 @@ HEADERS += gui/ThemeLoader.h
 HEADERS += ninjam/UserChannel.h
 HEADERS += geo/IpToLocationResolver.h
 HEADERS += geo/WebIpToLocationResolver.h
+HEADERS += geo/IpToLocationLITEResolver.h
+HEADERS += geo/IP2LocationDatabase.h
+HEADERS += geo/LocationCache.h
 HEADERS += Utils.h
 HEADERS += Configurator.h
 HEADERS += persistence/Settings.h
 HEADERS += persistence/UsersDataCache.h
 HEADERS += persistence/CacheHeader.h
+HEADERS += persistence/PluginScanCache.h
 HEADERS += log/Logging.h
+HEADERS += log/LogWriter.h
 HEADERS += UploadIntervalData.h
+HEADERS += StartupTimeline.h
 HEADERS += performance/PerformanceMonitor.h
+HEADERS += performance/ThreadRoles.h
+HEADERS += performance/AudioCallbackStatistics.h
+HEADERS += performance/PerformanceHistory.h
 
 SOURCES += MainController.cpp
 SOURCES += NinjamController.cpp
@@ -139,6 +150,7 @@ SOURCES += MetronomeUtils.cpp
 SOURCES += midi/MidiDriver.cpp
 SOURCES += midi/MidiMessage.cpp
 SOURCES += midi/MidiMessageBuffer.cpp
+SOURCES += midi/MidiEventQueue.cpp
 SOURCES += audio/core/AudioDriver.cpp
 SOURCES += audio/core/AudioNode.cpp
 SOURCES += audio/core/LocalInputNode.cpp
@@ -152,6 +164,7 @@ SOURCES += audio/codec.cpp
 SOURCES += audio/NinjamTrackNode.cpp
 SOURCES += audio/MetronomeTrackNode.cpp
 SOURCES += audio/core/SamplesBuffer.cpp
+SOURCES += audio/core/SamplesRingBuffer.cpp
 SOURCES += audio/core/PluginDescriptor.cpp
 SOURCES += audio/SamplesBufferResampler.cpp
 SOURCES += audio/vorbis/VorbisDecoder.cpp
@@ -223,13 +236,22 @@ SOURCES += gui/GuiUtils.cpp
 SOURCES += gui/ThemeLoader.cpp
 SOURCES += geo/IpToLocationResolver.cpp
 SOURCES += log/logging.cpp
+SOURCES += log/LogWriter.cpp
 SOURCES += geo/WebIpToLocationResolver.cpp
+SOURCES += geo/IpToLocationLITEResolver.cpp
+SOURCES += geo/IP2LocationDatabase.cpp
+SOURCES += geo/LocationCache.cpp
 SOURCES += loginserver/LoginService.cpp
 SOURCES += Configurator.cpp
 SOURCES += persistence/UsersDataCache.cpp
 SOURCES += persistence/Settings.cpp
 SOURCES += persistence/CacheHeader.cpp
+SOURCES += persistence/PluginScanCache.cpp
 SOURCES += UploadIntervalData.cpp
+SOURCES += StartupTimeline.cpp
+SOURCES += performance/ThreadRoles.cpp
+SOURCES += performance/AudioCallbackStatistics.cpp
+SOURCES += performance/PerformanceHistory.cpp
 
 #multiplatform implementations
 win32:SOURCES += performance/WindowsPerformanceMonitor.cpp
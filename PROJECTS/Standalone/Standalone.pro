@@ -98,6 +98,17 @@ macx{
 linux{
     SOURCES += audio/LinuxPortAudioDriver.cpp
     SOURCES += vst/LinuxVstPluginChecker.cpp
+
+    #native JACK driver, used when the JACK server is running
+    packagesExist(jack) {
+        message("Building with JACK support")
+        CONFIG += link_pkgconfig
+        PKGCONFIG += jack
+        DEFINES += JT_JACK_DRIVER
+
+        HEADERS += audio/JackAudioDriver.h
+        SOURCES += audio/JackAudioDriver.cpp
+    }
 }
 
 
@@ -47,6 +47,7 @@ SOURCES += vst/VstLoader.cpp
 SOURCES += vst/Utils.cpp
 SOURCES += audio/core/PluginDescriptor.cpp
 SOURCES += midi/MidiMessage.cpp
+SOURCES += midi/MidiMessageBuffer.cpp
 SOURCES += log/logging.cpp
 
 
@@ -4,8 +4,12 @@
 #include <QApplication>
 #include <QStandardPaths>
 #include <QTime>
+#include <cstdio>
+#include <cstring>
 
 #include "log/Logging.h"
+#include "log/LogWriter.h"
+#include "performance/ThreadRoles.h"
 
 QScopedPointer<Configurator> Configurator::instance(nullptr);
 
@@ -25,35 +29,113 @@ const QString Configurator::THEMES_FOLDER_IN_RESOURCES = ":/css/themes";
 #define COLOR_FATAL         "\033[31;1m"
 #define COLOR_RESET         "\033[0m"
 
-QString Configurator::getDebugColor(const QMessageLogContext &context)
+const char *Configurator::getDebugColor(const QMessageLogContext &context)
 {
-    QString category(context.category);
-    if (category == QString(jtMidi().categoryName()))
+    if (qstrcmp(context.category, jtMidi().categoryName()) == 0)
         return COLOR_DEBUG_MIDI;
-    else if (category == QString(jtAudio().categoryName()))
+    else if (qstrcmp(context.category, jtAudio().categoryName()) == 0)
         return COLOR_DEBUG_AUDIO;
-    else if (category == QString(jtGUI().categoryName()))
+    else if (qstrcmp(context.category, jtGUI().categoryName()) == 0)
         return COLOR_DEBUG_GUI;
 
     return COLOR_DEBUG;
 }
 
+namespace {
+
+/***
+    Appends text in a fixed size char buffer, the text is truncated when the buffer is full. Used
+    to format the log records in the stack, without QString/QByteArray temporaries.
+ */
+class RecordFormatter
+{
+public:
+    RecordFormatter(char *buffer, int capacity) :
+        buffer(buffer),
+        capacity(capacity),
+        length(0)
+    {
+    }
+
+    void append(const char *text)
+    {
+        while (text && *text && length < capacity)
+            buffer[length++] = *text++;
+    }
+
+    void appendPadding(int column) // spaces until 'column'
+    {
+        while (length < column && length < capacity)
+            buffer[length++] = ' ';
+    }
+
+    void appendUtf8(const QString &text) // QString::toUtf8() is allocating
+    {
+        const QChar *chars = text.constData();
+        int size = text.size();
+        for (int i = 0; i < size; ++i) {
+            uint code = chars[i].unicode();
+            if (QChar::isHighSurrogate(code) && i + 1 < size && chars[i + 1].isLowSurrogate())
+                code = QChar::surrogateToUcs4(static_cast<ushort>(code), chars[++i].unicode());
+
+            char bytes[4];
+            int count;
+            if (code < 0x80) {
+                bytes[0] = static_cast<char>(code);
+                count = 1;
+            }
+            else if (code < 0x800) {
+                bytes[0] = static_cast<char>(0xC0 | (code >> 6));
+                bytes[1] = static_cast<char>(0x80 | (code & 0x3F));
+                count = 2;
+            }
+            else if (code < 0x10000) {
+                bytes[0] = static_cast<char>(0xE0 | (code >> 12));
+                bytes[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                bytes[2] = static_cast<char>(0x80 | (code & 0x3F));
+                count = 3;
+            }
+            else {
+                bytes[0] = static_cast<char>(0xF0 | (code >> 18));
+                bytes[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                bytes[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                bytes[3] = static_cast<char>(0x80 | (code & 0x3F));
+                count = 4;
+            }
+
+            if (length + count > capacity)
+                return; // the last char is not splitted
+
+            std::memcpy(buffer + length, bytes, count);
+            length += count;
+        }
+    }
+
+    inline int getLength() const
+    {
+        return length;
+    }
+
+private:
+    char *buffer;
+    int capacity;
+    int length;
+};
+
+}
+
+// called from any thread, including the audio thread. The message is formatted in a stack buffer, the log file is written by LogWriter thread
 void Configurator::logHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    QByteArray localMsg = msg.toLocal8Bit();
-    QString stringMsg;
-    QString fullFileName(context.file);
-    QString file;
-    int lastPathSeparatorIndex = fullFileName.lastIndexOf(QDir::separator());
-    if (lastPathSeparatorIndex)
-        file = fullFileName.right(fullFileName.size() - lastPathSeparatorIndex - 1);
-    else
-        file = fullFileName;
+    const char *file = context.file ? context.file : "";
+    for (const char *c = file; *c; ++c) {
+        if (*c == '/' || *c == '\\')
+            file = c + 1;
+    }
 
-    QString messageType;
-    QString messageColor;
+    const char *messageType;
+    const char *messageColor;
 
-    QTextStream stream(&stringMsg);
     switch (type) {
     case QtDebugMsg:    messageType = "DEBUG   ";   messageColor = getDebugColor(context);   break;
     case QtWarningMsg:  messageType = "WARNING ";   messageColor = COLOR_WARN;   break;
@@ -63,40 +145,55 @@ void Configurator::logHandler(QtMsgType type, const QMessageLogContext &context,
         messageType = "INFO    "; messageColor = COLOR_RESET;
     }
 
-    QString timeStamp(QTime::currentTime().toString("hh:mm:ss:zzz"));
-
-    stream << messageColor
-           << QString(QString(context.category) + "." + messageType).leftJustified(17, ' ')
-           << " [" << timeStamp << "] "
-           << localMsg.constData()
-           << COLOR_RESET << " [" << file << ", line " << context.line << "]" << endl;
-
-    QTextStream(stdout) << stringMsg;
-
-    Configurator *configurator = Configurator::getInstance();
-    QDir logDir = configurator->getBaseDir();
-    QString path = logDir.absoluteFilePath("log.txt");
-
-    QFile outFile(path);
-    QIODevice::OpenMode ioFlags = QIODevice::WriteOnly;
-    if (configurator->logFileIsCreated()) {
-        ioFlags |= QIODevice::Append;
-    } else {
-        ioFlags |= QIODevice::Truncate;
-        configurator->setFileCreatedFlag();
+    // the file name and line are formatted first, so long messages are truncated without losing them
+    char location[256];
+    int locationLength = qsnprintf(location, sizeof(location), " [%s, line %d]\n", file, context.line);
+    locationLength = qBound(0, locationLength, static_cast<int>(sizeof(location)) - 1);
+
+    QTime time(QTime::currentTime());
+    char timeStamp[32];
+    qsnprintf(timeStamp, sizeof(timeStamp), " [%02d:%02d:%02d:%03d] ", time.hour(), time.minute(),
+              time.second(), time.msec());
+
+    char record[Log::LogRecord::MAX_RECORD_SIZE];
+    RecordFormatter formatter(record, Log::LogRecord::MAX_RECORD_SIZE - locationLength);
+    formatter.append(context.category);
+    formatter.append(".");
+    formatter.append(messageType);
+    formatter.appendPadding(17);
+    formatter.append(timeStamp);
+    formatter.appendUtf8(msg);
+
+    int coloredLength = formatter.getLength(); // the file name and line are not colored in console
+    std::memcpy(record + coloredLength, location, locationLength);
+    int recordLength = coloredLength + locationLength;
+
+    Log::LogWriter *logWriter = Configurator::getInstance()->logWriter.data();
+    if (logWriter) {
+        logWriter->write(record, recordLength, coloredLength, messageColor); // the message is dropped if the log queue is full
+        if (type == QtFatalMsg)
+            logWriter->flush();
     }
-    if (outFile.open(ioFlags)) {
-        QTextStream ts(&outFile);
-        ts << stringMsg.replace(QRegularExpression("\\033\\[[0-6]{1,2}(;1)?m"), ""); // remove ANSI color codes from log file
+    else {
+        std::fprintf(stdout, "%s%.*s%s%.*s", messageColor, coloredLength, record, COLOR_RESET,
+                     locationLength, location);
+        std::fflush(stdout);
     }
 
     if (type == QtFatalMsg)
         abort();
 }
 
+void Configurator::applyLoggingThreadPolicy()
+{
+    if (!logWriter.isNull())
+        logWriter->runInWriterThread([]() {
+            ThreadRoles::applyToCurrentThread(ThreadRoles::Logging);
+        });
+}
+
 Configurator::Configurator() :
-    logConfigFileName(LOG_CONFIG_FILE_NAME),
-    logFileCreated(false)
+    logConfigFileName(LOG_CONFIG_FILE_NAME)
 {
 
 }
@@ -222,6 +319,13 @@ void Configurator::setupLogConfigFile()
     QString logConfigFilePath = baseDir.absoluteFilePath(logConfigFileName);
     if (!logConfigFilePath.isEmpty()) {
         qputenv("QT_LOGGING_CONF", QByteArray(logConfigFilePath.toUtf8()));
+
+        if (logWriter.isNull()) {
+            logWriter.reset(new Log::LogWriter(baseDir.absoluteFilePath("log.txt")));
+            logWriter->setEchoToConsole(true);
+            logWriter->start(QThread::LowPriority);
+        }
+
         qInstallMessageHandler(&Configurator::logHandler);
     }
     else {
@@ -326,6 +430,10 @@ void Configurator::deletePreset(const QString &name)
 
 Configurator::~Configurator()
 {
+    if (!logWriter.isNull()) {
+        qInstallMessageHandler(nullptr); // default Qt handler
+        logWriter->stop(); // write the queued messages
+    }
 }
 
 // -------------------------------------------------------------------------------
@@ -9,6 +9,10 @@
 #define VERSION "2.0.19"
 #define APP_VERSION VERSION
 
+namespace Log {
+class LogWriter;
+}
+
 // ! Configurator class for Jamtaba !
 // ! Easy to use , it is intended to create the folders tree in the user local folder.
 // ! It will create on folder for the plugin version , where the log file and the config
@@ -21,11 +25,10 @@ public:
 
     ~Configurator();
 
-    bool logFileIsCreated() const;
-    void setFileCreatedFlag();
-
     bool setUp();
 
+    void applyLoggingThreadPolicy(); // called when the thread policies are loaded from settings, the LogWriter thread is started before
+
     bool folderTreeExists() const; // check if Jamtaba 2 folder exists in application data
 
     QDir getCacheDir() const;
@@ -55,7 +58,7 @@ private:
     QDir baseDir;
     QDir themesDir;
 
-    bool logFileCreated;
+    QScopedPointer<Log::LogWriter> logWriter; // log.txt is written in a background thread
 
     static QScopedPointer<Configurator> instance;// using a QScopedPointer to auto delete the singleton instance and avoid leak
 
@@ -72,20 +75,10 @@ private:
 
     static void logHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg);
 
-    static QString getDebugColor(const QMessageLogContext &context);
+    static const char *getDebugColor(const QMessageLogContext &context);
 };
 
 
-inline bool Configurator::logFileIsCreated() const
-{
-    return logFileCreated;
-}
-
-inline void Configurator::setFileCreatedFlag()
-{
-    logFileCreated = true;
-}
-
 inline QDir Configurator::getCacheDir() const
 {
     return cacheDir;
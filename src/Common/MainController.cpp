@@ -5,12 +5,16 @@
 #include "gui/MainWindow.h"
 #include "NinjamController.h"
 #include "geo/WebIpToLocationResolver.h"
+#include "geo/IpToLocationLITEResolver.h"
 #include "Utils.h"
 #include "loginserver/natmap.h"
 #include "log/Logging.h"
 #include "audio/core/AudioNode.h"
 #include "audio/core/LocalInputNode.h"
 #include "ThemeLoader.h"
+#include "performance/ThreadRoles.h"
+
+#include <QElapsedTimer>
 
 using namespace Persistence;
 using namespace Midi;
@@ -33,7 +37,7 @@ MainController::MainController(const Settings &settings) :
 {
 
     QDir cacheDir = Configurator::getInstance()->getCacheDir();
-    ipToLocationResolver.reset( new Geo::WebIpToLocationResolver(cacheDir));
+    ipToLocationResolver.reset(createIpToLocationResolver(cacheDir));
 
     connect(ipToLocationResolver.data(), SIGNAL(ipResolved(const QString &)), this, SIGNAL(ipResolved(const QString &)));
 
@@ -42,6 +46,22 @@ MainController::MainController(const Settings &settings) :
     jamRecorders.append(new Recorder::JamRecorder(new Recorder::ClipSortLogGenerator()));
 }
 
+Geo::IpToLocationResolver *MainController::createIpToLocationResolver(const QDir &cacheDir)
+{
+    // using the local IP2Location LITE database when available, the web service is used as fallback
+    QString databaseFile = Geo::IpToLocationLITEResolver::findDatabaseFile(cacheDir);
+    if (!databaseFile.isEmpty()) {
+        Geo::IpToLocationLITEResolver *liteResolver = new Geo::IpToLocationLITEResolver(databaseFile);
+        if (liteResolver->isValid()) {
+            qCDebug(jtIpToLocation) << "Using the IP2Location database " << databaseFile;
+            return liteResolver;
+        }
+        delete liteResolver;
+    }
+
+    return new Geo::WebIpToLocationResolver(cacheDir);
+}
+
 void MainController::setChannelReceiveStatus(const QString &userFullName, quint8 channelIndex, bool receiveChannel)
 {
     if (isPlayingInNinjamRoom())
@@ -424,7 +444,10 @@ void MainController::removeTrack(long trackID)
 void MainController::doAudioProcess(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                                     int sampleRate)
 {
-    audioMixer.process(in, out, sampleRate, pullMidiMessagesFromDevices());
+    Midi::MidiMessageBuffer midiBuffer; // fixed size buffer, no allocations in audio thread
+    pullMidiMessagesFromDevices(midiBuffer, out.getFrameLenght());
+
+    audioMixer.process(in, out, sampleRate, midiBuffer);
 
     out.applyGain(masterGain, 1.0f);// using 1 as boost factor/multiplier (no boost)
     masterPeak.update(out.computePeak());
@@ -433,16 +456,23 @@ void MainController::doAudioProcess(const Audio::SamplesBuffer &in, Audio::Sampl
 void MainController::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                              int sampleRate)
 {
-    QMutexLocker locker(&mutex);
-    if (!started)
-        return;
+    QElapsedTimer processingTimer;
+    processingTimer.start();
 
-    if (!isPlayingInNinjamRoom()) {
-        doAudioProcess(in, out, sampleRate);
-    } else {
-        if (ninjamController)
-            ninjamController->process(in, out, sampleRate);
+    {
+        QMutexLocker locker(&mutex);
+        if (!started)
+            return;
+
+        if (!isPlayingInNinjamRoom()) {
+            doAudioProcess(in, out, sampleRate);
+        } else {
+            if (ninjamController)
+                ninjamController->process(in, out, sampleRate);
+        }
     }
+
+    audioCallbackStatistics.addCallback(processingTimer.nsecsElapsed(), out.getFrameLenght(), sampleRate);
 }
 
 Audio::AudioPeak MainController::getTrackPeak(int trackID)
@@ -714,6 +744,13 @@ void MainController::start()
 {
     if (!started) {
 
+        // used by each thread when the role policy is applied, the threads started before keep their policies
+        for (int role = 0; role < ThreadRoles::RolesCount; ++role) {
+            ThreadRoles::Role threadRole = static_cast<ThreadRoles::Role>(role);
+            ThreadRoles::setPolicy(threadRole, settings.getThreadPolicy(threadRole));
+        }
+        Configurator::getInstance()->applyLoggingThreadPolicy();
+
         qCInfo(jtCore) << "Creating roomStreamer ...";
         roomStreamer.reset(new Audio::NinjamRoomStreamerNode()); // new Audio::AudioFileStreamerNode(":/teste.mp3");
         this->audioMixer.addNode(roomStreamer.data());
@@ -15,6 +15,7 @@
 #include "midi/MidiDriver.h"
 #include "UploadIntervalData.h"
 #include "audio/core/LocalInputGroup.h"
+#include "performance/AudioCallbackStatistics.h"
 
 class MainWindow;
 
@@ -48,7 +49,7 @@ public:
         this->mainWindow = mainWindow;
     }
 
-    virtual Midi::MidiMessageBuffer pullMidiMessagesFromPlugins() = 0; // pull midi messages generated by plugins. This function can be called many times in each audio processing cicle because every VSTi can be a midi messages generator, and we need get the generated messages after call the plugin 'process' function.
+    virtual void pullMidiMessagesFromPlugins(Midi::MidiMessageBuffer &outBuffer) = 0; // pull midi messages generated by plugins. This function can be called many times in each audio processing cicle because every VSTi can be a midi messages generator, and we need get the generated messages after call the plugin 'process' function.
 
     void saveLastUserSettings(const Persistence::LocalInputTrackSettings &inputsSettings);
 
@@ -61,6 +62,12 @@ public:
     // main audio processing routine
     virtual void process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out, int sampleRate);
 
+    // DSP load measured in process(), xruns are reported by the audio drivers
+    inline AudioCallbackStatistics &getAudioCallbackStatistics()
+    {
+        return audioCallbackStatistics;
+    }
+
     void sendNewChannelsNames(const QStringList &channelsNames);
     void sendRemovedChannelMessage(int removedChannelIndex);
 
@@ -301,6 +308,8 @@ protected:
 
     Audio::AudioMixer audioMixer;
 
+    AudioCallbackStatistics audioCallbackStatistics;
+
     // ninjam
     Ninjam::Service ninjamService;
     QScopedPointer<Controller::NinjamController> ninjamController;
@@ -322,7 +331,7 @@ protected:
 
     virtual void setCSS(const QString &css) = 0;
 
-    virtual Midi::MidiMessageBuffer pullMidiMessagesFromDevices() = 0; // pull midi messages generated by midi controllers. This function is called just one time in each audio processing cicle.
+    virtual void pullMidiMessagesFromDevices(Midi::MidiMessageBuffer &outBuffer, int audioBlockFrames) = 0; // pull midi messages generated by midi controllers. This function is called just one time in each audio processing cicle.
 
     // audio process is here too (see MainController::process)
     virtual void doAudioProcess(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out, int sampleRate);
@@ -346,6 +355,8 @@ private:
 
     QScopedPointer<Geo::IpToLocationResolver> ipToLocationResolver;
 
+    static Geo::IpToLocationResolver *createIpToLocationResolver(const QDir &cacheDir);
+
     QList<Recorder::JamRecorder *> jamRecorders;
 
     inline QList<Recorder::JamRecorder *> getActiveRecorders() const {
@@ -8,6 +8,7 @@
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
+#include <QDateTime>
 #include <QDebug>
 
 using namespace Audio;
@@ -15,6 +16,8 @@ using namespace Audio;
 const QString MetronomeUtils::DEFAULT_BUILT_IN_METRONOME_ALIAS("Default");
 const QString MetronomeUtils::DEFAULT_BUILT_IN_METRONOME_DIR(":/metronome");
 
+QMap<QString, QSharedPointer<Audio::SamplesBuffer>> MetronomeUtils::soundsCache;
+
 QList<QString> MetronomeUtils::getBuiltInMetronomeAliases()
 {
     QDir metronomeDir(DEFAULT_BUILT_IN_METRONOME_DIR);
@@ -96,7 +99,34 @@ void MetronomeUtils::removeSilenceInBufferStart(Audio::SamplesBuffer &buffer)
     }
 }
 
+QString MetronomeUtils::buildSoundsCacheKey(const QString &audioFilePath, quint32 localSampleRate)
+{
+    // the modification time is used to detect changes in custom metronome files
+    QFileInfo fileInfo(audioFilePath);
+    QString lastModified = QString::number(fileInfo.lastModified().toMSecsSinceEpoch());
+    return fileInfo.absoluteFilePath() + ";" + lastModified + ";" + QString::number(localSampleRate);
+}
+
 void MetronomeUtils::createBuffer(const QString &audioFilePath, Audio::SamplesBuffer &outBuffer, quint32 localSampleRate)
+{
+    QString cacheKey = buildSoundsCacheKey(audioFilePath, localSampleRate);
+    QSharedPointer<Audio::SamplesBuffer> cachedBuffer = soundsCache.value(cacheKey);
+    if (!cachedBuffer) {
+        cachedBuffer.reset(new Audio::SamplesBuffer(2));
+        decodeBuffer(audioFilePath, *cachedBuffer, localSampleRate);
+        removeSilenceInBufferStart(*cachedBuffer);
+        soundsCache.insert(cacheKey, cachedBuffer);
+    }
+
+    if (cachedBuffer->isMono())
+        outBuffer.setToMono();
+    else
+        outBuffer.setToStereo();
+    outBuffer.setFrameLenght(cachedBuffer->getFrameLenght());
+    outBuffer.set(*cachedBuffer);
+}
+
+void MetronomeUtils::decodeBuffer(const QString &audioFilePath, Audio::SamplesBuffer &outBuffer, quint32 localSampleRate)
 {
     qDebug() << "Creating audio buffer to file " << audioFilePath;
 
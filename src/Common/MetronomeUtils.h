@@ -3,6 +3,8 @@
 
 #include <QFile>
 #include <QList>
+#include <QMap>
+#include <QSharedPointer>
 
 class QString;
 
@@ -23,7 +25,10 @@ public:
 
     static QList<QString> getBuiltInMetronomeAliases();
 private:
+    // the click sounds are decoded, resampled and trimmed only once for each sample rate
     static void createBuffer(const QString &audioFilePath, Audio::SamplesBuffer &outBuffer, quint32 localSampleRate);
+    static void decodeBuffer(const QString &audioFilePath, Audio::SamplesBuffer &outBuffer, quint32 localSampleRate);
+    static QString buildSoundsCacheKey(const QString &audioFilePath, quint32 localSampleRate);
     static void createResampledBuffer(const Audio::SamplesBuffer &buffer, Audio::SamplesBuffer &outBuffer, int originalSampleRate,
                                          int finalSampleRate);
 
@@ -31,6 +36,8 @@ private:
 
     static const QString DEFAULT_BUILT_IN_METRONOME_ALIAS;
     static const QString DEFAULT_BUILT_IN_METRONOME_DIR;
+
+    static QMap<QString, QSharedPointer<Audio::SamplesBuffer>> soundsCache; // used only in main thread
 };
 
 }//namespace
@@ -28,6 +28,7 @@
 #include "Utils.h"
 #include <QWaitCondition>
 #include "log/Logging.h"
+#include "performance/ThreadRoles.h"
 
 using namespace Controller;
 
@@ -64,6 +65,7 @@ public:
 
 protected:
     void run(){
+        ThreadRoles::applyToCurrentThread(ThreadRoles::Encoding);
         while(!stopRequested){
             mutex.lock();
             if(chunksToEncode.isEmpty()){
@@ -135,6 +137,7 @@ public:
     void process(){
         controller->currentBpi = newBpi;
         controller->samplesInInterval = controller->computeTotalSamplesInInterval();
+        controller->metronomeTrackNode->setBeatsPerInterval(newBpi);
         emit controller->currentBpiChanged(controller->currentBpi);
     }
 private:
@@ -168,6 +171,9 @@ class NinjamController::InputChannelChangedEvent : public SchedulableEvent{
 
 QList<QString> NinjamController::chatBlockedUsers; // initializing the static member
 
+const qint64 NinjamController::DEFAULT_INTERVALS_MEMORY_BUDGET = 64 * 1024 * 1024; // 64 MB, ~3 intervals per channel in a full room
+const int NinjamController::DEFAULT_MAX_SILENT_INTERVALS = 4;
+
 NinjamController::NinjamController(Controller::MainController* mainController)
     :mainController(mainController),
     metronomeTrackNode(createMetronomeTrackNode( mainController->getSampleRate())),
@@ -180,10 +186,15 @@ NinjamController::NinjamController(Controller::MainController* mainController)
     encodersMutex(QMutex::Recursive),
     encodingThread(nullptr),
     preparedForTransmit(false),
-    waitingIntervals(0)//waiting for start transmit
+    waitingIntervals(0),//waiting for start transmit
+    intervalsMemoryBudget(DEFAULT_INTERVALS_MEMORY_BUDGET),
+    maxSilentIntervals(DEFAULT_MAX_SILENT_INTERVALS)
 {
     running = false;
 
+    //startingNewInterval is emitted in audio thread, the silent tracks buffers are released in main thread
+    connect(this, &NinjamController::startingNewInterval, this, &NinjamController::releaseSilentTracksBuffers, Qt::QueuedConnection);
+
 }
 
 
@@ -208,10 +219,30 @@ void NinjamController::setBpm(int newBpm){
 }
 
 void NinjamController::removeEncoder(int groupChannelIndex){
-    QMutexLocker locker(&mutex);
+    QMutexLocker locker(&encodersMutex);
     if(encoders.contains(groupChannelIndex)){
-        encoders.remove(groupChannelIndex);
+        recycleEncoder(encoders.take(groupChannelIndex));
+    }
+}
+
+void NinjamController::recycleEncoder(VorbisEncoder *encoder){
+    encoder->reset(); //the interval in progress is discarded
+    recycledEncoders.append(encoder);
+    if(recycledEncoders.size() > MAX_RECYCLED_ENCODERS){
+        delete recycledEncoders.takeFirst(); //discard the oldest
+    }
+}
+
+VorbisEncoder *NinjamController::createEncoder(int channels, int sampleRate, float quality){
+    for (int i = recycledEncoders.size() - 1; i >= 0; --i) {
+        VorbisEncoder *encoder = recycledEncoders.at(i);
+        if(encoder->getChannels() == channels && encoder->getSampleRate() == sampleRate
+                && qFuzzyCompare(encoder->getQuality(), quality)){
+            recycledEncoders.removeAt(i);
+            return encoder;
+        }
     }
+    return new VorbisEncoder(channels, sampleRate, quality);
 }
 
 //+++++++++++++++++++++++++ THE MAIN LOGIC IS HERE  ++++++++++++++++++++++++++++++++++++++++++++++++
@@ -307,9 +338,7 @@ Audio::MetronomeTrackNode* NinjamController::createMetronomeTrackNode(int sample
         Audio::MetronomeUtils::createCustomSounds(firstBeatAudioFile, secondaryBeatAudioFile, firstBeatBuffer, secondaryBeatBuffer, sampleRate);
     }
 
-    Audio::MetronomeUtils::removeSilenceInBufferStart(firstBeatBuffer);
-    Audio::MetronomeUtils::removeSilenceInBufferStart(secondaryBeatBuffer);
-
+    // the click sounds are cached (trimmed and resampled), recreating the metronome is cheap
     return new Audio::MetronomeTrackNode(firstBeatBuffer, secondaryBeatBuffer);
 }
 
@@ -327,6 +356,7 @@ void NinjamController::recreateMetronome(int newSampleRate)
     //recreate metronome using the new sample rate
     this->metronomeTrackNode = createMetronomeTrackNode(newSampleRate);
     this->metronomeTrackNode->setSamplesPerBeat(getSamplesPerBeat());
+    this->metronomeTrackNode->setBeatsPerInterval(currentBpi);
     this->metronomeTrackNode->setGain( oldGain );
     this->metronomeTrackNode->setPan( oldPan );
     this->metronomeTrackNode->setMute( oldMutedStatus );
@@ -366,10 +396,13 @@ void NinjamController::stop(bool emitDisconnectedingSignal){
         encodingThread = nullptr;
     }
 
-    foreach (VorbisEncoder* encoder, encoders.values()) {
-        delete encoder;
+    {
+        QMutexLocker locker(&encodersMutex);
+        foreach (VorbisEncoder* encoder, encoders.values()) {
+            recycleEncoder(encoder); //reused if we connect again
+        }
+        encoders.clear();
     }
-    encoders.clear();
 
     //delete possible non consumed events
     foreach (SchedulableEvent *e, scheduledEvents)
@@ -407,6 +440,8 @@ NinjamController::~NinjamController(){
         delete e;
     }
 
+    qDeleteAll(encoders);
+    qDeleteAll(recycledEncoders);
 }
 //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void NinjamController::start(const Ninjam::Server& server){
@@ -718,6 +753,7 @@ void NinjamController::on_ninjamAudiointervalCompleted(const Ninjam::User &user,
         NinjamTrackNode* trackNode = trackNodes[channelKey];
         if(trackNode){
             trackNode->addVorbisEncodedInterval(encodedAudioData);
+            enforceIntervalsMemoryBudget();
             emit channelAudioFullyDownloaded(trackNode->getID());
         }
     }
@@ -726,6 +762,66 @@ void NinjamController::on_ninjamAudiointervalCompleted(const Ninjam::User &user,
     }
 }
 
+void NinjamController::setIntervalsMemoryBudget(qint64 maxBytes){
+    QMutexLocker locker(&mutex);
+    intervalsMemoryBudget = maxBytes;
+    enforceIntervalsMemoryBudget();
+}
+
+qint64 NinjamController::getBufferedIntervalsBytes(){
+    QMutexLocker locker(&mutex);
+    qint64 bufferedBytes = 0;
+    foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
+        bufferedBytes += trackNode->getBufferedBytes();
+    }
+    return bufferedBytes;
+}
+
+void NinjamController::enforceIntervalsMemoryBudget(){
+    if(intervalsMemoryBudget <= 0){
+        return; //no limit
+    }
+
+    qint64 bufferedBytes = 0;
+    foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
+        bufferedBytes += trackNode->getBufferedBytes();
+    }
+
+    while(bufferedBytes > intervalsMemoryBudget){
+        //the oldest downloaded interval (in all tracks) waiting to be played is discarded first
+        NinjamTrackNode* oldestIntervalTrack = nullptr;
+        qint64 oldestIntervalSequence = -1;
+        foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
+            qint64 sequence = trackNode->getOldestPendingIntervalSequence();
+            if(sequence >= 0 && (!oldestIntervalTrack || sequence < oldestIntervalSequence)){
+                oldestIntervalTrack = trackNode;
+                oldestIntervalSequence = sequence;
+            }
+        }
+
+        if(!oldestIntervalTrack){
+            break; //only the playing intervals are buffered
+        }
+
+        bufferedBytes -= oldestIntervalTrack->discardOldestPendingInterval();
+        qCWarning(jtNinjamCore) << "Intervals memory budget exceeded, discarding one interval in track" << oldestIntervalTrack->getID()
+                                << "buffered bytes:" << bufferedBytes;
+    }
+}
+
+void NinjamController::setMaxSilentIntervals(int intervals){
+    maxSilentIntervals = intervals;
+}
+
+void NinjamController::releaseSilentTracksBuffers(){
+    QMutexLocker locker(&mutex);
+    foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
+        if(trackNode->releaseBuffersIfSilent(maxSilentIntervals)){
+            qCDebug(jtNinjamCore) << "Track" << trackNode->getID() << "is silent in the last" << trackNode->getSilentIntervals() << "intervals, buffers released";
+        }
+    }
+}
+
 void NinjamController::reset(bool keepRecentIntervals){
     QMutexLocker locker(&mutex);
     foreach (NinjamTrackNode* trackNode, trackNodes.values()) {
@@ -769,20 +865,20 @@ void NinjamController::recreateEncoderForChannel(int channelIndex){
     if(!encoders.contains(channelIndex) || currentEncoderIsInvalid){//a new encoder is necessary?
         //qDebug() << "recreating encoder for channel index" << channelIndex;
         if(currentEncoderIsInvalid){
-            delete encoders[channelIndex];
+            recycleEncoder(encoders[channelIndex]);
         }
 
         int sampleRate = mainController->getSampleRate();
         float encodingQuality = mainController->getEncodingQuality();
-        encoders[channelIndex] = new VorbisEncoder(maxChannelsForEncoding, sampleRate, encodingQuality);
+        encoders[channelIndex] = createEncoder(maxChannelsForEncoding, sampleRate, encodingQuality);
     }
 }
 
 void NinjamController::recreateEncoders(){
     if(isRunning()){
         QMutexLocker locker(&encodersMutex); //this method is called from main thread, and the encoders are used in audio thread every time
-        for (int e = 0; e < encoders.size(); ++e) {
-            delete encoders[e];
+        foreach (VorbisEncoder *encoder, encoders.values()) {
+            recycleEncoder(encoder);
         }
         encoders.clear();//new encoders will be create on demand
 
@@ -70,6 +70,26 @@ public:
 
     void reset(bool keepRecentIntervals);// discard downloaded intervals and reset intervalPosition
 
+    // memory used by all downloaded intervals. When the budget is exceeded the oldest not started intervals are discarded
+    void setIntervalsMemoryBudget(qint64 maxBytes);
+    inline qint64 getIntervalsMemoryBudget() const
+    {
+        return intervalsMemoryBudget;
+    }
+
+    qint64 getBufferedIntervalsBytes();
+
+    static const qint64 DEFAULT_INTERVALS_MEMORY_BUDGET;
+
+    // the decoders and resampler of tracks silent for 'intervals' are released, zero to keep the buffers
+    void setMaxSilentIntervals(int intervals);
+    inline int getMaxSilentIntervals() const
+    {
+        return maxSilentIntervals;
+    }
+
+    static const int DEFAULT_MAX_SILENT_INTERVALS;
+
     inline bool isPreparedForTransmit() const
     {
         return preparedForTransmit;
@@ -128,6 +148,7 @@ protected:
 
 private slots:
     void handleReceivedChatMessage(const Ninjam::User &user, const QString &message);
+    void releaseSilentTracksBuffers();
 
 private:
     static QString getUniqueKeyForChannel(const Ninjam::UserChannel &channel);
@@ -166,9 +187,17 @@ private:
     QMap<int, VorbisEncoder *> encoders;
     VorbisEncoder *getEncoder(quint8 channelIndex);
 
+    // replaced encoders are reused when a channel needs an encoder with the same format again (mono/stereo switching, reconnecting)
+    QList<VorbisEncoder *> recycledEncoders;
+    void recycleEncoder(VorbisEncoder *encoder); // called with encodersMutex locked
+    VorbisEncoder *createEncoder(int channels, int sampleRate, float quality); // called with encodersMutex locked
+    static const int MAX_RECYCLED_ENCODERS = 4;
+
     void handleNewInterval();
     void recreateEncoderForChannel(int channelIndex);
 
+    void enforceIntervalsMemoryBudget(); // called with mutex locked
+
     void setXmitStatus(int channelID, bool transmiting);
 
     // ++++++++++++++++++++ nested classes to handle scheduled events +++++++++++++++++
@@ -184,6 +213,9 @@ private:
 
     bool preparedForTransmit;
     int waitingIntervals;
+
+    qint64 intervalsMemoryBudget;
+    int maxSilentIntervals;
     static const int TOTAL_PREPARED_INTERVALS = 2;// how many intervals Jamtaba will wait to start trasmiting?
 
 private slots:
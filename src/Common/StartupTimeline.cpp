@@ -0,0 +1,100 @@
+#include "StartupTimeline.h"
+
+#include <QThread>
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <algorithm>
+#include "log/Logging.h"
+
+QList<StartupTimeline::Phase> StartupTimeline::phases;
+QElapsedTimer StartupTimeline::timer;
+QMutex StartupTimeline::mutex;
+bool StartupTimeline::parallelStartup = true;
+bool StartupTimeline::finished = false;
+
+void StartupTimeline::start()
+{
+    QMutexLocker locker(&mutex);
+    phases.clear();
+    finished = false;
+    timer.start();
+}
+
+qint64 StartupTimeline::elapsed()
+{
+    return timer.isValid() ? timer.elapsed() : 0;
+}
+
+void StartupTimeline::setParallelStartup(bool parallelStartup)
+{
+    StartupTimeline::parallelStartup = parallelStartup;
+}
+
+bool StartupTimeline::isParallelStartup()
+{
+    return parallelStartup;
+}
+
+bool StartupTimeline::isFinished()
+{
+    QMutexLocker locker(&mutex);
+    return finished;
+}
+
+void StartupTimeline::addPhase(const QString &name, qint64 startTime, qint64 endTime)
+{
+    QMutexLocker locker(&mutex);
+    if (finished)
+        return; // the phases finished after the main window is interactive are logged individually
+
+    Phase phase;
+    phase.name = name;
+    phase.startTime = startTime;
+    phase.endTime = endTime;
+    phase.runningInMainThread = !QCoreApplication::instance() || QThread::currentThread() == QCoreApplication::instance()->thread();
+    phases.append(phase);
+}
+
+void StartupTimeline::finish(const QString &milestone)
+{
+    QMutexLocker locker(&mutex);
+    if (finished)
+        return;
+
+    finished = true;
+    qint64 totalTime = elapsed();
+
+    std::sort(phases.begin(), phases.end(), [](const Phase &p1, const Phase &p2) {
+        return p1.startTime < p2.startTime;
+    });
+
+    QString mode = parallelStartup ? "parallel" : "serial";
+    qCInfo(jtCore) << "Startup timeline (" << mode << "mode):";
+    for (const Phase &phase : phases) {
+        QString thread = phase.runningInMainThread ? "main" : "worker";
+        qCInfo(jtCore).noquote() << QString("    %1 ms -> %2 ms (%3 ms, %4 thread) %5")
+                                    .arg(phase.startTime, 5)
+                                    .arg(phase.endTime, 5)
+                                    .arg(phase.endTime - phase.startTime, 4)
+                                    .arg(thread, -6)
+                                    .arg(phase.name);
+    }
+    qCInfo(jtCore) << milestone << "in" << totalTime << "ms";
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++
+
+StartupPhase::StartupPhase(const QString &name) :
+    name(name),
+    startTime(StartupTimeline::elapsed())
+{
+}
+
+StartupPhase::~StartupPhase()
+{
+    qint64 endTime = StartupTimeline::elapsed();
+    if (StartupTimeline::isFinished())
+        qCDebug(jtCore) << name << "finished in" << (endTime - startTime) << "ms (after startup)";
+    else
+        StartupTimeline::addPhase(name, startTime, endTime);
+}
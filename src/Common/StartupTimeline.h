@@ -0,0 +1,61 @@
+#ifndef STARTUPTIMELINE_H
+#define STARTUPTIMELINE_H
+
+#include <QString>
+#include <QList>
+#include <QMutex>
+#include <QElapsedTimer>
+
+/***
+  Measure the wall time of each startup phase. The phases can run in different threads (when the
+  parallel startup is enabled) and the whole timeline is written in the log when the main window
+  is interactive.
+
+  Usage:
+      {
+          StartupPhase phase("Loading settings");
+          settings.load();
+      } // the phase is finished when the StartupPhase instance is destroyed
+ */
+class StartupTimeline
+{
+public:
+    static void start();
+    static void finish(const QString &milestone); // write the timeline in the log
+
+    static void setParallelStartup(bool parallelStartup);
+    static bool isParallelStartup();
+
+    static bool isFinished();
+
+    static void addPhase(const QString &name, qint64 startTime, qint64 endTime);
+    static qint64 elapsed(); // milliseconds since start()
+
+private:
+    struct Phase
+    {
+        QString name;
+        qint64 startTime;
+        qint64 endTime;
+        bool runningInMainThread;
+    };
+
+    static QList<Phase> phases;
+    static QElapsedTimer timer;
+    static QMutex mutex;
+    static bool parallelStartup;
+    static bool finished;
+};
+
+class StartupPhase
+{
+public:
+    explicit StartupPhase(const QString &name);
+    ~StartupPhase();
+
+private:
+    QString name;
+    qint64 startTime;
+};
+
+#endif // STARTUPTIMELINE_H
@@ -4,16 +4,21 @@
 
 using namespace Audio;
 
+const int MetronomeTrackNode::MAX_BEATS_PER_INTERVAL = 1024; // the max BPI in ninjam servers
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 MetronomeTrackNode::MetronomeTrackNode(const SamplesBuffer &firstBeatSamples, const SamplesBuffer &secondaryBeatSamples) :
-    firstBeatBuffer(firstBeatSamples),
     secondaryBeatBuffer(secondaryBeatSamples),
+    firstBeatBuffer(firstBeatSamples),
     samplesPerBeat(0),
     intervalPosition(0),
     beatPosition(0),
     currentBeat(0),
-    beatsPerAccent(0)
+    beatsPerAccent(0),
+    beatsPerInterval(0),
+    beatsSchedule(MAX_BEATS_PER_INTERVAL, nullptr)
 {
+    updateBeatsSchedule();
     resetInterval();
 }
 
@@ -37,6 +42,30 @@ void MetronomeTrackNode::setSecondaryBeatSamples(const SamplesBuffer &secondaryB
 void MetronomeTrackNode::setBeatsPerAccent(int beatsPerAccent)
 {
     this->beatsPerAccent = beatsPerAccent;
+    updateBeatsSchedule();
+}
+
+void MetronomeTrackNode::setBeatsPerInterval(int beatsPerInterval)
+{
+    this->beatsPerInterval = qBound(0, beatsPerInterval, MAX_BEATS_PER_INTERVAL);
+    updateBeatsSchedule();
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+void MetronomeTrackNode::updateBeatsSchedule()
+{
+    // the schedule is never reallocated, so the audio thread can read the schedule while the accents are changing
+    for (int beat = 0; beat < MAX_BEATS_PER_INTERVAL; ++beat) {
+        bool accentBeat = beat == 0 || (isPlayingAccents() && beat % beatsPerAccent == 0);
+        beatsSchedule[beat] = accentBeat ? &firstBeatBuffer : &secondaryBeatBuffer;
+    }
+}
+
+const SamplesBuffer *MetronomeTrackNode::getScheduledSamples(int beat) const
+{
+    if (beatsPerInterval > 0)
+        beat %= beatsPerInterval; // the next interval first beat
+    return beatsSchedule[qBound(0, beat, MAX_BEATS_PER_INTERVAL - 1)];
 }
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -52,6 +81,7 @@ void MetronomeTrackNode::setSamplesPerBeat(long samplesPerBeat)
 void MetronomeTrackNode::resetInterval()
 {
     beatPosition = intervalPosition = 0;
+    currentBeat = 0;
 }
 
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -64,39 +94,32 @@ void MetronomeTrackNode::setIntervalPosition(long intervalPosition)
     this->currentBeat = (intervalPosition / samplesPerBeat);
 }
 
-// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-SamplesBuffer *MetronomeTrackNode::getSamplesBuffer(int beat)
-{
-    if (beat == 0 || (isPlayingAccents() && beat % beatsPerAccent == 0)){
-        return &firstBeatBuffer;
-    }
-    return &secondaryBeatBuffer;
-}
-
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 void MetronomeTrackNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out,
                                           int SampleRate, const Midi::MidiMessageBuffer &midiBuffer)
 {
     if (samplesPerBeat <= 0)
         return;
-    internalInputBuffer.setFrameLenght(out.getFrameLenght());
+
+    const int frames = out.getFrameLenght();
+    internalInputBuffer.setFrameLenght(frames);
     internalInputBuffer.zero();
 
-    SamplesBuffer *samplesBuffer = getSamplesBuffer(currentBeat);
-    int samplesToCopy = std::min(
-        (int)(samplesBuffer->getFrameLenght() - beatPosition), out.getFrameLenght());
-    int nextBeatSample = beatPosition + out.getFrameLenght();
+    // copy the scheduled click samples, the audio block can contain more than one beat
+    int beat = currentBeat;
+    long position = beatPosition;
     int internalOffset = 0;
-    int clickSoundBufferOffset = beatPosition;
-    if (nextBeatSample > samplesPerBeat) {// next beat starting in this audio buffer?
-        samplesBuffer = getSamplesBuffer(currentBeat + 1);
-        internalOffset = samplesPerBeat - beatPosition;
-        samplesToCopy = std::min(nextBeatSample - samplesPerBeat,
-                                 (long)samplesBuffer->getFrameLenght());
-        clickSoundBufferOffset = 0;
+    while (internalOffset < frames) {
+        long framesInBeat = std::min(samplesPerBeat - position, (long)(frames - internalOffset));
+        const SamplesBuffer *clickSamples = getScheduledSamples(beat);
+        long clickFrames = std::min((long)clickSamples->getFrameLenght() - position, framesInBeat);
+        if (clickFrames > 0)
+            internalInputBuffer.set(*clickSamples, position, clickFrames, internalOffset);
+
+        internalOffset += framesInBeat;
+        position = 0; // next beat starting
+        beat++;
     }
-    if (samplesToCopy > 0)
-        internalInputBuffer.set(*samplesBuffer, clickSoundBufferOffset, samplesToCopy,
-                                internalOffset);
+
     AudioNode::processReplacing(in, out, SampleRate, midiBuffer);
 }
@@ -2,10 +2,16 @@
 #define METRONOMETRACKNODE_H
 
 #include "core/AudioNode.h"
+#include <vector>
 
 namespace Audio {
 class SamplesBuffer;
 
+/***
+  The click sounds (already decoded and resampled) are played using a per-beat schedule. The schedule
+  is computed when the BPI or the accents are changed, so the audio thread is just copying the click
+  samples scheduled for the current beat.
+ */
 class MetronomeTrackNode : public Audio::AudioNode
 {
 public:
@@ -15,6 +21,7 @@ public:
     virtual void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int SampleRate,
                                   const Midi::MidiMessageBuffer &midiBuffer);
     void setSamplesPerBeat(long samplesPerBeat);
+    void setBeatsPerInterval(int beatsPerInterval);
     void setIntervalPosition(long intervalPosition);
     void resetInterval();
 
@@ -36,8 +43,15 @@ private:
     long beatPosition;
     int currentBeat;
     int beatsPerAccent;
+    int beatsPerInterval;
 
-    SamplesBuffer *getSamplesBuffer(int beat);// return the correct buffer to play in each beat
+    // click sound played in each interval beat, preallocated with MAX_BEATS_PER_INTERVAL entries
+    std::vector<const SamplesBuffer *> beatsSchedule;
+
+    void updateBeatsSchedule();
+    const SamplesBuffer *getScheduledSamples(int beat) const;
+
+    static const int MAX_BEATS_PER_INTERVAL;
 };
 
 inline bool MetronomeTrackNode::isPlayingAccents() const
@@ -5,12 +5,17 @@
 #include <QList>
 #include <QByteArray>
 #include <QMutexLocker>
+#include <QAtomicInt>
 #include <QDateTime>
 #include <QtConcurrent/QtConcurrent>
 #include "audio/core/Filters.h"
+#include "audio/core/SamplesRingBuffer.h"
+#include "performance/ThreadRoles.h"
 
 const double NinjamTrackNode::LOW_CUT_DRASTIC_FREQUENCY = 220.0; // in Hertz
 const double NinjamTrackNode::LOW_CUT_NORMAL_FREQUENCY = 120.0; // in Hertz
+const int NinjamTrackNode::MAX_RECYCLED_DECODERS = 3; // current interval + next interval + one discarded interval
+quint64 NinjamTrackNode::lastIntervalSequence = 0;
 
 class NinjamTrackNode::LowCutFilter
 {
@@ -64,31 +69,82 @@ class NinjamTrackNode::IntervalDecoder
 {
 public:
     IntervalDecoder(const QByteArray &vorbisData);
-    void decode(quint32 maxSamplesToDecode);
+    void reset(const QByteArray &vorbisData); // reuse this decoder to decode another interval
+    void decode(quint32 maxSamplesToDecode); // called in the workers pool
+    void decodeSamples(quint32 maxSamplesToDecode); // decode in the calling thread
     quint32 getDecodedSamples(Audio::SamplesBuffer &outBuffer, int samplesToDecode);
-    inline int getSampleRate() { return vorbisDecoder.getSampleRate(); }
+    inline int getSampleRate() const { return sampleRate.loadAcquire(); } // zero until the decoder is initialized
     void stopDecoding();
+
+    inline qint64 getBufferedBytes() const { return bufferedBytes; }
+    inline quint64 getSequence() const { return sequence; } // download order, used to find the oldest intervals
+    inline void setSequence(quint64 sequence) { this->sequence = sequence; }
+
 private:
     VorbisDecoder vorbisDecoder;
-    Audio::SamplesBuffer decodedBuffer;
+    qint64 bufferedBytes; // encoded interval + decoded samples buffer
+    quint64 sequence;
+
+    void updateBufferedBytes(const QByteArray &vorbisData);
+
+    QAtomicInt sampleRate; // the vorbis header is read in the first decode, the sample rate is unknown before
+    void updateSampleRate();
+
+    Audio::SamplesRingBuffer decodedSamples; // decoded but not played yet, the samples are not moved when the audio thread is reading
     QMutex mutex;
+
+    static const int DECODED_SAMPLES_CAPACITY;
 };
 
+const int NinjamTrackNode::IntervalDecoder::DECODED_SAMPLES_CAPACITY = 16384; // frames, enough to the biggest audio blocks after resampling
+
 NinjamTrackNode::IntervalDecoder::IntervalDecoder(const QByteArray &vorbisData)
-    :decodedBuffer(2)
+    :sequence(0),
+    sampleRate(0),
+    decodedSamples(2, DECODED_SAMPLES_CAPACITY)
 {
     vorbisDecoder.setInputData(vorbisData);
+    updateBufferedBytes(vorbisData);
+}
+
+void NinjamTrackNode::IntervalDecoder::updateBufferedBytes(const QByteArray &vorbisData)
+{
+    qint64 decodedSamplesBytes = decodedSamples.getChannels() * decodedSamples.getCapacity() * sizeof(float);
+    bufferedBytes = vorbisData.size() + decodedSamplesBytes;
+}
+
+void NinjamTrackNode::IntervalDecoder::reset(const QByteArray &vorbisData)
+{
+    QMutexLocker locker(&mutex);
+
+    vorbisDecoder.reset(vorbisData);
+    sampleRate.storeRelease(0);
+    decodedSamples.clear();
+    updateBufferedBytes(vorbisData);
 }
 
 void NinjamTrackNode::IntervalDecoder::decode(quint32 maxSamplesToDecode)
+{
+    ThreadRoles::applyToCurrentThread(ThreadRoles::Workers); // decoding in QtConcurrent pool
+    decodeSamples(maxSamplesToDecode);
+}
+
+void NinjamTrackNode::IntervalDecoder::decodeSamples(quint32 maxSamplesToDecode)
 {
     mutex.lock();
 
-    decodedBuffer.append(vorbisDecoder.decode(maxSamplesToDecode));
+    vorbisDecoder.decode(decodedSamples, maxSamplesToDecode);
+    updateSampleRate();
 
     mutex.unlock();
 }
 
+void NinjamTrackNode::IntervalDecoder::updateSampleRate()
+{
+    if (vorbisDecoder.isInitialized() && sampleRate.loadAcquire() == 0)
+        sampleRate.storeRelease(vorbisDecoder.getSampleRate());
+}
+
 void NinjamTrackNode::IntervalDecoder::stopDecoding()
 {
     mutex.lock(); // this funcion is called from GUI thread
@@ -101,18 +157,17 @@ void NinjamTrackNode::IntervalDecoder::stopDecoding()
 quint32 NinjamTrackNode::IntervalDecoder::getDecodedSamples(Audio::SamplesBuffer &outBuffer, int samplesToDecode)
 {
     mutex.lock();
-    while (decodedBuffer.getFrameLenght() < samplesToDecode) { //need decode more samples to fill outBuffer?
-        quint32 toDecode = samplesToDecode - decodedBuffer.getFrameLenght();
-        const Audio::SamplesBuffer &decodedSamples = vorbisDecoder.decode(toDecode);
-        decodedBuffer.append(decodedSamples);
-        if (decodedSamples.isEmpty())
-            break; //no more samples to decode
+    quint32 samplesNeeded = qMin(static_cast<quint32>(qMax(samplesToDecode, 0)), decodedSamples.getCapacity());
+    quint32 availableSamples = decodedSamples.getAvailableFrames();
+    if (availableSamples < samplesNeeded) //need decode more samples to fill outBuffer?
+    {
+        vorbisDecoder.decode(decodedSamples, samplesNeeded - availableSamples);
+        updateSampleRate();
     }
 
-    quint32 totalSamples = qMin(samplesToDecode, decodedBuffer.getFrameLenght());
+    quint32 totalSamples = qMin(samplesNeeded, decodedSamples.getAvailableFrames());
     outBuffer.setFrameLenght(totalSamples);
-    outBuffer.set(decodedBuffer);
-    decodedBuffer.discardFirstSamples(totalSamples);
+    decodedSamples.read(outBuffer, totalSamples);
     mutex.unlock();
     return totalSamples;
 }
@@ -121,12 +176,13 @@ quint32 NinjamTrackNode::IntervalDecoder::getDecodedSamples(Audio::SamplesBuffer
 
 NinjamTrackNode::NinjamTrackNode(int ID) :
     ID(ID),
+    silentIntervals(0),
     processingLastPartOfInterval(false),
     currentDecoder(nullptr),
     decodersMutex(QMutex::NonRecursive),
     lowCut(new NinjamTrackNode::LowCutFilter(44100))
 {
-
+    recycledDecoders.reserve(MAX_RECYCLED_DECODERS); // no allocations when the audio thread is recycling decoders
 }
 
 void NinjamTrackNode::stopDecoding()
@@ -176,6 +232,13 @@ int NinjamTrackNode::getSampleRate() const
     return 44100;
 }
 
+int NinjamTrackNode::getSourceSampleRate() const
+{
+    if (currentDecoder)
+        return currentDecoder->getSampleRate(); // zero until the first samples are decoded
+    return 0; // not playing, nothing to resample
+}
+
 NinjamTrackNode::~NinjamTrackNode()
 {
     decodersMutex.lock();
@@ -187,23 +250,83 @@ NinjamTrackNode::~NinjamTrackNode()
         delete currentDecoder;
         currentDecoder = nullptr;
     }
+
+    qDeleteAll(recycledDecoders);
+    recycledDecoders.clear();
     decodersMutex.unlock();
 }
 
+void NinjamTrackNode::recycleDecoder(IntervalDecoder *decoder)
+{
+    if (recycledDecoders.size() >= MAX_RECYCLED_DECODERS) {
+        delete decoder;
+        return;
+    }
+
+    decoder->reset(QByteArray()); // release the interval data and the vorbis stream state
+    recycledDecoders.append(decoder);
+}
+
+NinjamTrackNode::IntervalDecoder *NinjamTrackNode::createDecoder(const QByteArray &vorbisData)
+{
+    IntervalDecoder *decoder = nullptr;
+    if (recycledDecoders.isEmpty()) {
+        decoder = new IntervalDecoder(vorbisData);
+    }
+    else {
+        decoder = recycledDecoders.takeLast();
+        decoder->reset(vorbisData);
+    }
+
+    decoder->setSequence(++lastIntervalSequence);
+    return decoder;
+}
+
 void NinjamTrackNode::discardDownloadedIntervals(bool keepMostRecentInterval)
 {
     decodersMutex.lock();
     if (!keepMostRecentInterval) {
         while (!decoders.isEmpty())
-            delete decoders.takeFirst();
+            recycleDecoder(decoders.takeFirst());
     } else {
         while(decoders.size() > 1)//keep the last downloaded interval
-            delete decoders.takeFirst();
+            recycleDecoder(decoders.takeFirst());
     }
     qDebug() << "intervals discarded";
     decodersMutex.unlock();
 }
 
+qint64 NinjamTrackNode::getBufferedBytes()
+{
+    QMutexLocker locker(&decodersMutex);
+    qint64 bytes = currentDecoder ? currentDecoder->getBufferedBytes() : 0;
+    foreach (IntervalDecoder *decoder, decoders)
+        bytes += decoder->getBufferedBytes();
+
+    return bytes;
+}
+
+qint64 NinjamTrackNode::getOldestPendingIntervalSequence()
+{
+    QMutexLocker locker(&decodersMutex);
+    if (decoders.isEmpty())
+        return -1;
+
+    return decoders.first()->getSequence(); // the intervals are queued in download order
+}
+
+qint64 NinjamTrackNode::discardOldestPendingInterval()
+{
+    QMutexLocker locker(&decodersMutex);
+    if (decoders.isEmpty())
+        return 0; // the playing interval is never discarded
+
+    IntervalDecoder *decoder = decoders.takeFirst();
+    qint64 releasedBytes = decoder->getBufferedBytes();
+    recycleDecoder(decoder);
+    return releasedBytes;
+}
+
 bool NinjamTrackNode::isPlaying()
 {
     QMutexLocker locker(&decodersMutex);
@@ -214,20 +337,47 @@ bool NinjamTrackNode::startNewInterval()
 {
     decodersMutex.lock();
     if (currentDecoder) {
-        delete currentDecoder; //discard the previous interval decoder
+        recycleDecoder(currentDecoder); //discard the previous interval decoder
         currentDecoder = nullptr;
     }
     if (!decoders.isEmpty())
         currentDecoder = decoders.takeFirst(); //using the next buffered decoder (next interval)
 
+    if (currentDecoder)
+        silentIntervals.store(0);
+    else
+        silentIntervals.ref();
+
     decodersMutex.unlock();
     return isPlaying();
 }
 
+bool NinjamTrackNode::releaseBuffersIfSilent(int minSilentIntervals)
+{
+    if (minSilentIntervals <= 0 || getSilentIntervals() < minSilentIntervals)
+        return false;
+
+    QMutexLocker locker(&decodersMutex);
+    if (currentDecoder || !decoders.isEmpty())
+        return false; // an interval was received, the buffers will be used in the next interval
+
+    if (recycledDecoders.isEmpty() && resampler.isNull())
+        return false; // already released
+
+    // the audio thread is not using the resampler, there is no decoder to play
+    qDeleteAll(recycledDecoders);
+    recycledDecoders.clear();
+    resampler.reset();
+    return true;
+}
+
 void NinjamTrackNode::addVorbisEncodedInterval(const QByteArray &vorbisData)
 {
     decodersMutex.lock();
-    IntervalDecoder *newIntervalDecoder = new IntervalDecoder(vorbisData);
+    if (resampler.isNull())
+        resampler.reset(new SamplesBufferResampler()); // allocated here to avoid allocations in audio thread
+
+    IntervalDecoder *newIntervalDecoder = createDecoder(vorbisData);
     decoders.append(newIntervalDecoder);
     decodersMutex.unlock();
 
@@ -250,13 +400,19 @@ void NinjamTrackNode::processReplacing(const Audio::SamplesBuffer &in, Audio::Sa
         return;
 
     Q_ASSERT(currentDecoder);
+    if (currentDecoder->getSampleRate() <= 0) {
+        currentDecoder->decodeSamples(out.getFrameLenght()); // the workers pool is late, read the vorbis header here
+        if (currentDecoder->getSampleRate() <= 0)
+            return; // not enough data to know the sample rate, trying again in the next audio block
+    }
+
     int framesToProcess = getFramesToProcess(sampleRate, out.getFrameLenght());
     internalInputBuffer.setFrameLenght(framesToProcess);
     currentDecoder->getDecodedSamples(internalInputBuffer, framesToProcess);
 
     if (!internalInputBuffer.isEmpty()) {
-        if (needResamplingFor(sampleRate)) {
-            const Audio::SamplesBuffer &resampledBuffer = resampler.resample(internalInputBuffer,
+        if (needResamplingFor(sampleRate) && resampler) {
+            const Audio::SamplesBuffer &resampledBuffer = resampler->resample(internalInputBuffer,
                                                                              out.getFrameLenght());
             internalInputBuffer.setFrameLenght(resampledBuffer.getFrameLenght());
             internalInputBuffer.set(resampledBuffer);
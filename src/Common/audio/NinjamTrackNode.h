@@ -38,11 +38,22 @@ public:
 
     int getSampleRate() const;
 
+    int getSourceSampleRate() const override;
+
     bool isPlaying();
 
     /** Discard all downloaded (but not played yet) intervals */
     void discardDownloadedIntervals(bool keepMostRecentInterval);
 
+    /** Memory used by the playing and the downloaded intervals (encoded data and decoded samples) */
+    qint64 getBufferedBytes();
+
+    /** Download sequence of the oldest not started interval, or -1 when no interval is waiting */
+    qint64 getOldestPendingIntervalSequence();
+
+    /** Discard the oldest not started interval, return the released bytes */
+    qint64 discardOldestPendingInterval();
+
     void stopDecoding();
 
     inline void setProcessingLastPartOfInterval(bool status)
@@ -50,9 +61,19 @@ public:
         this->processingLastPartOfInterval = status;
     }
 
+    /** Consecutive intervals started without audio to play */
+    inline int getSilentIntervals() const
+    {
+        return silentIntervals.load();
+    }
+
+    /** Release the decoders and resampler memory if the track is silent, they are recreated when the next interval is received */
+    bool releaseBuffersIfSilent(int minSilentIntervals);
+
 private:
     int ID;
-    SamplesBufferResampler resampler;
+    QScopedPointer<SamplesBufferResampler> resampler; // created when the first interval is received
+    QAtomicInt silentIntervals; // changed in audio thread, read in main thread
 
     class LowCutFilter;
     QScopedPointer<LowCutFilter> lowCut;
@@ -71,6 +92,15 @@ private:
     IntervalDecoder* currentDecoder;
     QMutex decodersMutex;
 
+    // played and discarded decoders are reused in next intervals, avoiding one decoder allocation per interval
+    QList<IntervalDecoder*> recycledDecoders;
+    void recycleDecoder(IntervalDecoder *decoder); // called with decodersMutex locked
+    IntervalDecoder *createDecoder(const QByteArray &vorbisData); // called with decodersMutex locked
+
+    static const int MAX_RECYCLED_DECODERS;
+
+    static quint64 lastIntervalSequence; // intervals are added in main thread only
+
 };
 
 #endif // NINJAMTRACKNODE_H
@@ -16,38 +16,137 @@
 #include <cmath>
 #include <QMutexLocker>
 #include <QFile>
+#include <QThread>
+#include <algorithm>
 
 using namespace Audio;
 
 const int AbstractMp3Streamer::MAX_BYTES_PER_DECODING = 2048;
+const int AbstractMp3Streamer::MAX_DECODED_FRAMES = 4096 * 2; // Mp3DecoderMiniMp3::AUDIO_SAMPLES_BUFFER_MAX_SIZE
+const int AbstractMp3Streamer::DEFAULT_BUFFER_SIZE = 4096 * 8;
 
 // +++++++++++++
-AbstractMp3Streamer::AbstractMp3Streamer(Audio::Mp3Decoder *decoder) :
+
+class AbstractMp3Streamer::DecodingThread : public QThread
+{
+public:
+    explicit DecodingThread(AbstractMp3Streamer *streamer) :
+        streamer(streamer),
+        stopRequested(false)
+    {
+    }
+
+    void stop()
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        wakeUpCondition.wakeAll();
+    }
+
+    void wakeUp()
+    {
+        QMutexLocker locker(&mutex);
+        wakeUpCondition.wakeAll();
+    }
+
+protected:
+    void run() override
+    {
+        char chunk[MAX_BYTES_PER_DECODING];
+        forever {
+            {
+                QMutexLocker locker(&mutex);
+                if (stopRequested)
+                    break;
+            }
+
+            if (!streamer->decodeNextChunk(chunk)) {
+                // nothing to decode or the PCM ring is full. The audio thread is not waking up this thread,
+                // so the waiting time is limited.
+                QMutexLocker locker(&mutex);
+                if (!stopRequested)
+                    wakeUpCondition.wait(&mutex, IDLE_TIME);
+            }
+        }
+    }
+
+private:
+    AbstractMp3Streamer *streamer;
+    bool stopRequested;
+    QMutex mutex;
+    QWaitCondition wakeUpCondition;
+
+    static const unsigned long IDLE_TIME = 10; // milliseconds
+};
+
+// +++++++++++++
+AbstractMp3Streamer::AbstractMp3Streamer(Audio::Mp3Decoder *decoder, int bufferSize) :
     decoder(decoder),
     device(nullptr),
     streaming(false),
-    bufferedSamples(2, 4096)
+    decodedSamples(2, std::max(bufferSize, MAX_DECODED_FRAMES * 2))
 {
-    bufferedSamples.setFrameLenght(0);// reset internal offset
 }
 
 AbstractMp3Streamer::~AbstractMp3Streamer()
 {
+    stopDecoding();
     delete decoder;
 }
 
+void AbstractMp3Streamer::startDecoding()
+{
+    if (decodingThread)
+        return;
+
+    decodingThread.reset(new DecodingThread(this));
+    decodingThread->start();
+}
+
+void AbstractMp3Streamer::stopDecoding()
+{
+    if (!decodingThread)
+        return;
+
+    decodingThread->stop();
+    decodingThread->wait();
+    decodingThread.reset();
+}
+
+void AbstractMp3Streamer::wakeUpDecodingThread()
+{
+    if (decodingThread)
+        decodingThread->wakeUp();
+}
+
+bool AbstractMp3Streamer::decodeNextChunk(char *chunk)
+{
+    if (decodedSamples.getFreeFrames() < (unsigned int)MAX_DECODED_FRAMES)
+        return false; // no space to store the decoded samples, the audio thread need consume some samples
+
+    int bytesToProcess = pullBytesToDecode(chunk, MAX_BYTES_PER_DECODING);
+    if (bytesToProcess <= 0)
+        return false;
+
+    const Audio::SamplesBuffer *decodedBuffer = decoder->decode(chunk, bytesToProcess);
+    decodedSamples.write(*decodedBuffer);
+    return true;
+}
+
 void AbstractMp3Streamer::stopCurrentStream()
 {
     qCDebug(jtNinjamRoomStreamer) << "stopping room stream";
 
+    stopDecoding(); // the decoder is not used by other thread after this point
+
+    QMutexLocker locker(&mutex); // the audio thread is not reading the decoded samples while they are discarded
     if (device) {
-        decoder->reset();// discard unprocessed bytes
         device->deleteLater();
         device = nullptr;
-        bufferedSamples.zero();// discard samples
-        streaming = false;
     }
-    bytesToDecode.clear();
+    decoder->reset();// discard unprocessed bytes
+    decodedSamples.clear();// discard samples
+    streaming = false;
     lastPeak.zero();
 }
 
@@ -65,15 +164,26 @@ void AbstractMp3Streamer::processReplacing(const Audio::SamplesBuffer &in,
 {
     Q_UNUSED(in);
 
-    if (bufferedSamples.isEmpty() || !streaming)
+    if (!streaming)
         return;
 
+    if (!mutex.tryLock())
+        return; // the stream is changing in the main thread, the audio thread is never waiting
+
     int samplesToRender = getSamplesToRender(targetSampleRate, out.getFrameLenght());
-    if (samplesToRender <= 0)
+    unsigned int availableSamples = decodedSamples.getAvailableFrames();
+    if (samplesToRender <= 0 || availableSamples == 0) {
+        mutex.unlock();
         return;
+    }
 
     internalInputBuffer.setFrameLenght(samplesToRender);
-    internalInputBuffer.set(bufferedSamples);
+    if (availableSamples < (unsigned int)samplesToRender) {
+        internalInputBuffer.zero();
+        qCDebug(jtNinjamRoomStreamer) << samplesToRender - availableSamples << " samples missing";
+    }
+    decodedSamples.read(internalInputBuffer, samplesToRender);
+    mutex.unlock();
 
     if (needResamplingFor(targetSampleRate)) {
         const Audio::SamplesBuffer &resampledBuffer = resampler.resample(internalInputBuffer,
@@ -85,12 +195,6 @@ void AbstractMp3Streamer::processReplacing(const Audio::SamplesBuffer &in,
         internalOutputBuffer.set(internalInputBuffer);
     }
 
-    bufferedSamples.discardFirstSamples(samplesToRender);// keep non rendered samples for next audio callback
-
-    if (internalOutputBuffer.getFrameLenght() < out.getFrameLenght())
-        qCDebug(jtNinjamRoomStreamer) << out.getFrameLenght()
-            - internalOutputBuffer.getFrameLenght() << " samples missing";
-
     this->lastPeak.update(internalOutputBuffer.computePeak());
 
     out.add(internalOutputBuffer);
@@ -113,32 +217,6 @@ bool AbstractMp3Streamer::needResamplingFor(int targetSampleRate) const
     return targetSampleRate != getSampleRate();
 }
 
-void AbstractMp3Streamer::decode(const unsigned int maxBytesToDecode)
-{
-    if (!device)
-        return;
-    qint64 totalBytesToProcess = std::min((int)maxBytesToDecode, bytesToDecode.size());
-    char *in = bytesToDecode.data();
-
-    if (totalBytesToProcess > 0) {
-        int bytesProcessed = 0;
-        while (bytesProcessed < totalBytesToProcess) {// split bytesReaded in chunks to avoid a very large decoded buffer
-            // chunks maxsize is 2048 bytes
-            int bytesToProcess = std::min((int)(totalBytesToProcess - bytesProcessed),
-                                          MAX_BYTES_PER_DECODING);
-            const Audio::SamplesBuffer *decodedBuffer = decoder->decode(in, bytesToProcess);
-
-            // prepare in for the next decoding
-            in += bytesToProcess;
-            bytesProcessed += bytesToProcess;
-            // +++++++++++++++++  PROCESS DECODED SAMPLES ++++++++++++++++
-            bufferedSamples.append(*decodedBuffer);
-        }
-
-        bytesToDecode = bytesToDecode.right(bytesToDecode.size() - bytesProcessed);
-    }
-}
-
 void AbstractMp3Streamer::setStreamPath(const QString &streamPath)
 {
     stopCurrentStream();
@@ -147,12 +225,17 @@ void AbstractMp3Streamer::setStreamPath(const QString &streamPath)
 
 // +++++++++++++++++++++++++++++++++++++++
 
-const int NinjamRoomStreamerNode::BUFFER_SIZE = 128000;
+const int NinjamRoomStreamerNode::BUFFER_SIZE = 44100 * 6; // 6 seconds
+const int NinjamRoomStreamerNode::PREBUFFERING_SIZE = NinjamRoomStreamerNode::BUFFER_SIZE/2; // the other half is used to absorb the network jitter
+const int NinjamRoomStreamerNode::MAX_DOWNLOADED_BYTES = 256 * 1024; // 16 seconds in a 128 kbps stream
 
 NinjamRoomStreamerNode::NinjamRoomStreamerNode(const QUrl &streamPath) :
-    AbstractMp3Streamer(new Mp3DecoderMiniMp3()),
+    AbstractMp3Streamer(new Mp3DecoderMiniMp3(), BUFFER_SIZE),
     httpClient(nullptr),
-    buffering(false)
+    buffering(false),
+    downloadedBytes(MAX_DOWNLOADED_BYTES),
+    downloadedBytesBegin(0),
+    downloadedBytesCount(0)
 {
     setStreamPath(streamPath.toString());
 }
@@ -168,8 +251,10 @@ void NinjamRoomStreamerNode::initialize(const QString &streamPath)
 {
     AbstractMp3Streamer::initialize(streamPath);
     buffering = true;
-    bufferedSamples.zero();
-    bytesToDecode.clear();
+    {
+        QMutexLocker locker(&downloadedBytesMutex);
+        downloadedBytesBegin = downloadedBytesCount = 0;
+    }
     if (!streamPath.isEmpty()) {
         qCDebug(jtNinjamRoomStreamer) << "connecting in " << streamPath;
         if (httpClient)
@@ -180,6 +265,7 @@ void NinjamRoomStreamerNode::initialize(const QString &streamPath)
         QObject::connect(reply, SIGNAL(error(QNetworkReply::NetworkError)), this,
                          SLOT(on_reply_error(QNetworkReply::NetworkError)));
         this->device = reply;
+        startDecoding();
     }
 }
 
@@ -197,49 +283,89 @@ void NinjamRoomStreamerNode::on_reply_read()
         return;
     }
     if (device->isOpen() && device->isReadable()) {
-        QMutexLocker locker(&mutex);
-        bytesToDecode.append(device->readAll());
+        appendDownloadedBytes(device->readAll());
+        wakeUpDecodingThread();
         if (buffering) {
-            qCDebug(jtNinjamRoomStreamer) << "bytes downloaded  bytesToDecode:"<<bytesToDecode.size()
-                                      << " bufferedSamples: " << bufferedSamples.getFrameLenght();
+            qCDebug(jtNinjamRoomStreamer) << "bytes downloaded  downloadedBytes:" << downloadedBytesCount
+                                      << " decodedSamples: " << decodedSamples.getAvailableFrames();
         }
     } else {
         qCritical() << "problem in device!";
     }
 }
 
+void NinjamRoomStreamerNode::appendDownloadedBytes(const QByteArray &bytes)
+{
+    QMutexLocker locker(&downloadedBytesMutex);
+
+    const int capacity = downloadedBytes.size();
+    const char *data = bytes.constData();
+    int size = bytes.size();
+    if (size > capacity) { // keep only the most recent bytes
+        data += size - capacity;
+        size = capacity;
+    }
+
+    int overflow = downloadedBytesCount + size - capacity;
+    if (overflow > 0) {
+        // the network is faster than the playback, the oldest bytes are dropped to keep the latency bounded.
+        // The MP3 decoder will resync in the next frame header.
+        qCDebug(jtNinjamRoomStreamer) << "Dropping" << overflow << "downloaded bytes";
+        downloadedBytesBegin = (downloadedBytesBegin + overflow) % capacity;
+        downloadedBytesCount -= overflow;
+    }
+
+    int writePosition = (downloadedBytesBegin + downloadedBytesCount) % capacity;
+    int firstPart = std::min(size, capacity - writePosition);
+    std::copy(data, data + firstPart, downloadedBytes.begin() + writePosition);
+    std::copy(data + firstPart, data + size, downloadedBytes.begin());
+    downloadedBytesCount += size;
+}
+
+int NinjamRoomStreamerNode::pullBytesToDecode(char *buffer, int maxBytes)
+{
+    QMutexLocker locker(&downloadedBytesMutex);
+
+    const int capacity = downloadedBytes.size();
+    int bytesToPull = std::min(maxBytes, downloadedBytesCount);
+    int firstPart = std::min(bytesToPull, capacity - downloadedBytesBegin);
+    std::copy(downloadedBytes.begin() + downloadedBytesBegin, downloadedBytes.begin() + downloadedBytesBegin + firstPart, buffer);
+    std::copy(downloadedBytes.begin(), downloadedBytes.begin() + (bytesToPull - firstPart), buffer + firstPart);
+
+    downloadedBytesBegin = (downloadedBytesBegin + bytesToPull) % capacity;
+    downloadedBytesCount -= bytesToPull;
+    return bytesToPull;
+}
+
 NinjamRoomStreamerNode::~NinjamRoomStreamerNode()
 {
+    stopDecoding(); // the decoding thread is using the downloaded bytes
 }
 
 void NinjamRoomStreamerNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out,
                                               int sampleRate, const Midi::MidiMessageBuffer &midiBuffer)
 {
     Q_UNUSED(in)
-    QMutexLocker locker(&mutex);
-    if (buffering && bytesToDecode.size() >= BUFFER_SIZE)
+    if (!streaming)
+        return;
+
+    unsigned int availableSamples = decodedSamples.getAvailableFrames();
+    if (buffering && availableSamples >= (unsigned int)PREBUFFERING_SIZE)
         buffering = false;
-    if (!buffering && bytesToDecode.isEmpty())
+    if (!buffering && availableSamples == 0) {
+        qCDebug(jtNinjamRoomStreamer) << "no more decoded samples. Buffering ...";
         buffering = true;
+    }
     if (buffering)
         return;
-    int samplesToRender = getSamplesToRender(sampleRate, out.getFrameLenght());
-    while (bufferedSamples.getFrameLenght() < samplesToRender) {// need decoding?
-        decode(256);
-        if (bytesToDecode.isEmpty()) {// no more bytes to decode
-            qCritical() << "no more bytes to decode and not enough buffered samples. Buffering ...";
-            buffering = true;
-            break;
-        }
-    }
-    if (!bufferedSamples.isEmpty())
-        AbstractMp3Streamer::processReplacing(in, out, sampleRate, midiBuffer);
+
+    AbstractMp3Streamer::processReplacing(in, out, sampleRate, midiBuffer);
 }
 
 int NinjamRoomStreamerNode::getBufferingPercentage() const
 {
     if (buffering)
-        return bytesToDecode.size()/(float)BUFFER_SIZE * 100;
+        return std::min(100.0f, decodedSamples.getAvailableFrames()/(float)PREBUFFERING_SIZE * 100);
 
     if (!streaming)
         return 0;
@@ -248,7 +374,8 @@ int NinjamRoomStreamerNode::getBufferingPercentage() const
 
 // ++++++++++++++++++
 AudioFileStreamerNode::AudioFileStreamerNode(const QString &file) :
-    AbstractMp3Streamer(new Mp3DecoderMiniMp3())
+    AbstractMp3Streamer(new Mp3DecoderMiniMp3()),
+    fileReadPosition(0)
 {
     setStreamPath(file);
 }
@@ -256,23 +383,30 @@ AudioFileStreamerNode::AudioFileStreamerNode(const QString &file) :
 void AudioFileStreamerNode::initialize(const QString &streamPath)
 {
     AbstractMp3Streamer::initialize(streamPath);
-    QFile *f = new QFile(streamPath);
-    if (!f->open(QIODevice::ReadOnly))
+    QFile file(streamPath);
+    if (!file.open(QIODevice::ReadOnly))
         qCritical() << "error opening the file " << streamPath;
-    this->device = f;
-    bytesToDecode.append(f->readAll());
+    fileBytes = file.readAll();
+    fileReadPosition = 0;
+    startDecoding();
+}
+
+int AudioFileStreamerNode::pullBytesToDecode(char *buffer, int maxBytes)
+{
+    int bytesToPull = std::min(maxBytes, fileBytes.size() - fileReadPosition);
+    std::copy(fileBytes.constData() + fileReadPosition, fileBytes.constData() + fileReadPosition + bytesToPull, buffer);
+    fileReadPosition += bytesToPull;
+    return bytesToPull;
 }
 
 AudioFileStreamerNode::~AudioFileStreamerNode()
 {
+    stopDecoding();
 }
 
 void AudioFileStreamerNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out,
                                              int sampleRate, const Midi::MidiMessageBuffer &midiBuffer)
 {
-    while (bufferedSamples.getFrameLenght() < out.getFrameLenght())
-        decode(1024 + 1024);
-
     AbstractMp3Streamer::processReplacing(in, out, sampleRate, midiBuffer);
 }
 
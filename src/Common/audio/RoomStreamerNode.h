@@ -2,9 +2,12 @@
 #define ROOM_STREAMER_NODE_H
 
 #include "core/AudioNode.h"
+#include "core/SamplesRingBuffer.h"
 #include <QNetworkReply>
 #include <QNetworkAccessManager>
-// #include <deque>
+#include <QScopedPointer>
+#include <QMutex>
+#include <vector>
 #include "SamplesBufferResampler.h"
 
 class QIODevice;
@@ -16,7 +19,7 @@ class AbstractMp3Streamer : public AudioNode
 {
     Q_OBJECT
 public:
-    explicit AbstractMp3Streamer(Audio::Mp3Decoder *decoder);
+    AbstractMp3Streamer(Audio::Mp3Decoder *decoder, int bufferSize = DEFAULT_BUFFER_SIZE); // buffer size in decoded frames
     ~AbstractMp3Streamer();
     virtual void processReplacing(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
                                   int sampleRate, const Midi::MidiMessageBuffer &midiBuffer);
@@ -33,22 +36,35 @@ public:
     virtual bool isBuffering() const  = 0;
     virtual int getBufferingPercentage() const = 0;
 
+    static const int DEFAULT_BUFFER_SIZE;
+
 signals:
     void error(const QString &errorMsg);
 private:
     static const int MAX_BYTES_PER_DECODING;
+    static const int MAX_DECODED_FRAMES; // max frames returned by the decoder in each decoding
+
+    class DecodingThread;
+    QScopedPointer<DecodingThread> decodingThread;
+
+    bool decodeNextChunk(char *chunk); // called in the decoding thread
 
 protected:
-    Audio::Mp3Decoder *decoder;
+    Audio::Mp3Decoder *decoder; // used only by the decoding thread while streaming
 
     QIODevice *device;
-    void decode(const unsigned int maxBytesToDecode);
-    QByteArray bytesToDecode;
     virtual void initialize(const QString &streamPath);
     bool streaming;
-    SamplesBuffer bufferedSamples;
+    SamplesRingBuffer decodedSamples; // written by the decoding thread, read by the audio thread
     SamplesBufferResampler resampler;
 
+    void startDecoding();
+    void stopDecoding();
+    void wakeUpDecodingThread(); // called when new bytes are available to decode
+
+    // return the number of bytes copied to 'buffer'. Called in the decoding thread.
+    virtual int pullBytesToDecode(char *buffer, int maxBytes) = 0;
+
     int getSamplesToRender(int targetSampleRate, int outLenght);
 };
 
@@ -71,11 +87,22 @@ public:
 
 protected:
     void initialize(const QString &streamPath);
+    int pullBytesToDecode(char *buffer, int maxBytes) override;
 private:
     QNetworkAccessManager *httpClient;
     bool buffering;
 
-    static const int BUFFER_SIZE;
+    // downloaded bytes ring, shared by the main thread (network) and the decoding thread
+    std::vector<char> downloadedBytes;
+    int downloadedBytesBegin;
+    int downloadedBytesCount;
+    QMutex downloadedBytesMutex;
+
+    void appendDownloadedBytes(const QByteArray &bytes);
+
+    static const int BUFFER_SIZE; // decoded frames (PCM ring capacity)
+    static const int PREBUFFERING_SIZE; // decoded frames buffered before start the playback
+    static const int MAX_DOWNLOADED_BYTES;
 
 private slots:
     void on_reply_error(QNetworkReply::NetworkError);
@@ -86,12 +113,16 @@ class AudioFileStreamerNode : public AbstractMp3Streamer
 {
 protected:
     void initialize(const QString &streamPath);
+    int pullBytesToDecode(char *buffer, int maxBytes) override;
 
 public:
     explicit AudioFileStreamerNode(const QString &file);
     ~AudioFileStreamerNode();
     virtual void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
                                   const Midi::MidiMessageBuffer &midiBuffer);
+private:
+    QByteArray fileBytes;
+    int fileReadPosition;
 };
 
 // ++++++++++++++++++++++
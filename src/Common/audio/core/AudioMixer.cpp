@@ -8,32 +8,89 @@
 
 using namespace Audio;
 
+/***
+    Nodes generating samples in the same source sample rate are processed (gain, pan, peaks, etc.) in the
+    source sample rate and summed in the bus buffer. The bus is resampled once to the mixer sample rate,
+    so 30 remote tracks at 44100 Hz in a 48000 Hz audio device are using just one resampler.
+ */
+class AudioMixer::ResamplingBus
+{
+public:
+    ResamplingBus() :
+        buffer(2, MAX_FRAMES),
+        discardBuffer(2, MAX_FRAMES),
+        resamplingCorrection(0),
+        active(false)
+    {
+    }
+
+    // called when the first node in the bus is processed
+    void start(int sourceSampleRate, int targetSampleRate, int outFrameLenght)
+    {
+        int frames = AudioNode::getInputResamplingLength(sourceSampleRate, targetSampleRate,
+                                                         outFrameLenght, resamplingCorrection);
+        buffer.setFrameLenght(frames);
+        buffer.zero();
+        discardBuffer.setFrameLenght(frames);
+        active = true;
+    }
+
+    void finish(SamplesBuffer &out)
+    {
+        out.add(resampler.resample(buffer, out.getFrameLenght()));
+        active = false;
+    }
+
+    SamplesBuffer buffer; // summed samples in the source sample rate
+    SamplesBuffer discardBuffer; // used by muted nodes
+    SamplesBufferResampler resampler;
+    double resamplingCorrection;
+    bool active;
+
+    static const int MAX_FRAMES; // preallocated, the audio thread is not resizing the buffers in smaller blocks
+};
+
+const int AudioMixer::ResamplingBus::MAX_FRAMES = 4096 * 2;
+
+// the buses are created in the constructor, the audio thread is just looking up the bus for each node
+const int AudioMixer::RESAMPLING_BUSES_SAMPLE_RATES[] = {22050, 32000, 44100, 48000, 88200, 96000};
+
+// ++++++++++++++++++++++
+
 AudioMixer::AudioMixer(int sampleRate) :
-    sampleRate(sampleRate)
+    sampleRate(sampleRate),
+    resamplingBusesEnabled(true)
+{
+    for (int sourceSampleRate : RESAMPLING_BUSES_SAMPLE_RATES)
+        resamplingBuses.insert(sourceSampleRate, new ResamplingBus());
+}
+
+void AudioMixer::setResamplingBusesEnabled(bool enabled)
+{
+    resamplingBusesEnabled = enabled;
+}
+
+AudioMixer::ResamplingBus *AudioMixer::getResamplingBus(int sourceSampleRate)
 {
+    return resamplingBuses.value(sourceSampleRate, nullptr); // no allocations in the audio thread
 }
 
 void AudioMixer::addNode(AudioNode *node)
 {
-    nodes.append(node);
-    resamplers.insert(node, new SamplesBufferResampler());
+    nodes.append(node); // the nodes are resampled in the resampling buses, or by the node when there is no bus for the source sample rate
 }
 
 void AudioMixer::removeNode(AudioNode *node)
 {
-    SamplesBufferResampler *resampler = resamplers[node];
     nodes.removeOne(node);
-    if (resampler) {
-        resamplers[node] = nullptr;
-        delete resampler;
-    }
 }
 
 AudioMixer::~AudioMixer()
 {
     qCDebug(jtAudio) << "Audio mixer destructor...";
-    foreach (Audio::AudioNode *node, resamplers.keys())
-        removeNode(node);
+    nodes.clear();
+    qDeleteAll(resamplingBuses);
+    resamplingBuses.clear();
     qCDebug(jtAudio) << "Audio mixer destructor finished!";
 }
 
@@ -44,10 +101,37 @@ void AudioMixer::process(const SamplesBuffer &in, SamplesBuffer &out, int sample
     // --------------------------------------
     bool hasSoloedBuffers = soloedBuffersInLastProcess > 0;
     soloedBuffersInLastProcess = 0;
+
+    // plugin delay compensation: all nodes are delayed to be aligned with the node using the plugins with bigger latency
+    int maxLatency = 0;
+    foreach (AudioNode *node, nodes)
+        maxLatency = qMax(maxLatency, node->getProcessorsLatency());
+    foreach (AudioNode *node, nodes) {
+        int compensation = maxLatency - node->getProcessorsLatency();
+        int sourceSampleRate = resamplingBusesEnabled ? node->getSourceSampleRate() : 0;
+        if (sourceSampleRate > 0 && sourceSampleRate != sampleRate && resamplingBuses.contains(sourceSampleRate)) // compensation in source samples
+            compensation = static_cast<int>(static_cast<qint64>(compensation) * sourceSampleRate / sampleRate);
+        node->setLatencyCompensation(compensation);
+    }
+
     foreach (AudioNode *node, nodes) {
         bool canProcess = (!hasSoloedBuffers && !node->isMuted())
                           || (hasSoloedBuffers && node->isSoloed());
-        if (canProcess) {
+
+        int sourceSampleRate = resamplingBusesEnabled ? node->getSourceSampleRate() : 0;
+        ResamplingBus *bus = nullptr;
+        if (sourceSampleRate > 0 && sourceSampleRate != sampleRate)
+            bus = getResamplingBus(sourceSampleRate); // null for uncommon sample rates, the node is resampling
+
+        if (bus) {
+            // the node is not resampling, the samples are mixed in the bus buffer using the source sample rate
+            if (!bus->active)
+                bus->start(sourceSampleRate, sampleRate, out.getFrameLenght());
+
+            SamplesBuffer &nodeOut = canProcess ? bus->buffer : bus->discardBuffer;
+            node->processReplacing(in, nodeOut, sourceSampleRate, midiBuffer);
+        }
+        else if (canProcess) {
             node->processReplacing(in, out, sampleRate, midiBuffer);
         } else {// just discard the samples if node is muted, the internalBuffer is not copyed to out buffer
             static Audio::SamplesBuffer internalBuffer(2);
@@ -58,6 +142,12 @@ void AudioMixer::process(const SamplesBuffer &in, SamplesBuffer &out, int sample
             soloedBuffersInLastProcess++;
     }
 
+    // each bus is resampled once
+    foreach (ResamplingBus *bus, resamplingBuses) {
+        if (bus->active)
+            bus->finish(out);
+    }
+
     if (attenuateAfterSumming) {
         int nodesConnected = nodes.size();
         if (nodesConnected > 1)// attenuate
@@ -36,10 +36,25 @@ public:
         this->sampleRate = newSampleRate;
     }
 
+    // when enabled the nodes generating samples in another sample rate (remote tracks) are mixed in the source sample rate and resampled once per bus
+    void setResamplingBusesEnabled(bool enabled);
+
+    inline bool isResamplingBusesEnabled() const
+    {
+        return resamplingBusesEnabled;
+    }
+
 private:
+    class ResamplingBus; // nodes sharing the same source sample rate
+
+    ResamplingBus *getResamplingBus(int sourceSampleRate);
+
     QList<AudioNode *> nodes;
     int sampleRate;
-    QMap<AudioNode *, SamplesBufferResampler *> resamplers;
+    bool resamplingBusesEnabled;
+    QMap<int, ResamplingBus *> resamplingBuses; // source sample rate is the key, not changed after the constructor
+
+    static const int RESAMPLING_BUSES_SAMPLE_RATES[];
     Controller::MainController *mainController;
 };
 // +++++++++++++++++++++++
@@ -8,6 +8,7 @@
 #include <QDebug>
 #include "midi/MidiDriver.h"
 #include <QMutexLocker>
+#include <QElapsedTimer>
 
 #include "audio/Resampler.h"
 
@@ -16,6 +17,13 @@ using namespace Audio;
 const double AudioNode::ROOT_2_OVER_2 = 1.414213562373095 *0.5;
 const double AudioNode::PI_OVER_2 = 3.141592653589793238463 * 0.5;
 
+const float AudioNode::SILENCE_THRESHOLD = 0.0001f; // -80 dB
+const int AudioNode::SLEEP_DELAY = 1000;
+
+const int AudioNode::MAX_LATENCY_COMPENSATION = 8192;
+
+QAtomicInt AudioNode::savedProcessingTime(0);
+
 // +++++++++++++++
 
 void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
@@ -28,6 +36,7 @@ void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, in
 
     internalInputBuffer.setFrameLenght(out.getFrameLenght());
     internalOutputBuffer.setFrameLenght(out.getFrameLenght());
+    processorsChainBuffer.setFrameLenght(out.getFrameLenght());
 
     {
         QMutexLocker locker(&mutex);
@@ -36,30 +45,51 @@ void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, in
                                    midiBuffer);
     }
 
-    internalOutputBuffer.set(internalInputBuffer);// if we have no plugins inserted the input samples are just copied  to output buffer.
-
-
-    static SamplesBuffer tempInputBuffer(2);
-
-    QList<Midi::MidiMessage> midiMessages = midiBuffer.toList();
-
-    // process inserted plugins
+    // the bypass state can be changed in GUI thread, so the active processors are collected before process
+    AudioNodeProcessor *activeProcessors[MAX_PROCESSORS_PER_TRACK];
+    quint32 activeSlots[MAX_PROCESSORS_PER_TRACK];
+    int activeProcessorsCount = 0;
     for (int i=0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
         AudioNodeProcessor *processor = processors[i];
         if (processor && !processor->isBypassed()) {
-            tempInputBuffer.setFrameLenght(internalOutputBuffer.getFrameLenght());
-            tempInputBuffer.set(internalOutputBuffer); //the output from previous plugin is used as input to the next plugin in the chain
+            activeProcessors[activeProcessorsCount] = processor;
+            activeSlots[activeProcessorsCount] = i;
+            activeProcessorsCount++;
+        }
+    }
 
-            processor->process(tempInputBuffer, internalOutputBuffer, midiMessages);
+    if (activeProcessorsCount == 0) {
+        internalOutputBuffer.set(internalInputBuffer);// if we have no plugins inserted the input samples are just copied  to output buffer.
+    }
+    else {
+        processorsMidiBuffer = midiBuffer;
+
+        /**
+            Ping-pong processing: the output of each plugin is the input of the next plugin in the chain,
+        so the plugins are writing alternately in internalOutputBuffer and processorsChainBuffer. The first
+        output buffer is chosen to make the last plugin in the chain writing in internalOutputBuffer, so no
+        samples are copied between the plugins.
+        */
+        const SamplesBuffer *processorInput = &internalInputBuffer;
+        for (int i = 0; i < activeProcessorsCount; ++i) {
+            AudioNodeProcessor *processor = activeProcessors[i];
+            bool writingInOutputBuffer = (activeProcessorsCount - 1 - i) % 2 == 0;
+            SamplesBuffer *processorOutput = writingInOutputBuffer ? &internalOutputBuffer : &processorsChainBuffer;
+
+            process(activeSlots[i], *processorInput, *processorOutput, processorsMidiBuffer, sampleRate);
 
             // some plugins are blocking the midi messages. If a VSTi can't generate messages the previous messages list will be sended for the next plugin in the chain. The messages list is cleared only when the plugin can generate midi messages.
             if (processor->isVirtualInstrument() && processor->canGenerateMidiMessages())
-                midiMessages.clear(); // only the fresh messages will be passed by the next plugin in the chain
+                processorsMidiBuffer.clear(); // only the fresh messages will be passed by the next plugin in the chain
+
+            pullMidiMessagesGeneratedByPlugins(processorsMidiBuffer);
 
-            midiMessages.append(pullMidiMessagesGeneratedByPlugins());
+            processorInput = processorOutput;
         }
     }
 
+    compensateLatency(internalOutputBuffer);
+
     preFaderProcess(internalOutputBuffer); //call overrided preFaderProcess in subclasses to allow some preFader process.
 
     internalOutputBuffer.applyGain(gain, leftGain, rightGain, boost);
@@ -69,6 +99,110 @@ void AudioNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &out, in
     out.add(internalOutputBuffer);
 }
 
+void AudioNode::process(quint32 processorSlotIndex, const SamplesBuffer &in, SamplesBuffer &out,
+                        const Midi::MidiMessageBuffer &midiBuffer, int sampleRate)
+{
+    AudioNodeProcessor *processor = processors[processorSlotIndex];
+    ProcessorSleepState &state = processorsSleepState[processorSlotIndex];
+
+    bool inputIsSilent = in.isSilent(SILENCE_THRESHOLD) && midiBuffer.isEmpty();
+    if (state.sleeping) {
+        if (inputIsSilent) {
+            out.zero(); // sleeping processors are generating silence
+            savedProcessingTime.fetchAndAddRelaxed(static_cast<int>(state.averageProcessingTime));
+            return;
+        }
+        state.sleeping = false; // waking up instantly
+        state.silentFrames = 0;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    processor->process(in, out, midiBuffer);
+
+    float processingTime = timer.nsecsElapsed()/1000.0f;
+    state.averageProcessingTime = state.averageProcessingTime * 0.9f + processingTime * 0.1f;
+
+    if (inputIsSilent && out.isSilent(SILENCE_THRESHOLD)) {
+        state.silentFrames += out.getFrameLenght();
+        quint32 framesToSleep = (quint32)(sampleRate/1000.0 * SLEEP_DELAY) + qMax(0, processor->getTailLength());
+        if (state.silentFrames >= framesToSleep)
+            state.sleeping = true;
+    }
+    else {
+        state.silentFrames = 0;
+    }
+}
+
+int AudioNode::getProcessorsLatency() const
+{
+    int latency = 0;
+    for (int i = 0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
+        AudioNodeProcessor *processor = processors[i];
+        if (processor && !processor->isBypassed())
+            latency += qMax(0, processor->getLatency());
+    }
+    return latency;
+}
+
+void AudioNode::setLatencyCompensation(int samples)
+{
+    samples = qBound(0, samples, MAX_LATENCY_COMPENSATION);
+    if (samples == latencyCompensation)
+        return;
+
+    // the old delayed samples are discarded, avoiding garbage when the delay is increased
+    latencyCompensationBuffer.zero();
+    latencyCompensation = samples;
+}
+
+void AudioNode::compensateLatency(SamplesBuffer &buffer)
+{
+    if (latencyCompensation <= 0)
+        return;
+
+    const quint32 delayLineLenght = latencyCompensationBuffer.getFrameLenght();
+    const quint32 frames = buffer.getFrameLenght();
+    const int channels = qMin(buffer.getChannels(), latencyCompensationBuffer.getChannels());
+    for (int c = 0; c < channels; ++c) {
+        float *delayLine = latencyCompensationBuffer.getSamplesArray(c);
+        float *samples = buffer.getSamplesArray(c);
+        quint32 writeIndex = latencyCompensationWriteIndex;
+        quint32 readIndex = (writeIndex + delayLineLenght - latencyCompensation) % delayLineLenght;
+        for (quint32 s = 0; s < frames; ++s) {
+            delayLine[writeIndex] = samples[s];
+            samples[s] = delayLine[readIndex];
+            if (++writeIndex == delayLineLenght)
+                writeIndex = 0;
+            if (++readIndex == delayLineLenght)
+                readIndex = 0;
+        }
+    }
+    latencyCompensationWriteIndex = (latencyCompensationWriteIndex + frames) % delayLineLenght;
+}
+
+bool AudioNode::processorIsSleeping(quint32 slotIndex) const
+{
+    if (slotIndex >= MAX_PROCESSORS_PER_TRACK || !processors[slotIndex])
+        return false;
+
+    return processorsSleepState[slotIndex].sleeping && !processors[slotIndex]->isBypassed();
+}
+
+quint32 AudioNode::getSavedProcessingTime()
+{
+    return static_cast<quint32>(savedProcessingTime.load());
+}
+
+void AudioNode::resetProcessorSleepState(quint32 slotIndex)
+{
+    ProcessorSleepState &state = processorsSleepState[slotIndex];
+    state.silentFrames = 0;
+    state.averageProcessingTime = 0;
+    state.sleeping = false;
+}
+
 void AudioNode::setRmsWindowSize(int samples)
 {
     internalOutputBuffer.setRmsWindowSize(samples);
@@ -77,6 +211,7 @@ void AudioNode::setRmsWindowSize(int samples)
 AudioNode::AudioNode() :
     internalInputBuffer(2),
     internalOutputBuffer(2),
+    processorsChainBuffer(2),
     lastPeak(),
     muted(false),
     soloed(false),
@@ -86,19 +221,30 @@ AudioNode::AudioNode() :
     pan(0),
     leftGain(1.0),
     rightGain(1.0),
-    resamplingCorrection(0)
+    resamplingCorrection(0),
+    latencyCompensationBuffer(2, MAX_LATENCY_COMPENSATION + 1),
+    latencyCompensationWriteIndex(0),
+    latencyCompensation(0)
 {
-    for(int i=0; i < MAX_PROCESSORS_PER_TRACK; ++i)
+    for(int i=0; i < MAX_PROCESSORS_PER_TRACK; ++i) {
         processors[i] = nullptr;
+        resetProcessorSleepState(i);
+    }
 }
 
-QList<Midi::MidiMessage> AudioNode::pullMidiMessagesGeneratedByPlugins() const
+void AudioNode::pullMidiMessagesGeneratedByPlugins(Midi::MidiMessageBuffer &outBuffer) const
 {
-    return QList<Midi::MidiMessage>(); // returning empty list by default, is overrided in LocalInputNode
+    Q_UNUSED(outBuffer); // no messages by default, is overrided in LocalInputNode
 }
 
 int AudioNode::getInputResamplingLength(int sourceSampleRate, int targetSampleRate,
                                         int outFrameLenght)
+{
+    return getInputResamplingLength(sourceSampleRate, targetSampleRate, outFrameLenght, resamplingCorrection);
+}
+
+int AudioNode::getInputResamplingLength(int sourceSampleRate, int targetSampleRate,
+                                        int outFrameLenght, double &resamplingCorrection)
 {
     double doubleValue = (double)sourceSampleRate*(double)outFrameLenght/(double)targetSampleRate;
     int intValue = (int)doubleValue;
@@ -206,6 +352,7 @@ void AudioNode::addProcessor(AudioNodeProcessor *newProcessor, quint32 slotIndex
 {
     assert(newProcessor);
     assert(slotIndex < MAX_PROCESSORS_PER_TRACK);
+    resetProcessorSleepState(slotIndex);
     processors[slotIndex] = newProcessor;
 }
 
@@ -3,16 +3,13 @@
 
 #include <QSet>
 #include <QMutex>
+#include <QAtomicInt>
 #include "SamplesBuffer.h"
 #include "AudioDriver.h"
-#include "midi/MidiMessage.h"
+#include "midi/MidiMessageBuffer.h"
 #include <QDebug>
 #include <QList>
 
-namespace Midi   {
-class MidiMessageBuffer;
-}
-
 namespace Audio {
 
 class AudioNodeProcessor;
@@ -27,7 +24,7 @@ public:
     virtual void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
                                   const Midi::MidiMessageBuffer &midiBuffer);
 
-    virtual QList<Midi::MidiMessage> pullMidiMessagesGeneratedByPlugins() const;
+    virtual void pullMidiMessagesGeneratedByPlugins(Midi::MidiMessageBuffer &outBuffer) const;
 
     virtual void setMute(bool muted);
 
@@ -52,6 +49,22 @@ public:
     void resumeProcessors();
     virtual void updateProcessorsGui();
 
+    bool processorIsSleeping(quint32 slotIndex) const;
+
+    int getProcessorsLatency() const; // sum of non bypassed processors latencies, in samples
+
+    // delay (in samples) applied after the processors chain to align this node with the nodes using plugins with more latency
+    void setLatencyCompensation(int samples);
+    inline int getLatencyCompensation() const
+    {
+        return latencyCompensation;
+    }
+
+    static const int MAX_LATENCY_COMPENSATION;
+
+    // microseconds saved by all sleeping processors. The counter is wrapping around, use the difference between two readings
+    static quint32 getSavedProcessingTime();
+
     void setGain(float gainValue);
     void setBoost(float boostValue);
 
@@ -94,6 +107,15 @@ public:
 
     virtual void reset();// reset pan, gain, boost, etc
 
+    // sample rate of the samples generated by this node before any resampling, zero when the node is generating samples in the mixer sample rate. Nodes sharing the same source sample rate are mixed and resampled together by AudioMixer
+    virtual int getSourceSampleRate() const
+    {
+        return 0;
+    }
+
+    // input frames needed to render 'outFrameLenght' frames after resampling. The fractional part is accumulated in 'resamplingCorrection'
+    static int getInputResamplingLength(int sourceSampleRate, int targetSampleRate, int outFrameLenght, double &resamplingCorrection);
+
     static const quint8 MAX_PROCESSORS_PER_TRACK = 4;
 protected:
 
@@ -105,6 +127,7 @@ protected:
     AudioNodeProcessor *processors[MAX_PROCESSORS_PER_TRACK];
     SamplesBuffer internalInputBuffer;
     SamplesBuffer internalOutputBuffer;
+    SamplesBuffer processorsChainBuffer; // used with internalOutputBuffer to process the plugins chain without copies
 
     mutable Audio::AudioPeak lastPeak;
     QMutex mutex; // used to protected connections manipulation because nodes can be added or removed by different threads
@@ -125,11 +148,43 @@ private:
     float leftGain;
     float rightGain;
 
+    /**
+        The processors are sleeping (not processed) when the input and the output are silent for a while and
+    the processor tail is elapsed. Sleeping processors are waking up when the input or MIDI activity return.
+    */
+    struct ProcessorSleepState
+    {
+        quint32 silentFrames;
+        float averageProcessingTime; // in microseconds
+        bool sleeping;
+    };
+
+    ProcessorSleepState processorsSleepState[MAX_PROCESSORS_PER_TRACK];
+
+    void resetProcessorSleepState(quint32 slotIndex);
+
+    void process(quint32 processorSlotIndex, const SamplesBuffer &in, SamplesBuffer &out,
+                 const Midi::MidiMessageBuffer &midiBuffer, int sampleRate);
+
+    Midi::MidiMessageBuffer processorsMidiBuffer; // messages passed through the plugins chain, reused in each audio callback
+
+    static QAtomicInt savedProcessingTime;
+
+    static const float SILENCE_THRESHOLD;
+    static const int SLEEP_DELAY; // in milliseconds
+
     static const double ROOT_2_OVER_2;
     static const double PI_OVER_2;
 
     double resamplingCorrection;
 
+    // plugin delay compensation, a circular delay line preallocated with MAX_LATENCY_COMPENSATION + 1 frames
+    SamplesBuffer latencyCompensationBuffer;
+    quint32 latencyCompensationWriteIndex;
+    int latencyCompensation;
+
+    void compensateLatency(SamplesBuffer &buffer);
+
     void updateGains();
 
 signals:
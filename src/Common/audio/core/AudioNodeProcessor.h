@@ -2,7 +2,7 @@
 #define _AUDIO_NODE_PROCESSOR_H_
 
 #include <QObject>
-#include "midi/MidiMessage.h"
+#include "midi/MidiMessageBuffer.h"
 
 
 namespace Audio {
@@ -17,8 +17,10 @@ public:
     {
     }
 
+    // 'in' and 'out' are different buffers with the same frame lenght. The previous 'out' content is
+    // undefined, so all 'out' samples must be written (copy 'in' to 'out' when nothing is processed).
     virtual void process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
-                         const QList<Midi::MidiMessage> &midiMessages) = 0;
+                         const Midi::MidiMessageBuffer &midiBuffer) = 0;
     virtual void suspend() = 0;
     virtual void resume() = 0;
     virtual void updateGui() = 0;
@@ -35,6 +37,18 @@ public:
         return bypassed;
     }
 
+    // how many samples the processor can generate after the input become silent (reverbs, delays, etc.)
+    inline virtual int getTailLength() const
+    {
+        return 0;
+    }
+
+    // processing latency (lookahead, linear phase filters, etc.) in samples, used in plugin delay compensation
+    inline virtual int getLatency() const
+    {
+        return 0;
+    }
+
     inline virtual bool isVirtualInstrument() const
     {
         return false;
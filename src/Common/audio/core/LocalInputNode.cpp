@@ -201,7 +201,7 @@ void LocalInputNode::processReplacing(const SamplesBuffer &in, SamplesBuffer &ou
      * Other LocalInputAudioNode instances will read other channels from input SamplesBuffer.
      */
 
-    Midi::MidiMessageBuffer filteredMidiBuffer(midiBuffer.getMessagesCount());
+    filteredMidiBuffer.clear();
     internalInputBuffer.setFrameLenght(out.getFrameLenght());
     internalOutputBuffer.setFrameLenght(out.getFrameLenght());
     internalInputBuffer.zero();
@@ -344,9 +344,9 @@ bool LocalInputNode::canProcessMidiMessage(const Midi::MidiMessage &message) con
     return false;
 }
 
-QList<Midi::MidiMessage> LocalInputNode::pullMidiMessagesGeneratedByPlugins() const
+void LocalInputNode::pullMidiMessagesGeneratedByPlugins(Midi::MidiMessageBuffer &outBuffer) const
 {
-    return mainController->pullMidiMessagesFromPlugins().toList();
+    mainController->pullMidiMessagesFromPlugins(outBuffer);
 }
 
 void LocalInputNode::startMidiNoteLearn()
@@ -52,7 +52,7 @@ public:
 
     bool isReceivingAllMidiChannels() const;
 
-    QList<Midi::MidiMessage> pullMidiMessagesGeneratedByPlugins() const override;
+    void pullMidiMessagesGeneratedByPlugins(Midi::MidiMessageBuffer &outBuffer) const override;
 
     ChannelRange getAudioInputRange() const;
 
@@ -148,6 +148,8 @@ private:
     bool receivingRoutedMidiInput; // true when this is the first subchannel and is receiving midi input from second subchannel (rounted midi input)? issue #102
     bool routingMidiInput; // true when this is the second channel and is sending midi messages to the first channel
 
+    Midi::MidiMessageBuffer filteredMidiBuffer; // reused in each audio callback, avoiding allocations in audio thread
+
     Controller::MainController *mainController;
 
     enum InputMode {
@@ -78,11 +78,10 @@ void JamtabaDelay::start()
 }
 
 void JamtabaDelay::process(const Audio::SamplesBuffer &in, SamplesBuffer &out,
-                           const QList<Midi::MidiMessage> &midiBuffer)
+                           const Midi::MidiMessageBuffer &midiBuffer)
 {
     Q_UNUSED(midiBuffer)
-    Q_UNUSED(in)
-    Q_UNUSED(out)
+    out.set(in);
 // if(isBypassed()){
 // return;
 // }
@@ -55,7 +55,7 @@ public:
     explicit JamtabaDelay(int sampleRate);
     ~JamtabaDelay();
     virtual void process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &out,
-                         const QList<Midi::MidiMessage> &midiBuffer);
+                         const Midi::MidiMessageBuffer &midiBuffer);
     void setDelayTime(int delayTimeInMs);
     void setFeedback(float feedback);
     void setLevel(float level);
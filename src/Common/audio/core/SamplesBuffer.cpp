@@ -2,8 +2,65 @@
 #include <QDebug>
 #include <cmath>
 #include <algorithm>
+#include <cstring>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define JT_USE_SSE
+#endif
 
 using namespace Audio;
+
+// +++++++++++++++++++++ (de)interleave kernels used in the audio driver callbacks
+
+static void deinterleaveStereo(const float *in, float *left, float *right, unsigned int frames)
+{
+    unsigned int i = 0;
+#ifdef JT_USE_SSE
+    for (; i + 4 <= frames; i += 4) {
+        __m128 a = _mm_loadu_ps(in);     // L0 R0 L1 R1
+        __m128 b = _mm_loadu_ps(in + 4); // L2 R2 L3 R3
+        _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        in += 8;
+    }
+#endif
+    for (; i < frames; ++i) {
+        left[i] = *in++;
+        right[i] = *in++;
+    }
+}
+
+static void interleaveStereo(const float *left, const float *right, float *out, unsigned int frames)
+{
+    unsigned int i = 0;
+#ifdef JT_USE_SSE
+    for (; i + 4 <= frames; i += 4) {
+        __m128 l = _mm_loadu_ps(left + i);
+        __m128 r = _mm_loadu_ps(right + i);
+        _mm_storeu_ps(out, _mm_unpacklo_ps(l, r));     // L0 R0 L1 R1
+        _mm_storeu_ps(out + 4, _mm_unpackhi_ps(l, r)); // L2 R2 L3 R3
+        out += 8;
+    }
+#endif
+    for (; i < frames; ++i) {
+        *out++ = left[i];
+        *out++ = right[i];
+    }
+}
+
+// generic kernels, one strided pass per channel (no bounds checking in the inner loops)
+static void deinterleaveChannel(const float *in, unsigned int stride, float *out, unsigned int frames)
+{
+    for (unsigned int i = 0; i < frames; ++i, in += stride)
+        out[i] = *in;
+}
+
+static void interleaveChannel(const float *in, float *out, unsigned int stride, unsigned int frames)
+{
+    for (unsigned int i = 0; i < frames; ++i, out += stride)
+        *out = in[i];
+}
 // +++++++++++++++++=
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -158,6 +215,18 @@ void SamplesBuffer::zero()
         std::fill(samples[c].begin(), samples[c].end(), (float)0);
 }
 
+bool SamplesBuffer::isSilent(float threshold) const
+{
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float *channelSamples = &samples[c][0];
+        for (unsigned int i = 0; i < frameLenght; ++i) {
+            if (std::fabs(channelSamples[i]) >= threshold)
+                return false;
+        }
+    }
+    return true;
+}
+
 AudioPeak SamplesBuffer::computePeak()
 {
     float abs; //max peak absolute value
@@ -276,6 +345,78 @@ float SamplesBuffer::get(int channel, int sampleIndex) const
     return samples[channel][sampleIndex ];
 }
 
+void SamplesBuffer::deinterleave(const float *interleaved, unsigned int frames, unsigned int interleavedChannels)
+{
+    if (!interleaved || interleavedChannels == 0)
+        return;
+
+    frames = std::min(frames, frameLenght);
+    if (frames == 0)
+        return;
+
+    unsigned int channelsToCopy = std::min(channels, interleavedChannels);
+    if (channelsToCopy == 1 && interleavedChannels == 1) {
+        std::memcpy(&samples[0][0], interleaved, frames * sizeof(float));
+    }
+    else if (channelsToCopy == 2 && interleavedChannels == 2) {
+        deinterleaveStereo(interleaved, &samples[0][0], &samples[1][0], frames);
+    }
+    else {
+        for (unsigned int c = 0; c < channelsToCopy; ++c)
+            deinterleaveChannel(interleaved + c, interleavedChannels, &samples[c][0], frames);
+    }
+}
+
+void SamplesBuffer::interleave(float *interleaved, unsigned int frames, unsigned int interleavedChannels) const
+{
+    if (!interleaved || interleavedChannels == 0)
+        return;
+
+    unsigned int framesToCopy = std::min(frames, frameLenght);
+    unsigned int channelsToCopy = std::min(channels, interleavedChannels);
+    if (channelsToCopy < interleavedChannels || framesToCopy < frames)
+        std::fill(interleaved, interleaved + frames * interleavedChannels, 0.0f);
+
+    if (framesToCopy == 0)
+        return;
+
+    if (channelsToCopy == 1 && interleavedChannels == 1)
+        std::memcpy(interleaved, &samples[0][0], framesToCopy * sizeof(float));
+    else if (channelsToCopy == 2 && interleavedChannels == 2)
+        interleaveStereo(&samples[0][0], &samples[1][0], interleaved, framesToCopy);
+    else {
+        for (unsigned int c = 0; c < channelsToCopy; ++c)
+            interleaveChannel(&samples[c][0], interleaved + c, interleavedChannels, framesToCopy);
+    }
+}
+
+void SamplesBuffer::setPlanar(const float *const *planar, unsigned int frames, unsigned int planarChannels)
+{
+    if (!planar)
+        return;
+
+    frames = std::min(frames, frameLenght);
+    if (frames == 0)
+        return;
+
+    unsigned int channelsToCopy = std::min(channels, planarChannels);
+    for (unsigned int c = 0; c < channelsToCopy; ++c)
+        std::memcpy(&samples[c][0], planar[c], frames * sizeof(float));
+}
+
+void SamplesBuffer::copyToPlanar(float *const *planar, unsigned int frames, unsigned int planarChannels) const
+{
+    if (!planar)
+        return;
+
+    unsigned int framesToCopy = std::min(frames, frameLenght);
+    for (unsigned int c = 0; c < planarChannels; ++c) {
+        if (c < channels && framesToCopy > 0)
+            std::memcpy(planar[c], &samples[c][0], framesToCopy * sizeof(float));
+        std::fill(planar[c] + (c < channels ? framesToCopy : 0), planar[c] + frames, 0.0f);
+    }
+}
+
 void SamplesBuffer::setFrameLenght(unsigned int newFrameLenght)
 {
     if (newFrameLenght == frameLenght)
@@ -72,6 +72,8 @@ public:
 
     Audio::AudioPeak computePeak();
 
+    bool isSilent(float threshold) const; // true if all samples absolute values are below threshold
+
     inline void add(const SamplesBuffer &buffer)
     {
         add(buffer, 0);
@@ -90,6 +92,13 @@ public:
 
     float get(int channel, int sampleIndex) const;
 
+    // conversion from/to audio device buffers. The frame lenght is not changed, only the
+    // first 'frames' samples are copied. Device channels without a correspondent internal channel are ignored (input) or zeroed (output)
+    void deinterleave(const float *interleaved, unsigned int frames, unsigned int interleavedChannels);
+    void interleave(float *interleaved, unsigned int frames, unsigned int interleavedChannels) const;
+    void setPlanar(const float *const *planar, unsigned int frames, unsigned int planarChannels);
+    void copyToPlanar(float *const *planar, unsigned int frames, unsigned int planarChannels) const;
+
     int getFrameLenght() const;// { return frameLenght; }
     void setFrameLenght(unsigned int newFrameLenght);
     inline int getChannels() const
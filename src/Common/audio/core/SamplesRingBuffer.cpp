@@ -0,0 +1,108 @@
+#include "SamplesRingBuffer.h"
+#include "SamplesBuffer.h"
+#include <algorithm>
+
+using namespace Audio;
+
+SamplesRingBuffer::SamplesRingBuffer(unsigned int channels, unsigned int capacity) :
+    channels(std::max(1u, channels)),
+    capacity(capacity),
+    size(capacity + 1),
+    samples(this->channels, std::vector<float>(capacity + 1)),
+    readIndex(0),
+    writeIndex(0)
+{
+}
+
+unsigned int SamplesRingBuffer::availableFrames(int readIndex, int writeIndex) const
+{
+    return (writeIndex - readIndex + size) % size;
+}
+
+unsigned int SamplesRingBuffer::getAvailableFrames() const
+{
+    return availableFrames(readIndex.loadAcquire(), writeIndex.loadAcquire());
+}
+
+unsigned int SamplesRingBuffer::getFreeFrames() const
+{
+    return capacity - getAvailableFrames();
+}
+
+template <typename ChannelGetter>
+unsigned int SamplesRingBuffer::writeFrames(ChannelGetter getChannelSamples, unsigned int inputChannels, unsigned int frames)
+{
+    int currentWriteIndex = writeIndex.load();
+    unsigned int freeFrames = capacity - availableFrames(readIndex.loadAcquire(), currentWriteIndex);
+    unsigned int framesToWrite = std::min(freeFrames, frames);
+    if (framesToWrite == 0 || inputChannels == 0)
+        return 0;
+
+    // the copy is splitted in two parts when the end of the ring is reached
+    unsigned int firstPart = std::min(framesToWrite, size - currentWriteIndex);
+    for (unsigned int c = 0; c < channels; ++c) {
+        const float *in = getChannelSamples(std::min(c, inputChannels - 1));
+        float *out = &samples[c][0];
+        std::copy(in, in + firstPart, out + currentWriteIndex);
+        std::copy(in + firstPart, in + framesToWrite, out);
+    }
+
+    writeIndex.storeRelease((currentWriteIndex + framesToWrite) % size); // publish the samples to consumer
+    return framesToWrite;
+}
+
+unsigned int SamplesRingBuffer::write(const SamplesBuffer &buffer)
+{
+    if (buffer.getChannels() <= 0)
+        return 0;
+
+    auto getChannelSamples = [&buffer](unsigned int channel) -> const float * {
+        return buffer.getSamplesArray(channel);
+    };
+    return writeFrames(getChannelSamples, buffer.getChannels(), buffer.getFrameLenght());
+}
+
+unsigned int SamplesRingBuffer::write(const float * const *channelsSamples, unsigned int inputChannels, unsigned int frames)
+{
+    if (!channelsSamples)
+        return 0;
+
+    auto getChannelSamples = [channelsSamples](unsigned int channel) -> const float * {
+        return channelsSamples[channel];
+    };
+    return writeFrames(getChannelSamples, inputChannels, frames);
+}
+
+unsigned int SamplesRingBuffer::read(SamplesBuffer &buffer, unsigned int frames)
+{
+    int currentReadIndex = readIndex.load();
+    unsigned int available = availableFrames(currentReadIndex, writeIndex.loadAcquire());
+    unsigned int framesToRead = std::min(std::min(frames, available), (unsigned int)buffer.getFrameLenght());
+    if (framesToRead == 0)
+        return 0;
+
+    unsigned int firstPart = std::min(framesToRead, size - currentReadIndex);
+    for (int c = 0; c < buffer.getChannels(); ++c) {
+        const float *in = &samples[std::min((unsigned int)c, channels - 1)][0];
+        float *out = buffer.getSamplesArray(c);
+        std::copy(in + currentReadIndex, in + currentReadIndex + firstPart, out);
+        std::copy(in, in + (framesToRead - firstPart), out + firstPart);
+    }
+
+    readIndex.storeRelease((currentReadIndex + framesToRead) % size); // release the space to producer
+    return framesToRead;
+}
+
+unsigned int SamplesRingBuffer::discard(unsigned int frames)
+{
+    int currentReadIndex = readIndex.load();
+    unsigned int framesToDiscard = std::min(frames, availableFrames(currentReadIndex, writeIndex.loadAcquire()));
+    readIndex.storeRelease((currentReadIndex + framesToDiscard) % size);
+    return framesToDiscard;
+}
+
+void SamplesRingBuffer::clear()
+{
+    readIndex.storeRelease(0);
+    writeIndex.storeRelease(0);
+}
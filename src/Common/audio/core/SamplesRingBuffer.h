@@ -0,0 +1,55 @@
+#ifndef SAMPLESRINGBUFFER_H
+#define SAMPLESRINGBUFFER_H
+
+#include <vector>
+#include <QAtomicInt>
+
+namespace Audio {
+class SamplesBuffer;
+
+/***
+  A fixed capacity planar ring buffer. Samples are never moved and no memory is allocated after
+  the construction. One thread can write (producer) while another thread is reading (consumer)
+  without locks, so this class can be used to pass audio from a worker thread to the audio thread.
+ */
+class SamplesRingBuffer
+{
+public:
+    SamplesRingBuffer(unsigned int channels, unsigned int capacity);
+
+    inline unsigned int getChannels() const { return channels; }
+    inline unsigned int getCapacity() const { return capacity; }
+
+    unsigned int getAvailableFrames() const; // frames ready to be read
+    unsigned int getFreeFrames() const; // frames that can be written
+
+    // producer side, return the number of written frames. Mono buffers are copied to all channels.
+    unsigned int write(const SamplesBuffer &buffer);
+
+    // producer side, copy 'frames' samples from planar arrays (decoders output) without intermediate buffers
+    unsigned int write(const float * const *channelsSamples, unsigned int inputChannels, unsigned int frames);
+
+    // consumer side, read until 'frames' samples to the buffer begining. The buffer frame lenght is not changed.
+    unsigned int read(SamplesBuffer &buffer, unsigned int frames);
+    unsigned int discard(unsigned int frames);
+
+    void clear(); // not thread safe, producer and consumer can't be running
+
+private:
+    unsigned int channels;
+    unsigned int capacity;
+    unsigned int size; // capacity + 1, one slot is always empty to distinguish full and empty buffers
+    std::vector<std::vector<float>> samples;
+
+    QAtomicInt readIndex; // changed only by the consumer
+    QAtomicInt writeIndex; // changed only by the producer
+
+    unsigned int availableFrames(int readIndex, int writeIndex) const;
+
+    template <typename ChannelGetter>
+    unsigned int writeFrames(ChannelGetter getChannelSamples, unsigned int inputChannels, unsigned int frames);
+};
+
+} // namespace
+
+#endif // SAMPLESRINGBUFFER_H
@@ -6,6 +6,7 @@
 #include <QDebug>
 #include "audio/core/AudioDriver.h"
 #include "audio/core/SamplesBuffer.h"
+#include "audio/core/SamplesRingBuffer.h"
 #include <vorbis/vorbisfile.h>
 #include <QThread>
 #include "log/Logging.h"
@@ -13,30 +14,24 @@
 VorbisDecoder::VorbisDecoder()
     : internalBuffer(2, 4096),
       initialized(false),
-      vorbisInput()
+      vorbisInput(),
+      inputPosition(0)
 {
-    outBuffer = new float*[2];
-    outBuffer[0] = new float[2048];
-    outBuffer[1] = new float[2048];
     vorbisFile.vi = nullptr;
 }
 //+++++++++++++++++++++++++++++++++++++++++++
 VorbisDecoder::~VorbisDecoder(){
     qCDebug(jtNinjamVorbisDecoder) << "Destrutor Vorbis Decoder";
-    //TODO this destructor is crashing when a track is removed
-    //delete [] outBuffer[0];
-    //delete [] outBuffer[1];
-    //delete [] outBuffer;
 
     if(initialized)
         ov_clear(&vorbisFile);
 }
 //+++++++++++++++++++++++++++++++++++++++++++
 size_t VorbisDecoder::consumeTo(void *oggOutBuffer, size_t bytesToConsume){
-    size_t len = qMin( bytesToConsume, (size_t)vorbisInput.size());
+    size_t len = qMin( bytesToConsume, (size_t)(vorbisInput.size() - inputPosition));
     if(len > 0){
-        memcpy(oggOutBuffer, vorbisInput.data(), len);
-        vorbisInput.remove(0, (uint)len);
+        memcpy(oggOutBuffer, vorbisInput.constData() + inputPosition, len);
+        inputPosition += (int)len;
     }
     return len;
 }
@@ -47,15 +42,15 @@ size_t VorbisDecoder::readOgg(void *oggOutBuffer, size_t size, size_t nmemb, voi
     return decoderInstance->consumeTo(oggOutBuffer, size * nmemb);
 }
 //+++++++++++++++++++++++++++++++++++++++++++
-const Audio::SamplesBuffer &VorbisDecoder::decode(int maxSamplesToDecode){
+long VorbisDecoder::decodeNextSamples(float ***pcmChannels, int maxSamplesToDecode){
     if(!initialized){
         initialize();
     }
     if(!initialized){
-        return Audio::SamplesBuffer::ZERO_BUFFER;
+        return 0;
     }
-    //static float decoderOutBuffer[vorbisFile.vi->channels]
-    long samplesDecoded = ov_read_float(&vorbisFile, &outBuffer, maxSamplesToDecode, NULL);//currentSection is not used
+    //pcmChannels will point to the vorbisfile internal buffers, valid until the next read
+    long samplesDecoded = ov_read_float(&vorbisFile, pcmChannels, maxSamplesToDecode, NULL);//currentSection is not used
     if(samplesDecoded < 0){//error
         QString message;
         switch (samplesDecoded) {
@@ -66,18 +61,51 @@ const Audio::SamplesBuffer &VorbisDecoder::decode(int maxSamplesToDecode){
             case OV_EINVAL: message = "VORBIS ERROR: the initial file headers couldn't be read or are corrupt, or that the initial open call for vf failed.";
         }
         qCWarning(jtNinjamVorbisDecoder) << message;
+        return 0;
+    }
+    return samplesDecoded;
+}
+//+++++++++++++++++++++++++++++++++++++++++++
+const Audio::SamplesBuffer &VorbisDecoder::decode(int maxSamplesToDecode){
+    float **pcmChannels = nullptr;
+    long samplesDecoded = decodeNextSamples(&pcmChannels, maxSamplesToDecode);
+    if(samplesDecoded <= 0){
         return Audio::SamplesBuffer::ZERO_BUFFER;
     }
     internalBuffer.setFrameLenght(samplesDecoded);
     //internal buffer is always stereo
-    internalBuffer.add(0, outBuffer[0], samplesDecoded);//the left channel is always copyed
-    internalBuffer.add(1, outBuffer[ (vorbisFile.vi->channels >= 2) ? 1 : 0 ], samplesDecoded);
+    internalBuffer.add(0, pcmChannels[0], samplesDecoded);//the left channel is always copyed
+    internalBuffer.add(1, pcmChannels[ (vorbisFile.vi->channels >= 2) ? 1 : 0 ], samplesDecoded);
     return internalBuffer;
 }
 //+++++++++++++++++++++++++++++++++++++++++++
+unsigned int VorbisDecoder::decode(Audio::SamplesRingBuffer &destination, unsigned int maxSamplesToDecode){
+    unsigned int samplesToDecode = qMin(maxSamplesToDecode, destination.getFreeFrames());
+    unsigned int totalDecoded = 0;
+    while(totalDecoded < samplesToDecode){ //vorbisfile return at most one vorbis packet in each read
+        float **pcmChannels = nullptr;
+        long samplesDecoded = decodeNextSamples(&pcmChannels, samplesToDecode - totalDecoded);
+        if(samplesDecoded <= 0){
+            break; //no more samples to decode
+        }
+        //mono streams are copied to all destination channels
+        totalDecoded += destination.write(pcmChannels, vorbisFile.vi->channels, samplesDecoded);
+    }
+    return totalDecoded;
+}
+//+++++++++++++++++++++++++++++++++++++++++++
 void VorbisDecoder::setInputData(const QByteArray &vorbisData){
-    vorbisInput.clear();
-    vorbisInput.append(vorbisData);
+    vorbisInput = vorbisData;
+    inputPosition = 0;
+}
+
+void VorbisDecoder::reset(const QByteArray &vorbisData){
+    if(initialized){
+        ov_clear(&vorbisFile); //the next decode will read the new stream headers
+        initialized = false;
+    }
+    vorbisFile.vi = nullptr;
+    setInputData(vorbisData);
 }
 
 //+++++++++++++++++++++++++++++++++++++++++++
@@ -2,6 +2,10 @@
 #include "audio/core/SamplesBuffer.h"
 #include <QByteArray>
 
+namespace Audio {
+class SamplesRingBuffer;
+}
+
 #ifndef VORBIS_DECODER_H
 #define VORBIS_DECODER_H
 
@@ -12,6 +16,9 @@ public:
     ~VorbisDecoder();
     const Audio::SamplesBuffer &decode(int maxSamplesToDecode);
 
+    // decode straight into 'destination', limited by free space in destination. Return the decoded frames, zero when the input is finished.
+    unsigned int decode(Audio::SamplesRingBuffer &destination, unsigned int maxSamplesToDecode);
+
     inline bool isStereo() const
     {
         return getChannels() == 2;
@@ -39,7 +46,9 @@ public:
         return initialized;
     }
 
-    void setInputData(const QByteArray &vorbisData);
+    void setInputData(const QByteArray &vorbisData); // the data is shared, not copied
+
+    void reset(const QByteArray &vorbisData); // start decoding a new stream, the decoder buffers are reused
 
     bool initialize();
 
@@ -49,10 +58,12 @@ private:
     OggVorbis_File vorbisFile;
     bool initialized;
     QByteArray vorbisInput;
-    float **outBuffer;
+    int inputPosition; // the consumed input bytes are not removed, the position is moved
     static size_t readOgg(void *oggOutBuffer, size_t size, size_t nmemb, void *decoderInstance);
 
     size_t consumeTo(void *oggOutBuffer, size_t bytesToConsume);
+
+    long decodeNextSamples(float ***pcmChannels, int maxSamplesToDecode);
 };
 
 #endif
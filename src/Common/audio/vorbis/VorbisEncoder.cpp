@@ -11,18 +11,23 @@ const float VorbisEncoder::QUALITY_NORMAL =  0; // ~64 – ~80 kbps.
 const float VorbisEncoder::QUALITY_HIGH   =  0.3f;  // ~112 – ~128 kbps. In ogg vorbis 112 Kbps is better than 128 kbps mp3
 
 VorbisEncoder::VorbisEncoder()
-    :initialized(false)
+    :initialized(false),
+      dspStateInitialized(false),
+      streamStateInitialized(false)
 {
     init(1, 44100, QUALITY_NORMAL);
 }
 
 VorbisEncoder::VorbisEncoder(int channels, int sampleRate, float quality):
-    initialized(false)
+    initialized(false),
+    dspStateInitialized(false),
+    streamStateInitialized(false)
 {
     init(channels, sampleRate, quality);
 }
 
 void VorbisEncoder::init(int channels, int sampleRate, float quality){
+    this->quality = quality;
     vorbis_info_init(&info);
 
     if(vorbis_encode_init_vbr(&info, (long) channels, (long) sampleRate, quality) != 0){
@@ -34,32 +39,49 @@ void VorbisEncoder::init(int channels, int sampleRate, float quality){
     qCDebug(jtNinjamVorbisEncoder) << "Initializing VorbisEncoder sampleRate:" << sampleRate << " channels: " << channels << " quality: " << quality;
 
     streamID = 0;
-    isFirstEncoding = true;
 
     totalEncoded = 0;
 }
 
 //++++++++++++++++++++++++++++++++++++++++++
-void VorbisEncoder::clearState(){
-    ogg_stream_clear(&streamState);
-    vorbis_block_clear(&block);
-    vorbis_dsp_clear(&dspState);
+void VorbisEncoder::clearDspState(){
+    if(dspStateInitialized){
+        vorbis_block_clear(&block);
+        vorbis_dsp_clear(&dspState);
+        dspStateInitialized = false;
+    }
+}
+
+void VorbisEncoder::reset(){
+    initialized = false; //the dsp state is cleared when the next interval headers are encoded
     outBuffer.clear();
 }
 
 VorbisEncoder::~VorbisEncoder() {
     qCDebug(jtNinjamVorbisEncoder) << "ENCODER DESTRUCTOR! Thread:" <<  QThread::currentThreadId();
-    if(initialized){
-        clearState();
+    clearDspState();
+    if(streamStateInitialized){
+        ogg_stream_clear(&streamState);
     }
     vorbis_comment_clear(&comment);
     vorbis_info_clear(&info);
 }
 //++++++++++++++++++++++++++++++++++++++++++
 void VorbisEncoder::encodeFirstVorbisHeaders(){
+    //each interval is a new vorbis stream, libvorbis has no way to restart the analysis without reallocate the dsp state
+    clearDspState();
     vorbis_analysis_init(&dspState, &info);
     vorbis_block_init(&dspState, &block);
-    ogg_stream_init(&streamState, streamID++);
+    dspStateInitialized = true;
+
+    //the ogg stream buffers are reused, only the stream state and serial number are restarted
+    if(streamStateInitialized){
+        ogg_stream_reset_serialno(&streamState, streamID++);
+    }
+    else{
+        ogg_stream_init(&streamState, streamID++);
+        streamStateInitialized = true;
+    }
 
     //writing headers
     ogg_packet header, header_comm, header_code;
@@ -78,21 +100,15 @@ void VorbisEncoder::encodeFirstVorbisHeaders(){
         outBuffer.append((const char*)page.body, page.body_len);//memcpy(buffer, page.body, page.body_len);
     }
     initialized = true;
-    isFirstEncoding = false;//clear state in next encoding
 }
 
 //++++++++++++++++++++++++++++++++++++++++++
 QByteArray VorbisEncoder::encode(const Audio::SamplesBuffer& samples) {
     //qCDebug(vorbisEncoder) << "Encoding " << samples.getFrameLenght() << " samples.";
+    outBuffer.clear();
     if (!initialized) {
-        if(!isFirstEncoding){
-            clearState();
-        }
         encodeFirstVorbisHeaders();
     }
-    else{
-        outBuffer.clear();
-    }
 
     if (samples.getFrameLenght() > 0) {//is not the end
         //copy the samples to encode to vorbis input buffer
@@ -15,8 +15,10 @@ public:
 
     QByteArray encode(const Audio::SamplesBuffer& in);
     QByteArray finishIntervalEncoding();
+    void reset(); // discard the current interval, the next encoded samples will start a new ogg stream
     inline int getChannels() const{return info.channels;}
     inline int getSampleRate() const{return info.rate;}
+    inline float getQuality() const{return quality;}
 
     static const float QUALITY_LOW;
     static const float QUALITY_NORMAL;
@@ -33,16 +35,17 @@ private:
 
     int totalEncoded;
 
-    bool initialized;
+    bool initialized; // the current interval headers are encoded
+
+    bool dspStateInitialized; // dspState and block are allocated
+    bool streamStateInitialized; // streamState is allocated, reused in all intervals
 
     QByteArray outBuffer;
 
     void init(int channels, int sampleRate, float quality);
 
     void encodeFirstVorbisHeaders();
-    void clearState();
-
-    bool isFirstEncoding;
+    void clearDspState();
 
     int streamID;
 };
@@ -0,0 +1,196 @@
+#include "IP2LocationDatabase.h"
+
+#include <QtEndian>
+#include <QStringList>
+#include <cstring>
+#include "log/Logging.h"
+
+using namespace Geo;
+
+// file format in http://www.ip2location.com/developers (the column positions are indexed by database type, DB1 to DB24)
+const int IP2LocationDatabase::MAX_DATABASE_TYPE = 24;
+const quint8 IP2LocationDatabase::COUNTRY_POSITION[]   = {0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+const quint8 IP2LocationDatabase::CITY_POSITION[]      = {0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4};
+const quint8 IP2LocationDatabase::LATITUDE_POSITION[]  = {0, 0, 0, 0, 0, 5, 5, 0, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5};
+const quint8 IP2LocationDatabase::LONGITUDE_POSITION[] = {0, 0, 0, 0, 0, 6, 6, 0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6};
+
+IP2LocationDatabase::IP2LocationDatabase(const QString &filePath) :
+    file(filePath),
+    data(nullptr),
+    dataSize(0),
+    databaseType(0),
+    databaseColumns(0),
+    ipv4Count(0),
+    ipv4BaseAddress(0),
+    ipv4IndexBaseAddress(0)
+{
+    if (!file.open(QFile::ReadOnly)) {
+        qCritical() << "Can't open the IP2Location database " << filePath;
+        return;
+    }
+
+    dataSize = file.size();
+    if (dataSize < 29) {
+        qCritical() << "Invalid IP2Location database " << filePath;
+        return;
+    }
+
+    data = file.map(0, dataSize);
+    if (!data) {
+        qCritical() << "Can't map the IP2Location database " << filePath << " in memory";
+        return;
+    }
+
+    databaseType = data[0];
+    databaseColumns = data[1];
+    ipv4Count = read32(6);
+    ipv4BaseAddress = read32(10);
+    ipv4IndexBaseAddress = read32(22);
+
+    bool validHeader = databaseType > 0 && databaseType <= MAX_DATABASE_TYPE && databaseColumns >= 2
+            && isValidAddress(ipv4BaseAddress, ipv4Count * databaseColumns * 4);
+    if (!validHeader) {
+        qCritical() << "Invalid IP2Location database header in " << filePath;
+        file.unmap(const_cast<uchar *>(data));
+        data = nullptr;
+        return;
+    }
+
+    qCDebug(jtIpToLocation) << "IP2Location database DB" << databaseType << " mapped: " << ipv4Count << " IPv4 ranges";
+}
+
+IP2LocationDatabase::~IP2LocationDatabase()
+{
+    if (data)
+        file.unmap(const_cast<uchar *>(data));
+}
+
+bool IP2LocationDatabase::isValidAddress(quint32 address, quint32 bytes) const
+{
+    return address > 0 && static_cast<qint64>(address) - 1 + bytes <= dataSize;
+}
+
+quint32 IP2LocationDatabase::read32(quint32 address) const
+{
+    if (!isValidAddress(address, 4))
+        return 0;
+    return qFromLittleEndian<quint32>(data + address - 1);
+}
+
+float IP2LocationDatabase::readFloat(quint32 address) const
+{
+    quint32 bits = read32(address);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+QString IP2LocationDatabase::readString(quint32 offset) const
+{
+    // strings are stored as a length byte followed by the characters, and the offset is 0-based
+    if (static_cast<qint64>(offset) >= dataSize)
+        return QString();
+
+    quint8 length = data[offset];
+    if (static_cast<qint64>(offset) + 1 + length > dataSize)
+        return QString();
+
+    return QString::fromLatin1(reinterpret_cast<const char *>(data + offset + 1), length);
+}
+
+bool IP2LocationDatabase::parseIPv4(const QString &ip, quint32 &ipNumber)
+{
+    QStringList parts = ip.split('.');
+    if (parts.size() != 4)
+        return false;
+
+    ipNumber = 0;
+    for (const QString &part : parts) {
+        quint32 octet = 0;
+        if (part != "x") { // ninjam servers are masking the last part of the users IP
+            bool ok = false;
+            octet = part.toUInt(&ok);
+            if (!ok || octet > 255)
+                return false;
+        }
+        ipNumber = (ipNumber << 8) | octet;
+    }
+    return true;
+}
+
+bool IP2LocationDatabase::findRow(quint32 ipNumber, quint32 &rowAddress) const
+{
+    if (ipNumber == 0xFFFFFFFF)
+        ipNumber--; // the last range is open in the upper bound
+
+    quint32 rowSize = databaseColumns * 4;
+    quint32 low = 0;
+    quint32 high = ipv4Count;
+
+    // the index (when available) narrows the search to the rows of the first 16 bits of the IP
+    if (ipv4IndexBaseAddress > 0) {
+        quint32 indexAddress = ipv4IndexBaseAddress + ((ipNumber >> 16) << 3);
+        if (isValidAddress(indexAddress, 8)) {
+            low = read32(indexAddress);
+            high = read32(indexAddress + 4);
+        }
+    }
+
+    while (low <= high && high <= ipv4Count) {
+        quint32 middle = low + (high - low) / 2;
+        quint32 address = ipv4BaseAddress + middle * rowSize;
+        quint32 ipFrom = read32(address);
+        quint32 ipTo = read32(address + rowSize);
+
+        if (ipNumber >= ipFrom && ipNumber < ipTo) {
+            rowAddress = address;
+            return true;
+        }
+
+        if (ipNumber < ipFrom) {
+            if (middle == 0)
+                break;
+            high = middle - 1;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return false;
+}
+
+Location IP2LocationDatabase::readLocation(quint32 rowAddress) const
+{
+    quint32 countryOffset = read32(rowAddress + 4 * (COUNTRY_POSITION[databaseType] - 1));
+    QString countryCode = readString(countryOffset);
+    QString countryName = readString(countryOffset + 3);
+
+    if (countryCode.isEmpty() || countryCode == "-")
+        return Location(); // IP2Location is using '-' for reserved/private ranges
+
+    double latitude = -200;
+    double longitude = -200;
+    if (LATITUDE_POSITION[databaseType] > 0 && LONGITUDE_POSITION[databaseType] > 0) {
+        latitude = readFloat(rowAddress + 4 * (LATITUDE_POSITION[databaseType] - 1));
+        longitude = readFloat(rowAddress + 4 * (LONGITUDE_POSITION[databaseType] - 1));
+    }
+
+    QString city("UNKNOWN");
+    if (CITY_POSITION[databaseType] > 0)
+        city = readString(read32(rowAddress + 4 * (CITY_POSITION[databaseType] - 1)));
+
+    return Location(countryName, countryCode, latitude, longitude, city);
+}
+
+Location IP2LocationDatabase::lookup(const QString &ip) const
+{
+    quint32 ipNumber = 0;
+    if (!isOpen() || !parseIPv4(ip, ipNumber))
+        return Location();
+
+    quint32 rowAddress = 0;
+    if (!findRow(ipNumber, rowAddress))
+        return Location();
+
+    return readLocation(rowAddress);
+}
@@ -0,0 +1,64 @@
+#ifndef IP2LOCATIONDATABASE_H
+#define IP2LOCATIONDATABASE_H
+
+#include "IpToLocationResolver.h"
+#include <QFile>
+
+namespace Geo {
+
+/***
+  Read only view over an IP2Location LITE (http://lite.ip2location.com) .BIN database. The file is
+  memory mapped and the IPv4 ranges are binary searched in place (using the database index when
+  available), so the file is never loaded in memory and each lookup is O(log n).
+
+  The lookup functions are const and only read the mapped memory, so they can be called from
+  worker threads.
+ */
+class IP2LocationDatabase
+{
+public:
+    explicit IP2LocationDatabase(const QString &filePath);
+    ~IP2LocationDatabase();
+
+    bool isOpen() const;
+
+    Location lookup(const QString &ip) const;
+
+    static bool parseIPv4(const QString &ip, quint32 &ipNumber);
+
+private:
+    QFile file;
+    const uchar *data;
+    qint64 dataSize;
+
+    quint8 databaseType;
+    quint8 databaseColumns;
+    quint32 ipv4Count;
+    quint32 ipv4BaseAddress;
+    quint32 ipv4IndexBaseAddress;
+
+    // all addresses are 1-based, as in the IP2Location file specification
+    quint32 read32(quint32 address) const;
+    float readFloat(quint32 address) const;
+    QString readString(quint32 offset) const;
+
+    bool findRow(quint32 ipNumber, quint32 &rowAddress) const;
+    Location readLocation(quint32 rowAddress) const;
+
+    bool isValidAddress(quint32 address, quint32 bytes) const;
+
+    static const int MAX_DATABASE_TYPE;
+    static const quint8 COUNTRY_POSITION[];
+    static const quint8 CITY_POSITION[];
+    static const quint8 LATITUDE_POSITION[];
+    static const quint8 LONGITUDE_POSITION[];
+};
+
+inline bool IP2LocationDatabase::isOpen() const
+{
+    return data != nullptr;
+}
+
+} // namespace
+
+#endif // IP2LOCATIONDATABASE_H
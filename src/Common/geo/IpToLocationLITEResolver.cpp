@@ -1,50 +1,90 @@
 #include "IpToLocationLITEResolver.h"
 
-#include <cstring>
+#include <QtConcurrent/QtConcurrent>
+#include "log/Logging.h"
 
-//library in http://www.ip2location.com/developers
+//database files in http://lite.ip2location.com
 
 using namespace Geo;
 
-IpToLocationLITEResolver::IpToLocationLITEResolver(QString binFilePath)
+const int IpToLocationLITEResolver::BATCH_DELAY = 50;
+
+IpToLocationLITEResolver::IpToLocationLITEResolver(const QString &databaseFilePath) :
+    database(databaseFilePath)
 {
-    const char* filePath = binFilePath.toStdString().c_str();
-    this->IP2LocationObj = IP2Location_open((char*)filePath);
+    batchTimer.setSingleShot(true);
+    batchTimer.setInterval(BATCH_DELAY);
+
+    connect(&batchTimer, &QTimer::timeout, this, &IpToLocationLITEResolver::resolvePendingIps);
+    connect(&batchWatcher, &QFutureWatcher<LocationsMap>::finished, this, &IpToLocationLITEResolver::batchResolved);
 }
 
-Location IpToLocationLITEResolver::resolve(QString ip){
-
-IP2LocationRecord *record = IP2Location_get_all(IP2LocationObj, (char*)ip.toStdString().c_str());
-
-    Location loc( QString(record->country_long), QString(record->country_short) );
-
-/*
-printf("%s %s %s %s %s %f %f %s %s %s %s %s %s %s %s %s %s %s %s %s\n",
-   record->country_short,
-   record->country_long,
-   record->region,
-   record->city,
-   record->isp,
-   record->latitude,
-   record->longitude,
-   record->domain,
-   record->zipcode,
-   record->timezone,
-   record->netspeed,
-   record->iddcode,
-   record->areacode,
-   record->weatherstationcode,
-   record->weatherstationname,
-   record->mcc,
-   record->mnc,
-   record->mobilebrand,
-   record->elevation,
-   record->usagetype);
-   */
-    IP2Location_free_record(record);
-    return loc;
+IpToLocationLITEResolver::~IpToLocationLITEResolver()
+{
+    batchTimer.stop();
+    batchWatcher.waitForFinished(); // the worker is reading the mapped database
+}
+
+QString IpToLocationLITEResolver::findDatabaseFile(const QDir &dir)
+{
+    QStringList filters("IP2LOCATION-LITE-DB*.BIN");
+    QStringList files = dir.entryList(filters, QDir::Files, QDir::Name | QDir::Reversed); // prefer the DB with more columns
+    if (files.isEmpty())
+        return QString();
+
+    return dir.absoluteFilePath(files.first());
+}
+
+Location IpToLocationLITEResolver::resolve(const QString &ip, const QString &languageCode)
+{
+    Q_UNUSED(languageCode)
+
+    LocationsMap::const_iterator it = resolvedLocations.constFind(ip);
+    if (it != resolvedLocations.constEnd())
+        return it.value();
+
+    if (!ip.isEmpty() && isValid() && !resolvingIps.contains(ip)) {
+        pendingIps.insert(ip);
+        if (!batchTimer.isActive() && !batchWatcher.isRunning())
+            batchTimer.start();
+    }
+
+    return Location(); //empty location, ipResolved will be emitted when the IP is resolved
 }
 
-IpToLocationLITEResolver::~IpToLocationLITEResolver(){
-    IP2Location_close(IP2LocationObj);
+void IpToLocationLITEResolver::resolvePendingIps()
+{
+    if (pendingIps.isEmpty() || batchWatcher.isRunning())
+        return;
+
+    QStringList ips = pendingIps.toList();
+    resolvingIps = pendingIps;
+    pendingIps.clear();
+
+    qCDebug(jtIpToLocation) << "Resolving a batch of " << ips.size() << " IPs";
+
+    batchWatcher.setFuture(QtConcurrent::run(this, &IpToLocationLITEResolver::resolveBatch, ips));
+}
+
+IpToLocationLITEResolver::LocationsMap IpToLocationLITEResolver::resolveBatch(const QStringList &ips) const
+{
+    LocationsMap locations;
+    for (const QString &ip : ips)
+        locations.insert(ip, database.lookup(ip));
+    return locations;
+}
+
+void IpToLocationLITEResolver::batchResolved()
+{
+    LocationsMap locations = batchWatcher.result();
+    resolvingIps.clear();
+
+    for (LocationsMap::const_iterator it = locations.constBegin(); it != locations.constEnd(); ++it) {
+        resolvedLocations.insert(it.key(), it.value()); // unknown locations are cached too, the database will not change
+        if (!it.value().isUnknown())
+            emit ipResolved(it.key());
+    }
+
+    if (!pendingIps.isEmpty()) // IPs requested while the last batch was running
+        batchTimer.start();
 }
@@ -2,24 +2,62 @@
 #define IPTOLOCATIONLITERESOLVER_H
 
 #include "IpToLocationResolver.h"
+#include "IP2LocationDatabase.h"
 
-#include "IP2Location.h"
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <QDir>
+#include <QFutureWatcher>
 
+namespace Geo {
 
-//class IP2Location;
-
-namespace Geo{
+/***
+  Resolve IPs using a local IP2Location LITE database (DB5 or similar). The resolve() function is
+  never blocking: unknown IPs are collected and resolved in batches in a worker thread, and the
+  ipResolved signal is emitted (in the GUI thread) for each resolved IP.
 
+  The LITE databases contain only english country names, so the language code is ignored.
+ */
 class IpToLocationLITEResolver : public IpToLocationResolver
 {
+    Q_OBJECT
+
 public:
-    IpToLocationLITEResolver(QString binFilePath);
+    explicit IpToLocationLITEResolver(const QString &databaseFilePath);
     ~IpToLocationLITEResolver();
-    Location resolve(QString ip);
+
+    Location resolve(const QString &ip, const QString &languageCode) override;
+
+    bool isValid() const;
+
+    static QString findDatabaseFile(const QDir &dir); // return an empty string if the dir not contains a LITE .BIN file
+
+private slots:
+    void resolvePendingIps();
+    void batchResolved();
+
 private:
-IP2Location* IP2LocationObj;
+    typedef QHash<QString, Location> LocationsMap;
 
+    IP2LocationDatabase database;
+
+    LocationsMap resolvedLocations;
+    QSet<QString> pendingIps; // waiting for the next batch
+    QSet<QString> resolvingIps; // in the current batch
+    QTimer batchTimer;
+    QFutureWatcher<LocationsMap> batchWatcher;
+
+    LocationsMap resolveBatch(const QStringList &ips) const; // running in a worker thread
+
+    static const int BATCH_DELAY; // in milliseconds, used to coalesce the requests
 };
 
+inline bool IpToLocationLITEResolver::isValid() const
+{
+    return database.isOpen();
 }
+
+} // namespace
+
 #endif // IPTOLOCATIONLITERESOLVER_H
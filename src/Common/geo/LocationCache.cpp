@@ -0,0 +1,168 @@
+#include "LocationCache.h"
+
+#include <QDataStream>
+#include <QSaveFile>
+#include "persistence/CacheHeader.h"
+#include "log/Logging.h"
+
+using namespace Geo;
+
+const int LocationCache::DEFAULT_MAX_ENTRIES = 10000;
+const quint32 LocationCache::CACHE_REVISION = 1;
+
+LocationCache::LocationCache(const QString &filePath, int maxEntries) :
+    file(filePath),
+    maxEntries(qMax(1, maxEntries))
+{
+    load();
+}
+
+LocationCache::~LocationCache()
+{
+    if (file.isOpen())
+        file.close();
+}
+
+LocationCache::Entry LocationCache::get(const QString &ip) const
+{
+    return entries.value(ip);
+}
+
+void LocationCache::insert(const QString &ip, const QString &countryCode, const QPointF &latLong)
+{
+    if (ip.isEmpty())
+        return;
+
+    if (entries.contains(ip)) {
+        const Entry &entry = entries[ip];
+        if (entry.countryCode == countryCode && entry.latLong == latLong)
+            return; // nothing changed, avoid a new record in the file
+    }
+    else {
+        insertionOrder.enqueue(ip);
+    }
+
+    Entry entry;
+    entry.countryCode = countryCode;
+    entry.latLong = latLong;
+    entries.insert(ip, entry);
+
+    evictOldestEntries();
+
+    if (openToAppend()) {
+        QDataStream stream(&file);
+        stream << ip << countryCode << latLong;
+        file.flush();
+    }
+}
+
+void LocationCache::evictOldestEntries()
+{
+    // only the in memory entries are evicted, the stale records in the file are dropped in the next compaction
+    while (entries.size() > maxEntries && !insertionOrder.isEmpty())
+        entries.remove(insertionOrder.dequeue());
+}
+
+bool LocationCache::openToAppend()
+{
+    if (file.isOpen())
+        return true;
+
+    bool writeHeader = !file.exists() || file.size() == 0;
+    if (!file.open(QFile::WriteOnly | QFile::Append)) {
+        qCritical() << "Can't open the file " << file.fileName() << " to append locations";
+        return false;
+    }
+
+    if (writeHeader) {
+        QDataStream stream(&file);
+        stream << CacheHeader(CACHE_REVISION);
+    }
+
+    return true;
+}
+
+void LocationCache::load()
+{
+    entries.clear();
+    insertionOrder.clear();
+
+    QFile cacheFile(file.fileName());
+    if (!cacheFile.open(QFile::ReadOnly))
+        return; // no cache file yet
+
+    QDataStream stream(&cacheFile);
+    CacheHeader cacheHeader;
+    stream >> cacheHeader;
+    if (!cacheHeader.isValid(CACHE_REVISION)) {
+        qCritical() << "Cache header is not valid in " << file.fileName();
+        cacheFile.close();
+        compact(); // discard the invalid content
+        return;
+    }
+
+    int records = 0;
+    qint64 validSize = cacheFile.pos(); // end of the last complete record
+    while (!stream.atEnd()) {
+        QString ip;
+        QString countryCode;
+        QPointF latLong;
+        stream >> ip >> countryCode >> latLong;
+        if (stream.status() != QDataStream::Ok)
+            break; // a truncated record (probably a crash while appending), the valid records are preserved
+
+        validSize = cacheFile.pos();
+
+        if (!entries.contains(ip))
+            insertionOrder.enqueue(ip);
+
+        Entry entry;
+        entry.countryCode = countryCode;
+        entry.latLong = latLong;
+        entries.insert(ip, entry);
+        records++;
+    }
+    bool truncated = stream.status() != QDataStream::Ok;
+    cacheFile.close();
+
+    evictOldestEntries();
+
+    qCDebug(jtIpToLocation) << entries.size() << " locations loaded from " << file.fileName() << "(" << records << " records)";
+
+    if (truncated) {
+        // the new records are appended after the last complete record, not after the truncated bytes
+        qCWarning(jtIpToLocation) << "Truncated record discarded in " << file.fileName();
+        if (!QFile::resize(file.fileName(), validSize)) {
+            compact();
+            return;
+        }
+    }
+
+    // rewrite the file only when more than half of the records are stale
+    if (records > entries.size() * 2)
+        compact();
+}
+
+void LocationCache::compact()
+{
+    if (file.isOpen())
+        file.close();
+
+    QSaveFile saveFile(file.fileName()); // the old file is replaced only if everything was written
+    if (!saveFile.open(QFile::WriteOnly)) {
+        qCritical() << "Can't compact the locations cache file " << file.fileName();
+        return;
+    }
+
+    QDataStream stream(&saveFile);
+    stream << CacheHeader(CACHE_REVISION);
+    for (const QString &ip : insertionOrder) {
+        const Entry &entry = entries[ip];
+        stream << ip << entry.countryCode << entry.latLong;
+    }
+
+    if (saveFile.commit())
+        qCDebug(jtIpToLocation) << "Locations cache compacted, " << entries.size() << " locations stored in " << file.fileName();
+    else
+        qCritical() << "Error compacting the locations cache file " << file.fileName();
+}
@@ -0,0 +1,70 @@
+#ifndef LOCATIONCACHE_H
+#define LOCATIONCACHE_H
+
+#include <QString>
+#include <QHash>
+#include <QQueue>
+#include <QPointF>
+#include <QFile>
+
+namespace Geo {
+
+/***
+  Persistent IP => (country code, latitude/longitude) cache. New entries are appended to the end of
+  the cache file as soon as they are resolved (nothing is lost if Jamtaba crashes), and the file is
+  compacted only when loading, if it contains too many stale/duplicated records. The number of
+  cached IPs is bounded, the oldest IPs are evicted first.
+ */
+class LocationCache
+{
+public:
+    struct Entry
+    {
+        QString countryCode;
+        QPointF latLong;
+    };
+
+    explicit LocationCache(const QString &filePath, int maxEntries = DEFAULT_MAX_ENTRIES);
+    ~LocationCache();
+
+    bool contains(const QString &ip) const;
+    Entry get(const QString &ip) const;
+    void insert(const QString &ip, const QString &countryCode, const QPointF &latLong);
+
+    int size() const;
+    bool isEmpty() const;
+
+    static const int DEFAULT_MAX_ENTRIES;
+
+private:
+    QFile file;
+    int maxEntries;
+    QHash<QString, Entry> entries;
+    QQueue<QString> insertionOrder; // used to evict the oldest IPs first
+
+    void load();
+    void compact();
+    bool openToAppend();
+    void evictOldestEntries();
+
+    static const quint32 CACHE_REVISION;
+};
+
+inline bool LocationCache::contains(const QString &ip) const
+{
+    return entries.contains(ip);
+}
+
+inline int LocationCache::size() const
+{
+    return entries.size();
+}
+
+inline bool LocationCache::isEmpty() const
+{
+    return entries.isEmpty();
+}
+
+} // namespace
+
+#endif // LOCATIONCACHE_H
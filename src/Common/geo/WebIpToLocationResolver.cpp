@@ -18,22 +18,23 @@
 
 using namespace Geo;
 
-const QString WebIpToLocationResolver::COUNTRY_CODES_FILE = "country_codes_cache.bin";
+const QString WebIpToLocationResolver::LOCATIONS_CACHE_FILE = "locations_cache.bin";
 const QString WebIpToLocationResolver::COUNTRY_NAMES_FILE_PREFIX = "country_names_cache"; //the language code will be concatenated
-const QString WebIpToLocationResolver::LAT_LONG_CACHE_FILE = "lat_long_cache.bin";
+const QString WebIpToLocationResolver::OLD_COUNTRY_CODES_FILE = "country_codes_cache.bin";
+const QString WebIpToLocationResolver::OLD_LAT_LONG_CACHE_FILE = "lat_long_cache.bin";
 
 const quint32 WebIpToLocationResolver::COUNTRY_NAMES_CACHE_REVISION = 1;
-const quint32 WebIpToLocationResolver::COUNTRY_CODES_CACHE_REVISION = 1;
-const quint32 WebIpToLocationResolver::LAT_LONG_CACHE_REVISION = 1;
+const quint32 WebIpToLocationResolver::OLD_COUNTRY_CODES_CACHE_REVISION = 1;
+const quint32 WebIpToLocationResolver::OLD_LAT_LONG_CACHE_REVISION = 1;
 
 WebIpToLocationResolver::WebIpToLocationResolver(const QDir &cacheDir)
-    :currentLanguage("en"), //using english as default language
+    :locationsCache(cacheDir.absoluteFilePath(LOCATIONS_CACHE_FILE)),
+     currentLanguage("en"), //using english as default language
      cacheDir(cacheDir)
 {
     QObject::connect(&httpClient, SIGNAL(finished(QNetworkReply*)), this, SLOT(replyFinished(QNetworkReply*)));
 
-    loadCountryCodesFromFile();
-    loadLatLongsFromFile();
+    importOldLocationCacheFiles();
 
     if (!needLoadTheOldCache()) {
         loadCountryNamesFromFile(currentLanguage); //loading the english country names by default
@@ -46,22 +47,7 @@ WebIpToLocationResolver::WebIpToLocationResolver(const QDir &cacheDir)
 
 WebIpToLocationResolver::~WebIpToLocationResolver()
 {
-    saveCountryCodesToFile();
-    saveCountryNamesToFile();
-    saveLatLongsToFile();
-}
-
-void WebIpToLocationResolver::saveLatLongsToFile()
-{
-    if (latLongCache.isEmpty())
-        return;
-
-    QString filename = LAT_LONG_CACHE_FILE;
-    quint32 cacheRevision = LAT_LONG_CACHE_REVISION;
-    if (saveMapToFile(filename, latLongCache, cacheRevision))
-        qCDebug(jtIpToLocation) << latLongCache.size() << " lat,lng pairs stored in " << filename;
-    else
-        qCritical() << "Can't save lat,lng pairs in the file " << filename;
+    saveCountryNamesToFile(); // the locations are appended in the cache file when received, only the country names are saved here
 }
 
 void WebIpToLocationResolver::saveCountryNamesToFile()
@@ -74,32 +60,6 @@ void WebIpToLocationResolver::saveCountryNamesToFile()
         qCritical() << "Can't save country names in the file " << filename;
 }
 
-void WebIpToLocationResolver::saveCountryCodesToFile()
-{
-    quint32 cacheRevision = COUNTRY_CODES_CACHE_REVISION;
-    if (saveMapToFile(COUNTRY_CODES_FILE, countryCodesCache, cacheRevision))
-        qCDebug(jtIpToLocation) << countryCodesCache.size() << " country codes stored in " << COUNTRY_CODES_FILE;
-    else
-        qCritical() << "Can't save country codes in the file " << COUNTRY_CODES_FILE;
-}
-
-bool WebIpToLocationResolver::saveMapToFile(const QString &fileName, const QMap<QString, QPointF> &map, quint32 cacheHeaderRevision)
-{
-    if (map.isEmpty())
-        return true;
-
-    QFile cacheFile(cacheDir.absoluteFilePath(fileName));
-    if(cacheFile.open(QFile::WriteOnly)){
-        QDataStream stream(&cacheFile);
-        CacheHeader cacheHeader(cacheHeaderRevision);
-        stream << cacheHeader;
-        stream << map;
-        return true;
-    }
-    return false;
-}
-
-
 bool WebIpToLocationResolver::saveMapToFile(const QString &fileName, const QMap<QString, QString> &map, quint32 cacheHeaderRevision)
 {
     if (map.isEmpty())
@@ -120,8 +80,12 @@ void WebIpToLocationResolver::replyFinished(QNetworkReply *reply){
     QString ip = reply->property("ip").toString();
     QString language = reply->property("language").toString();
 
-    if (language != currentLanguage)
+    pendingRequests.remove(ip);
+
+    if (language != currentLanguage) {
+        reply->deleteLater();
         return; //discard the received data if the language was changed since the last request.
+    }
 
     if(reply->error() == QNetworkReply::NoError ){
         QJsonDocument doc = QJsonDocument::fromJson(reply->readAll());
@@ -139,14 +103,13 @@ void WebIpToLocationResolver::replyFinished(QNetworkReply *reply){
         if (countryObject.contains("name") && countryObject.contains("code")) {
             QString countryName = countryObject["name"].toString();
             QString countryCode = countryObject["code"].toString();
-            countryCodesCache.insert(ip, countryCode);
             countryNamesCache.insert(countryCode, countryName);
             if (root.contains("location")) {
                 QJsonObject locationObject = root["location"].toObject();
                 if (locationObject.contains("latitude") && locationObject.contains("longitude")) {
                     double latitude = locationObject["latitude"].toDouble();
                     double longitude = locationObject["longitude"].toDouble();
-                    latLongCache.insert(ip, QPointF(latitude, longitude));
+                    locationsCache.insert(ip, countryCode, QPointF(latitude, longitude));
                     qCDebug(jtIpToLocation) << "Data received IP:" << ip << " Lang:" << language << " country code:" << countryCode << " country name:" << countryName << "lat:" << latitude << " long:" << longitude;
                 }
                 else{
@@ -171,8 +134,13 @@ void WebIpToLocationResolver::replyFinished(QNetworkReply *reply){
 
 // At moment the current api is geoip.nekudo.com. Another option is https://freegeoip.net/json/
 void WebIpToLocationResolver::requestDataFromWebService(const QString &ip){
+    if (pendingRequests.contains(ip))
+        return; // already waiting for this IP
+
     qCDebug(jtIpToLocation) << "requesting ip " << ip ;
 
+    pendingRequests.insert(ip);
+
     QNetworkRequest request;
     QString serviceUrl = "http://geoip.nekudo.com/api/";
 
@@ -223,15 +191,13 @@ Geo::Location WebIpToLocationResolver::resolve(const QString &ip, const QString
         loadCountryNamesFromFile(currentLanguage); //update the country names QMap
     }
 
-    if (countryCodesCache.contains(ip)) {
-        QString countryCode = countryCodesCache[ip];
-        if (countryNamesCache.contains(countryCode)) {
-            QString countryName = countryNamesCache[countryCode];
-            if (latLongCache.contains(ip)) {
-                qreal latitude = latLongCache[ip].x();
-                qreal longitude = latLongCache[ip].y();
-                return Location(countryName, countryCode, latitude, longitude);
-            }
+    if (locationsCache.contains(ip)) {
+        LocationCache::Entry entry = locationsCache.get(ip);
+        if (countryNamesCache.contains(entry.countryCode)) {
+            QString countryName = countryNamesCache[entry.countryCode];
+            qreal latitude = entry.latLong.x();
+            qreal longitude = entry.latLong.y();
+            return Location(countryName, entry.countryCode, latitude, longitude);
         }
     }
 
@@ -246,20 +212,6 @@ QString WebIpToLocationResolver::buildFileNameFromLanguage(const QString &langua
    return COUNTRY_NAMES_FILE_PREFIX + "_" + languageCode + ".bin";
 }
 
-void WebIpToLocationResolver::loadLatLongsFromFile()
-{
-    QString fileName = LAT_LONG_CACHE_FILE;
-    quint32 expectedCacheHeaderRevision = LAT_LONG_CACHE_REVISION;
-    if (populateQMapFromFile(fileName, latLongCache, expectedCacheHeaderRevision)){
-        qCDebug(jtIpToLocation) << latLongCache.size() << " lat,long pairs loaded in cache";
-    }
-    else
-    {
-        qCritical() << "Can't open the file " << fileName;
-    }
-}
-
-
 void WebIpToLocationResolver::loadCountryNamesFromFile(const QString &languageCode)
 {
     QString fileName = buildFileNameFromLanguage(languageCode);
@@ -273,13 +225,26 @@ void WebIpToLocationResolver::loadCountryNamesFromFile(const QString &languageCo
     }
 }
 
-void WebIpToLocationResolver::loadCountryCodesFromFile()
+void WebIpToLocationResolver::importOldLocationCacheFiles()
 {
-    quint32 expectedCacheHeaderRevision = COUNTRY_CODES_CACHE_REVISION;
-    if (populateQMapFromFile(COUNTRY_CODES_FILE, countryCodesCache, expectedCacheHeaderRevision))
-        qCDebug(jtIpToLocation) << countryCodesCache.size() << " cached country codes loaded from file!";
-    else
-        qCritical() << "Can't open the file " << COUNTRY_CODES_FILE;
+    //import the content of the old country codes and lat,long cache files. This code will be deleted in future versions
+    if (!cacheDir.exists(OLD_COUNTRY_CODES_FILE) && !cacheDir.exists(OLD_LAT_LONG_CACHE_FILE))
+        return;
+
+    QMap<QString, QString> countryCodes;
+    QMap<QString, QPointF> latLongs;
+    populateQMapFromFile(OLD_COUNTRY_CODES_FILE, countryCodes, OLD_COUNTRY_CODES_CACHE_REVISION);
+    populateQMapFromFile(OLD_LAT_LONG_CACHE_FILE, latLongs, OLD_LAT_LONG_CACHE_REVISION);
+
+    for (const QString &ip : countryCodes.keys()) {
+        if (latLongs.contains(ip) && !locationsCache.contains(ip))
+            locationsCache.insert(ip, countryCodes[ip], latLongs[ip]);
+    }
+
+    qCDebug(jtIpToLocation) << locationsCache.size() << " locations imported from the old cache files";
+
+    cacheDir.remove(OLD_COUNTRY_CODES_FILE);
+    cacheDir.remove(OLD_LAT_LONG_CACHE_FILE);
 }
 
 bool WebIpToLocationResolver::populateQMapFromFile(const QString &fileName, QMap<QString, QString> &map, quint32 expectedCacheHeaderRevision)
@@ -336,8 +301,7 @@ void WebIpToLocationResolver::loadOldCacheContent()
                     QString ip = parts.at(0);
                     QString countryName = (parts.size() >= 1) ? parts.at(1) : "";
                     QString countryCode = (parts.size() >= 2) ? parts.at(2) : "";
-                    countryCodesCache.insert(ip, countryCode);
-                    countryNamesCache.insert(countryCode, countryName);
+                    countryNamesCache.insert(countryCode, countryName); // the old cache has no lat,long pairs, the IPs will be requested again
                 }
             }
         }
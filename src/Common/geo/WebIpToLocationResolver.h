@@ -2,7 +2,9 @@
 #define FREEGEOIPTOLOCATIONRESOLVER_H
 
 #include "IpToLocationResolver.h"
+#include "LocationCache.h"
 #include <QMap>
+#include <QSet>
 #include <QLoggingCategory>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
@@ -19,17 +21,15 @@ public:
     ~WebIpToLocationResolver();
     Geo::Location resolve(const QString &ip, const QString &languageCode) override;
 private:
-    QMap<QString, QString> countryCodesCache; // IP -> country code (2 upper case letters)
+    LocationCache locationsCache; // IP => country code (2 upper case letters) and QPointF(latitude, longitude)
     QMap<QString, QString> countryNamesCache;// country code => translated country name
-    QMap<QString, QPointF> latLongCache; // IP => QPointF(latitude, longitude)
+    QSet<QString> pendingRequests; // IPs waiting for a web service reply, avoid requesting the same IP many times
     QNetworkAccessManager httpClient;
 
     void requestDataFromWebService(const QString &ip);
 
     //loading
-    void loadCountryCodesFromFile();
     void loadCountryNamesFromFile(const QString &languageCode);
-    void loadLatLongsFromFile();
     bool populateQMapFromFile(const QString &fileName, QMap<QString, QString> &map, quint32 expectedCacheHeaderRevision);
     bool populateQMapFromFile(const QString &fileName, QMap<QString, QPointF> &map, quint32 expectedCacheHeaderRevision);
 
@@ -37,12 +37,11 @@ private:
     void loadOldCacheContent(); //these functions are used to handle the old 'cache.bin' content used until the version 2.0.13. This will be deleted in future.
     void deleteOldCacheFile();
 
+    void importOldLocationCacheFiles(); // country codes and lat,long pairs were stored in separated files until the version 2.0.19
+
     //saving
-    void saveCountryCodesToFile();
     void saveCountryNamesToFile();
-    void saveLatLongsToFile();
     bool saveMapToFile(const QString &fileName, const QMap<QString, QString> &map, quint32 cacheHeaderRevision);
-    bool saveMapToFile(const QString &fileName, const QMap<QString, QPointF> &map, quint32 cacheHeaderRevision);
 
     static QString buildFileNameFromLanguage(const QString &languageCode);
     static QString sanitizeLanguageCode(const QString &languageCode);
@@ -53,13 +52,14 @@ private:
 
     QDir cacheDir;
 
-    static const QString COUNTRY_CODES_FILE;
+    static const QString LOCATIONS_CACHE_FILE;
     static const QString COUNTRY_NAMES_FILE_PREFIX;
-    static const QString LAT_LONG_CACHE_FILE;
+    static const QString OLD_COUNTRY_CODES_FILE;
+    static const QString OLD_LAT_LONG_CACHE_FILE;
 
-    static const quint32 COUNTRY_CODES_CACHE_REVISION;
     static const quint32 COUNTRY_NAMES_CACHE_REVISION;
-    static const quint32 LAT_LONG_CACHE_REVISION;
+    static const quint32 OLD_COUNTRY_CODES_CACHE_REVISION;
+    static const quint32 OLD_LAT_LONG_CACHE_REVISION;
 
 private slots:
     void replyFinished(QNetworkReply *);
@@ -10,7 +10,8 @@
 #include "MapMarker.h"
 
 JamRoomViewPanel::JamRoomViewPanel(const Login::RoomInfo &roomInfo,
-                                   Controller::MainController *mainController) :
+                                   Controller::MainController *mainController,
+                                   ResolvedLocations &resolvedLocations) :
     QFrame(nullptr),
     ui(new Ui::RoomViewPanel),
     mainController(mainController),
@@ -42,7 +43,7 @@ JamRoomViewPanel::JamRoomViewPanel(const Login::RoomInfo &roomInfo,
     WavePeakPanel::WaveDrawingMode lastDrawingMode = static_cast<WavePeakPanel::WaveDrawingMode>(mainController->getLastWaveDrawingMode());
     setWaveDrawingMode(lastDrawingMode);
 
-    initialize(roomInfo);
+    initialize(roomInfo, resolvedLocations);
 }
 
 void JamRoomViewPanel::setWaveDrawingButtonsVisibility(bool showButtons)
@@ -116,10 +117,10 @@ void JamRoomViewPanel::createMapWidgets()
 
 void JamRoomViewPanel::updateUserLocation(const QString &userIP)
 {
-    Q_UNUSED(userIP)
     for (const Login::UserInfo &user : roomInfo.getUsers()) {
         if (user.getIp() == userIP) {
-            updateMap();
+            ResolvedLocations resolvedLocations;
+            updateMap(resolvedLocations);
             update();
             break;
         }
@@ -160,7 +161,27 @@ QString JamRoomViewPanel::buildRoomDescriptionString()
     return roomDescription;
 }
 
-void JamRoomViewPanel::updateMap()
+QImage JamRoomViewPanel::getCountryFlag(const QString &countryCode)
+{
+    static QHash<QString, QImage> flags; // flags are decoded once, not in every public rooms refresh
+
+    auto it = flags.find(countryCode);
+    if (it == flags.end())
+        it = flags.insert(countryCode, QImage(":/flags/flags/" + countryCode.toLower() + ".png"));
+
+    return it.value();
+}
+
+Geo::Location JamRoomViewPanel::getUserLocation(const QString &userIp, ResolvedLocations &resolvedLocations)
+{
+    auto it = resolvedLocations.find(userIp);
+    if (it == resolvedLocations.end())
+        it = resolvedLocations.insert(userIp, mainController->getGeoLocation(userIp));
+
+    return it.value();
+}
+
+void JamRoomViewPanel::updateMap(ResolvedLocations &resolvedLocations)
 {
     if (!roomInfo.isEmpty()) {
         QList<Login::UserInfo> userInfos = roomInfo.getUsers();
@@ -168,25 +189,24 @@ void JamRoomViewPanel::updateMap()
         QList<MapMarker> newMarkers;
         foreach (const Login::UserInfo &user, userInfos) {
             if (!userIsBot(user)) {
-                Geo::Location userLocation = mainController->getGeoLocation(user.getIp());
+                Geo::Location userLocation = getUserLocation(user.getIp(), resolvedLocations);
                 if (userLocation.isUnknown())
                     continue; // skip invalid locations
 
                 QPointF latLong(userLocation.getLatitude(), userLocation.getLongitude());
-                QPixmap flag(":/flags/flags/" + userLocation.getCountryCode().toLower() + ".png");
-                MapMarker marker(user.getName(), userLocation.getCountryName(), latLong, flag.toImage());
+                MapMarker marker(user.getName(), userLocation.getCountryName(), latLong, getCountryFlag(userLocation.getCountryCode()));
                 newMarkers.append(marker);
             }
         }
 
-        map->setMarkers(newMarkers);
+        map->setMarkers(newMarkers); // the markers layout is not recomputed if the markers are unchanged
     }
 
     map->setVisible(!roomInfo.isEmpty());
     map->update();
 }
 
-void JamRoomViewPanel::refresh(const Login::RoomInfo &roomInfo)
+void JamRoomViewPanel::refresh(const Login::RoomInfo &roomInfo, ResolvedLocations &resolvedLocations)
 {
     this->roomInfo = roomInfo;
 
@@ -196,7 +216,7 @@ void JamRoomViewPanel::refresh(const Login::RoomInfo &roomInfo)
 
     ui->buttonEnter->setEnabled(!roomInfo.isFull());
 
-    updateMap();
+    updateMap(resolvedLocations);
 
     setProperty("empty", roomInfo.isEmpty());
 
@@ -277,7 +297,7 @@ bool JamRoomViewPanel::canShowNinjamServerPort(const QString &serverName)
     return serverName.startsWith("ninbot") || serverName.startsWith("ninjamer");
 }
 
-void JamRoomViewPanel::initialize(const Login::RoomInfo &roomInfo)
+void JamRoomViewPanel::initialize(const Login::RoomInfo &roomInfo, ResolvedLocations &resolvedLocations)
 {
     QString roomName = roomInfo.getName();
     if (roomName.endsWith(".com"))
@@ -286,7 +306,7 @@ void JamRoomViewPanel::initialize(const Login::RoomInfo &roomInfo)
     if (roomInfo.getType() == Login::RoomTYPE::NINJAM && canShowNinjamServerPort(roomName))
         roomName += " (" + QString::number(roomInfo.getPort()) + ")";
     ui->labelName->setText(roomName);
-    refresh(roomInfo);
+    refresh(roomInfo, resolvedLocations);
 }
 
 JamRoomViewPanel::~JamRoomViewPanel()
@@ -4,6 +4,7 @@
 #include <QFrame>
 #include <QLabel>
 #include <QPushButton>
+#include <QHash>
 #include "ninjam/Server.h"
 #include "loginserver/LoginService.h"
 #include "WavePeakPanel.h"
@@ -32,11 +33,14 @@ class JamRoomViewPanel : public QFrame
     Q_OBJECT
 
 public:
-    JamRoomViewPanel(const Login::RoomInfo &roomInfo, Controller::MainController *mainController);
+    // locations resolved while refreshing the public rooms list, each user IP is resolved just once for all rooms
+    typedef QHash<QString, Geo::Location> ResolvedLocations;
+
+    JamRoomViewPanel(const Login::RoomInfo &roomInfo, Controller::MainController *mainController, ResolvedLocations &resolvedLocations);
     ~JamRoomViewPanel();
     void addPeak(float peak);
     void clear(bool resetListenButton);
-    void refresh(const Login::RoomInfo &roomInfo);
+    void refresh(const Login::RoomInfo &roomInfo, ResolvedLocations &resolvedLocations);
 
     void setShowBufferingState(bool showBuffering);
     void setBufferingPercentage(int percentage);
@@ -71,7 +75,7 @@ private:
     QLayout *createWaveDrawingButtons();
     void setWaveDrawingButtonsVisibility(bool showButtons);
 
-     void initialize(const Login::RoomInfo &roomInfo);
+     void initialize(const Login::RoomInfo &roomInfo, ResolvedLocations &resolvedLocations);
      bool roomContainsBotsOnly(const Login::RoomInfo &roomInfo);
      bool userIsBot(const Login::UserInfo &userInfo);
      void updateButtonListen();
@@ -82,7 +86,10 @@ private:
      void translateUi();
      void updateStyleSheet();
      void createMapWidgets();
-     void updateMap();
+     void updateMap(ResolvedLocations &resolvedLocations);
+     Geo::Location getUserLocation(const QString &userIp, ResolvedLocations &resolvedLocations);
+
+     static QImage getCountryFlag(const QString &countryCode);
 
      bool static canShowNinjamServerPort(const QString &serverName);
  };
@@ -18,6 +18,7 @@
 #include <QDesktopServices>
 #include <QRect>
 #include <QDateTime>
+#include <QFileDialog>
 #include "MainController.h"
 #include "ThemeLoader.h"
 #include "performance/PerformanceMonitor.h"
@@ -34,7 +35,7 @@ const QString MainWindow::NIGHT_MODE_SUFFIX = "_nm";
 const quint8 MainWindow::DEFAULT_REFRESH_RATE = 30; // in Hertz
 const quint8 MainWindow::MAX_REFRESH_RATE = 60; // in Hertz
 
-const int MainWindow::PERFORMANCE_MONITOR_REFRESH_TIME = 200;//in miliseconds
+const int MainWindow::PERFORMANCE_MONITOR_REFRESH_TIME = 1000;//in miliseconds
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 MainWindow::MainWindow(Controller::MainController *mainController, QWidget *parent) :
@@ -44,7 +45,9 @@ MainWindow::MainWindow(Controller::MainController *mainController, QWidget *pare
     ninjamWindow(nullptr),
     roomToJump(nullptr),
     chordsPanel(nullptr),
-    lastPerformanceMonitorUpdate(0)
+    lastPerformanceMonitorUpdate(0),
+    lastSavedProcessingTime(0),
+    lastAudioCallbackStatistics()
 {
     qCDebug(jtGUI) << "Creating MainWindow...";
 
@@ -107,6 +110,14 @@ void MainWindow::setLanguage(QAction *languageMenuAction)
     }
 }
 
+void MainWindow::updateGeoLocations()
+{
+    /** updating country flags and country names when an IP is resolved. The IPs are resolved asynchronously, so
+        if the country code and name are not cached we receive these data some seconds after entering in the room.*/
+    if (mainController->isPlayingInNinjamRoom() && ninjamWindow)
+        ninjamWindow->updateGeoLocations();
+}
+
 void MainWindow::updateNightModeInWorldMaps()
 {
     QString themeName = mainController->getTheme();
@@ -520,8 +531,7 @@ void MainWindow::initializeLoginService()
 {
     Login::LoginService *loginService = this->mainController->getLoginService();
 
-    connect(loginService, SIGNAL(roomsListAvailable(QList<Login::RoomInfo>)), this,
-            SLOT(refreshPublicRoomsList(const QList<Login::RoomInfo> &)));
+    connect(loginService, &Login::LoginService::roomsListChanged, this, &MainWindow::updatePublicRoomsList);
 
     connect(loginService, SIGNAL(incompatibilityWithServerDetected()), this,
             SLOT(handleIncompatiblity()));
@@ -619,9 +629,9 @@ void MainWindow::showNewVersionAvailableMessage()
     QMessageBox::information(this, tr("New Jamtaba version available!"), text);
 }
 
-JamRoomViewPanel *MainWindow::createJamRoomViewPanel(const Login::RoomInfo &roomInfo)
+JamRoomViewPanel *MainWindow::createJamRoomViewPanel(const Login::RoomInfo &roomInfo, JamRoomViewPanel::ResolvedLocations &resolvedLocations)
 {
-    JamRoomViewPanel *newJamRoomView = new JamRoomViewPanel(roomInfo, mainController);
+    JamRoomViewPanel *newJamRoomView = new JamRoomViewPanel(roomInfo, mainController, resolvedLocations);
 
     connect(newJamRoomView, SIGNAL(startingListeningTheRoom(Login::RoomInfo)), this,
             SLOT(playPublicRoomStream(Login::RoomInfo)));
@@ -640,45 +650,88 @@ bool MainWindow::canUseTwoColumnLayout() const
     return ui.contentTabWidget->width() >= 860;
 }
 
-void MainWindow::refreshPublicRoomsList(const QList<Login::RoomInfo> &publicRooms)
+void MainWindow::updatePublicRoomsList(const Login::RoomsListChanges &changes)
 {
-    if (publicRooms.isEmpty())
-        return;
-
     hideBusyDialog();
 
-    QList<Login::RoomInfo> sortedRooms(publicRooms);
-    qSort(sortedRooms.begin(), sortedRooms.end(), jamRoomLessThan);
+    JamRoomViewPanel::ResolvedLocations resolvedLocations; // each user IP is resolved once for all rooms
+    bool roomsAddedOrRemoved = false;
 
-    int index = 0;
-    bool twoCollumns = canUseTwoColumnLayout();
-    foreach (const Login::RoomInfo &roomInfo, sortedRooms) {
-        if (roomInfo.getType() == Login::RoomTYPE::NINJAM) {// skipping other rooms at moment
-            int rowIndex = twoCollumns ? (index / 2) : (index);
-            int collumnIndex = twoCollumns ? (index % 2) : 0;
-            JamRoomViewPanel *roomViewPanel = roomViewPanels[roomInfo.getID()];
-            if (roomViewPanel) {
-                roomViewPanel->refresh(roomInfo);
-                // check if is playing a public room stream but this room is empty now
-                if (mainController->isPlayingRoomStream()) {
-                    if (roomInfo.isEmpty()
-                        && mainController->getCurrentStreamingRoomID() == roomInfo.getID())
-                        stopCurrentRoomStream();
-                }
-                ui.allRoomsContent->layout()->removeWidget(roomViewPanel); // the widget is removed but added again
-            } else {
-                roomViewPanel = createJamRoomViewPanel(roomInfo);
-                roomViewPanels.insert(roomInfo.getID(), roomViewPanel);
+    for (long long roomID : changes.getRemovedRooms()) {
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.take(roomID);
+        if (!roomViewPanel)
+            continue;
+
+        if (mainController->isPlayingRoomStream() && mainController->getCurrentStreamingRoomID() == roomID)
+            stopCurrentRoomStream();
+
+        ui.allRoomsContent->layout()->removeWidget(roomViewPanel);
+        roomViewPanel->deleteLater();
+        roomsAddedOrRemoved = true;
+    }
+
+    // only the changed rooms are refreshed
+    QList<Login::RoomInfo> changedRooms(changes.getUpdatedRooms());
+    changedRooms.append(changes.getAddedRooms());
+    for (const Login::RoomInfo &roomInfo : changedRooms) {
+        if (roomInfo.getType() != Login::RoomTYPE::NINJAM)
+            continue; // skipping other rooms at moment
+
+        JamRoomViewPanel *roomViewPanel = roomViewPanels.value(roomInfo.getID(), nullptr);
+        if (roomViewPanel) {
+            roomViewPanel->refresh(roomInfo, resolvedLocations);
+            // check if is playing a public room stream but this room is empty now
+            if (mainController->isPlayingRoomStream()) {
+                if (roomInfo.isEmpty()
+                    && mainController->getCurrentStreamingRoomID() == roomInfo.getID())
+                    stopCurrentRoomStream();
             }
-            QGridLayout *layout = dynamic_cast<QGridLayout *>(ui.allRoomsContent->layout());
-            layout->addWidget(roomViewPanel, rowIndex, collumnIndex);
-            index++;
+        } else {
+            roomViewPanel = createJamRoomViewPanel(roomInfo, resolvedLocations);
+            roomViewPanels.insert(roomInfo.getID(), roomViewPanel);
+            roomsAddedOrRemoved = true;
         }
     }
 
-    if (mainController->isPlayingInNinjamRoom())
-        this->ninjamWindow->updateGeoLocations();
-    /** updating country flag and country names after refresh the public rooms list. This is necessary because the call to webservice used to get country codes and  country names is not synchronous. So, if country code and name are not cached we receive these data from the webservice after some seconds.*/
+    // the rooms are sorted by users count, the panels are moved only when the order is changed
+    QList<long long> sortedRooms = getSortedPublicRooms();
+    if (roomsAddedOrRemoved || sortedRooms != publicRoomsOrder)
+        layoutPublicRooms(sortedRooms);
+}
+
+QList<long long> MainWindow::getSortedPublicRooms() const
+{
+    QList<Login::RoomInfo> rooms;
+    for (JamRoomViewPanel *roomViewPanel : roomViewPanels) {
+        if (roomViewPanel)
+            rooms.append(roomViewPanel->getRoomInfo());
+    }
+
+    qStableSort(rooms.begin(), rooms.end(), jamRoomLessThan); // stable sort, rooms with same users count are not swapped in each refresh
+
+    QList<long long> sortedRooms;
+    for (const Login::RoomInfo &roomInfo : rooms)
+        sortedRooms.append(roomInfo.getID());
+
+    return sortedRooms;
+}
+
+void MainWindow::layoutPublicRooms(const QList<long long> &sortedRooms)
+{
+    QGridLayout *layout = dynamic_cast<QGridLayout *>(ui.allRoomsContent->layout());
+    for (long long roomID : sortedRooms)
+        layout->removeWidget(roomViewPanels[roomID]); // the widgets are removed but added again
+
+    int index = 0;
+    bool twoCollumns = canUseTwoColumnLayout();
+    for (long long roomID : sortedRooms) {
+        int rowIndex = twoCollumns ? (index / 2) : (index);
+        int collumnIndex = twoCollumns ? (index % 2) : 0;
+        layout->addWidget(roomViewPanels[roomID], rowIndex, collumnIndex);
+        index++;
+    }
+
+    publicRoomsOrder = sortedRooms;
 }
 
 // +++++++++++++++++++++++++++++++++++++
@@ -926,10 +979,30 @@ void MainWindow::timerEvent(QTimerEvent *)
             ninjamWindow->updatePeaks();
     }
 
-    // update cpu and memmory usage
+    // update cpu, dsp and memmory usage
     qint64 now = QDateTime::currentMSecsSinceEpoch();
     if (now - lastPerformanceMonitorUpdate >= PERFORMANCE_MONITOR_REFRESH_TIME) {
-        ui.contentTabWidget->setResourcesUsage(performanceMonitor.getMemmoryUsed());
+        // processing time saved by sleeping plugins in the last period, the counter is wrapping around
+        quint32 savedProcessingTime = Audio::AudioNode::getSavedProcessingTime();
+        quint32 savedMicroseconds = savedProcessingTime - lastSavedProcessingTime;
+        double savedCpuUsage = 0;
+        if (lastPerformanceMonitorUpdate > 0)
+            savedCpuUsage = savedMicroseconds / ((now - lastPerformanceMonitorUpdate) * 1000.0) * 100.0;
+        lastSavedProcessingTime = savedProcessingTime;
+
+        AudioCallbackStatistics::Snapshot audioCallbackStatistics = mainController->getAudioCallbackStatistics().getSnapshot();
+
+        PerformanceHistory::Sample usage;
+        usage.timestamp = now;
+        usage.cpuUsage = performanceMonitor.getCpuUsage();
+        usage.memoryUsage = performanceMonitor.getMemmoryUsed();
+        usage.residentMemory = performanceMonitor.getResidentMemory();
+        usage.dspLoad = audioCallbackStatistics.getDspLoad(lastAudioCallbackStatistics);
+        usage.xruns = audioCallbackStatistics.getXruns();
+        lastAudioCallbackStatistics = audioCallbackStatistics;
+
+        performanceHistory.add(usage);
+        ui.contentTabWidget->setResourcesUsage(usage, savedCpuUsage);
         lastPerformanceMonitorUpdate = now;
     }
 
@@ -1038,6 +1111,18 @@ void MainWindow::showJamtabaIssuesWebPage()
     openUrlInUserBrowser("https://github.com/elieserdejesus/JamTaba/issues");
 }
 
+void MainWindow::exportPerformanceHistory()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, tr("Export performance history"),
+                                                    QDir::home().absoluteFilePath("jamtaba-performance.csv"),
+                                                    tr("CSV files (*.csv)"));
+    if (filePath.isEmpty())
+        return; // canceled
+
+    if (!performanceHistory.exportToCsv(filePath))
+        QMessageBox::warning(this, tr("Performance history"), tr("Can't write the file %1").arg(filePath));
+}
+
 void MainWindow::showJamtabaWikiWebPage()
 {
     openUrlInUserBrowser("https://github.com/elieserdejesus/JamTaba/wiki");
@@ -1230,12 +1315,13 @@ void MainWindow::updateMeteringMenu()
 
 void MainWindow::updatePublicRoomsListLayout()
 {
-    QList<Login::RoomInfo> roomInfos;
-
-    for (JamRoomViewPanel *roomView: roomViewPanels)
-        roomInfos.append(roomView->getRoomInfo());
+    JamRoomViewPanel::ResolvedLocations resolvedLocations;
+    for (JamRoomViewPanel *roomView: roomViewPanels) {
+        if (roomView)
+            roomView->refresh(roomView->getRoomInfo(), resolvedLocations); // country names are translated
+    }
 
-    refreshPublicRoomsList(roomInfos);
+    layoutPublicRooms(getSortedPublicRooms());
 }
 
 QSize MainWindow::getSanitizedWindowSize(const QSize &size, const QSize &minimumSize) const
@@ -1534,6 +1620,8 @@ void MainWindow::setupSignals()
 
     connect(ui.actionTranslators, SIGNAL(triggered(bool)), this, SLOT(showJamtabaTranslators()));
 
+    connect(ui.actionExportPerformanceHistory, SIGNAL(triggered(bool)), this, SLOT(exportPerformanceHistory()));
+
     connect(ui.actionCurrentVersion, SIGNAL(triggered(bool)), this,
             SLOT(showJamtabaCurrentVersion()));
 
@@ -1554,6 +1642,8 @@ void MainWindow::setupSignals()
 
     connect(mainController, &Controller::MainController::themeChanged, this, &MainWindow::updateNightModeInWorldMaps);
 
+    connect(mainController, &Controller::MainController::ipResolved, this, &MainWindow::updateGeoLocations);
+
     ui.contentTabWidget->installEventFilter(this);
 }
 
@@ -8,15 +8,17 @@
 #include "persistence/Settings.h"
 #include "LocalTrackGroupView.h"
 #include "ScreensaverBlocker.h"
+#include "JamRoomViewPanel.h"
 
 #include <QTranslator>
 
 #include "performance/PerformanceMonitor.h"
+#include "performance/PerformanceHistory.h"
+#include "performance/AudioCallbackStatistics.h"
 
 class PreferencesDialog;
 class LocalTrackView;
 class NinjamRoomWindow;
-class JamRoomViewPanel;
 class ChordProgression;
 class ChordsPanel;
 
@@ -155,6 +157,7 @@ protected slots:
     void showJamtabaWikiWebPage();
     void showJamtabaUsersManual();
     void showJamtabaTranslators();
+    void exportPerformanceHistory();
 
     // private server
     void connectInPrivateServer(const QString &server, int serverPort, const QString &userName, const QString &password);
@@ -200,7 +203,7 @@ private slots:
 
     void showJamtabaCurrentVersion();
 
-    void refreshPublicRoomsList(const QList<Login::RoomInfo> &publicRooms);
+    void updatePublicRoomsList(const Login::RoomsListChanges &changes);
 
     void hideChordsPanel();
 
@@ -220,6 +223,8 @@ private slots:
 
     void updateNightModeInWorldMaps();
 
+    void updateGeoLocations();
+
 private:
 
     BusyDialog busyDialog;
@@ -246,6 +251,10 @@ private:
     QPointF computeLocation() const;
 
     QMap<long long, JamRoomViewPanel *> roomViewPanels;
+    QList<long long> publicRoomsOrder; // rooms IDs in the current layout order
+
+    QList<long long> getSortedPublicRooms() const;
+    void layoutPublicRooms(const QList<long long> &sortedRooms);
 
     QScopedPointer<NinjamRoomWindow> ninjamWindow;
 
@@ -281,7 +290,7 @@ private:
 
     ChordsPanel *createChordsPanel();
 
-    JamRoomViewPanel *createJamRoomViewPanel(const Login::RoomInfo &roomInfo);
+    JamRoomViewPanel *createJamRoomViewPanel(const Login::RoomInfo &roomInfo, JamRoomViewPanel::ResolvedLocations &resolvedLocations);
 
     void setupSignals();
     void setupWidgets();
@@ -307,7 +316,10 @@ private:
     static QString getStripedThemeName(const QString &fullThemeName);
 
     PerformanceMonitor performanceMonitor;//cpu and memmory usage
+    PerformanceHistory performanceHistory; // one sample for each performance monitor update
     qint64 lastPerformanceMonitorUpdate;
+    quint32 lastSavedProcessingTime; // used to compute the CPU saved by sleeping plugins
+    AudioCallbackStatistics::Snapshot lastAudioCallbackStatistics; // used to compute the DSP load
     static const int PERFORMANCE_MONITOR_REFRESH_TIME;
 
     static const QString NIGHT_MODE_SUFFIX;
@@ -2,8 +2,11 @@
 #include "geo/IpToLocationResolver.h"
 #include "MainController.h"
 #include "NinjamController.h"
+#include "audio/NinjamTrackNode.h"
 #include <QMenu>
 
+const qint64 NinjamTrackGroupView::BUFFERED_AUDIO_REFRESH_INTERVAL = 1000;
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 NinjamTrackGroupView::NinjamTrackGroupView(Controller::MainController *mainController, long trackID,
@@ -11,6 +14,7 @@ NinjamTrackGroupView::NinjamTrackGroupView(Controller::MainController *mainContr
                                            const Persistence::CacheEntry &initialValues) :
     TrackGroupView(nullptr),
     mainController(mainController),
+    lastBufferedBytes(-1),
     userIP(initialValues.getUserIP()),
     orientation(Qt::Vertical)
 {
@@ -49,6 +53,12 @@ NinjamTrackGroupView::NinjamTrackGroupView(Controller::MainController *mainContr
     topPanelLayout->addWidget(countryLabel);
     topPanelLayout->setAlignment(countryLabel, Qt::AlignTop);
 
+    bufferedAudioLabel = new QLabel();
+    bufferedAudioLabel->setObjectName("bufferedAudioLabel");
+    bufferedAudioLabel->setToolTip(tr("Memory used by the downloaded intervals of this user"));
+    bufferedAudioLabel->setSizePolicy(QSizePolicy(QSizePolicy::Preferred, QSizePolicy::Maximum));
+    topPanelLayout->addWidget(bufferedAudioLabel);
+
     // create the first subchannel by default
     NinjamTrackView *newTrackView = addTrackView(trackID);
     newTrackView->setChannelName(channelName);
@@ -227,6 +237,27 @@ void NinjamTrackGroupView::updateGuiElements()
 {
     TrackGroupView::updateGuiElements();
     groupNameLabel->updateMarquee();
+
+    if (!bufferedAudioTimer.isValid() || bufferedAudioTimer.elapsed() >= BUFFERED_AUDIO_REFRESH_INTERVAL) {
+        updateBufferedAudioLabel();
+        bufferedAudioTimer.start();
+    }
+}
+
+void NinjamTrackGroupView::updateBufferedAudioLabel()
+{
+    qint64 bufferedBytes = 0;
+    foreach (BaseTrackView *trackView, trackViews) {
+        NinjamTrackNode *node = dynamic_cast<NinjamTrackNode *>(mainController->getTrackNode(trackView->getTrackID()));
+        if (node)
+            bufferedBytes += node->getBufferedBytes();
+    }
+
+    if (bufferedBytes == lastBufferedBytes)
+        return;
+
+    lastBufferedBytes = bufferedBytes;
+    bufferedAudioLabel->setText(QString::number(bufferedBytes / 1024) + " KB");
 }
 
 NinjamTrackGroupView::~NinjamTrackGroupView()
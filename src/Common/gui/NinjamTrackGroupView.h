@@ -3,6 +3,7 @@
 
 #include "TrackGroupView.h"
 #include <QLabel>
+#include <QElapsedTimer>
 #include "MarqueeLabel.h"
 #include "NinjamTrackView.h"
 
@@ -44,9 +45,16 @@ private:
     QLabel *countryLabel;
     MarqueeLabel *groupNameLabel;
     QLabel *chatBlockIconLabel;
+    QLabel *bufferedAudioLabel; // memory used by the downloaded intervals of this user
+    QElapsedTimer bufferedAudioTimer;
+    qint64 lastBufferedBytes;
     QString userIP;
     Qt::Orientation orientation;
 
+    void updateBufferedAudioLabel();
+
+    static const qint64 BUFFERED_AUDIO_REFRESH_INTERVAL; // ms
+
     void setupHorizontalLayout();
     void setupVerticalLayout();
 
@@ -7,15 +7,14 @@ QColor CustomTabWidget::RESOURCES_USAGE_TEXT_COLOR = QColor(255, 255, 255, 160);
 
 CustomTabWidget::CustomTabWidget(QWidget *parent) :
     QTabWidget(parent),
-    //cpuUsage(0),
-    memoryUsage(0)
+    savedCpuUsage(0)
 {
 }
 
-void CustomTabWidget::setResourcesUsage(int memoryUsage)
+void CustomTabWidget::setResourcesUsage(const PerformanceHistory::Sample &usage, double savedCpuUsage)
 {
-    //this->cpuUsage = cpuUsage;
-    this->memoryUsage = memoryUsage;
+    this->usage = usage;
+    this->savedCpuUsage = savedCpuUsage;
     repaint();
 }
 
@@ -24,8 +23,18 @@ void CustomTabWidget::paintEvent(QPaintEvent *e){
 
     QPainter painter(this);
     //draw the cpu/memory usage background
-    //QString string = "CPU: " + QString::number(cpuUsage, 'f', 1) + "%  MEM: " + QString::number(memoryUsage) + " MB";
-    QString string = "MEM: " + QString::number(memoryUsage) + " %";
+    QString string;
+    if (usage.cpuUsage >= 0) // not available in all platforms
+        string += "CPU: " + QString::number(usage.cpuUsage, 'f', 1) + " %  ";
+    string += "DSP: " + QString::number(usage.dspLoad, 'f', 1) + " %  ";
+    if (usage.residentMemory > 0)
+        string += "MEM: " + QString::number(usage.residentMemory) + " MB";
+    else
+        string += "MEM: " + QString::number(usage.memoryUsage) + " %";
+    if (usage.xruns > 0)
+        string += "  XRUNS: " + QString::number(usage.xruns);
+    if (savedCpuUsage > 0)
+        string += "  SAVED CPU: " + QString::number(savedCpuUsage, 'f', 1) + " %";
     const int H_MARGIM = 3;
     const int V_MARGIM = 2;
     const int ROUND = 3;
@@ -2,20 +2,21 @@
 #define CUSTOMTABWIDGET_H
 
 #include <QTabWidget>
+#include "performance/PerformanceHistory.h"
 
 class CustomTabWidget : public QTabWidget
 {
 public:
     explicit CustomTabWidget(QWidget *parent);
-    void setResourcesUsage(int memoryUsage);// cpu usage in percentage, memoryUsage in megabytes
+    void setResourcesUsage(const PerformanceHistory::Sample &usage, double savedCpuUsage);// savedCpuUsage (by sleeping plugins) in percentage
     protected:
         void paintEvent(QPaintEvent *event);
 private:
     static QColor RESOURCES_USAGE_BG_COLOR;
     static QColor RESOURCES_USAGE_TEXT_COLOR;
 
-    double cpuUsage;
-    int memoryUsage;
+    PerformanceHistory::Sample usage;
+    double savedCpuUsage;
 };
 
 #endif // CUSTOMTABWIDGET_H
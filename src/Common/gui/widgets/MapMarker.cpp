@@ -18,3 +18,10 @@ QString MapMarker::getText() const
 {
     return playerName + "  " + countryName;
 }
+
+bool MapMarker::operator==(const MapMarker &other) const
+{
+    return playerName == other.playerName
+            && countryName == other.countryName
+            && latLong == other.latLong;
+}
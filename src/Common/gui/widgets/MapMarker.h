@@ -17,6 +17,8 @@ public:
     inline QString getCountryName() const { return countryName; }
     QString getText() const;
 
+    bool operator==(const MapMarker &other) const; // the flag is not compared, flags are loaded using the country code
+
 private:
     QString playerName;
     QString countryName;
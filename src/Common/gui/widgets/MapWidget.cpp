@@ -17,12 +17,7 @@ const int MapWidget::MARKER_POSITIONS = 8;
 bool MapWidget::usingNightMode = false;
 const int MapWidget::ZOOM = 1; // fixed zoom level
 
-QHash<QPoint, QPixmap> MapWidget::tilePixmaps;
-
-uint qHash(const QPoint& p)
-{
-    return p.x() * 17 ^ p.y();
-}
+QMap<bool, QPixmap> MapWidget::worldMaps;
 
 QPointF tileForCoordinate(qreal lat, qreal lng, int zoom)
 {
@@ -52,10 +47,10 @@ qreal getDistance(const QPointF &p1, const QPointF &p2)
 
 MapWidget::MapWidget(QWidget *parent)
     : QWidget(parent),
+      markersLayoutIsValid(false),
       blurActivated(false)
 {
 
-    loadTiles();
     setCenter(QPointF(0, 0));
     installEventFilter(this);
     initializeFonts();
@@ -180,6 +175,9 @@ QRectF MapWidget::computeMinimumRect(int zoom) const
 
 void MapWidget::setMarkers(const QList<MapMarker> &newMarkers)
 {
+    if (newMarkers == markers)
+        return; // avoid recompute the markers layout when the public rooms are refreshed and nobody entered or left the room
+
     markers.clear();
     markers.append(newMarkers);
 
@@ -203,6 +201,8 @@ QSize MapWidget::minimumSizeHint() const
 
 void MapWidget::invalidate()
 {
+    markersLayoutIsValid = false;
+
     if (width() <= 0 || height() <= 0)
         return;
 
@@ -233,17 +233,33 @@ void MapWidget::invalidate()
     update();
 }
 
-void MapWidget::loadTiles()
+const QPixmap &MapWidget::getWorldMap()
+{
+    // tiles are decoded in the first paint, the map widgets are not visible when Jamtaba is starting
+    if (!worldMaps.contains(usingNightMode))
+        worldMaps.insert(usingNightMode, createWorldMap(usingNightMode));
+
+    return worldMaps[usingNightMode];
+}
+
+QPixmap MapWidget::createWorldMap(bool nightMode)
 {
     int totalTiles = std::pow(2, ZOOM);
+    QPixmap worldMap(totalTiles * TILES_SIZE, totalTiles * TILES_SIZE);
+    worldMap.fill(Qt::white);
+
+    QPainter p(&worldMap);
     for (int x = 0; x < totalTiles; ++x) {
-        for (int y = 0; y < totalTiles; ++y) {
-            QPoint tp(x, y);
-            if (!tilePixmaps.contains(tp)) {
-                tilePixmaps.insert(tp, loadTile(ZOOM, x, y));
-            }
-        }
+        for (int y = 0; y < totalTiles; ++y)
+            p.drawPixmap(x * TILES_SIZE, y * TILES_SIZE, loadTile(ZOOM, x, y));
+    }
+
+    if (nightMode) { // composed just once, not in every paint
+        p.setCompositionMode(QPainter::CompositionMode_Difference);
+        p.fillRect(worldMap.rect(), Qt::white);
     }
+
+    return worldMap;
 }
 
 void MapWidget::updateMapPositionsCache()
@@ -282,27 +298,21 @@ QPixmap MapWidget::loadTile(int zoomLevel, int x, int y)
 
 void MapWidget::drawMapTiles(QPainter &p, const QRect &rect)
 {
+    const QPixmap &worldMap = getWorldMap(); // shared by all map widgets
+
     int tiles = std::pow(2, ZOOM);
     for (int x = 0; x <= tilesRect.width(); ++x) {
         for (int y = 0; y <= tilesRect.height(); ++y) {
             QPoint tp(x + tilesRect.left(), y + tilesRect.top());
             QRect box = tileRect(tp);
             if (rect.intersects(box)) {
-                tp.setX((tp.x() + tiles) % tiles);
-                tp.setY((tp.y() + tiles) % tiles);
-                if (tilePixmaps.contains(tp)) {
-                    p.drawPixmap(box, tilePixmaps.value(tp));
-                }
+                int tileX = (tp.x() + tiles) % tiles;
+                int tileY = (tp.y() + tiles) % tiles;
+                QRect tileInWorldMap(tileX * TILES_SIZE, tileY * TILES_SIZE, TILES_SIZE, TILES_SIZE);
+                p.drawPixmap(box, worldMap, tileInWorldMap);
             }
         }
     }
-
-    if (MapWidget::usingNightMode) {
-        QPainter::CompositionMode compositionMode = p.compositionMode();
-        p.setCompositionMode(QPainter::CompositionMode_Difference);
-        p.fillRect(rect, Qt::white);
-        p.setCompositionMode(compositionMode);
-    }
 }
 
 void MapWidget::paintEvent(QPaintEvent *event)
@@ -362,10 +372,13 @@ QList<MapWidget::Position> MapWidget::getEmptyPositions( const QMap<int, QList<M
     return emptyPositions;
 }
 
-void MapWidget::drawPlayersMarkers(QPainter &p)
+void MapWidget::updateMarkersLayout()
 {
-    if (mapPositions.isEmpty() && !markers.isEmpty())
-        updateMapPositionsCache();
+    markersLayout.clear();
+    markersLayoutIsValid = true;
+
+    if (!markers.isEmpty())
+        updateMapPositionsCache(); // the positions depend on the markers width
 
     QMap<int, QList<MapMarker>> map;
     for (const MapMarker &marker : markers) {
@@ -390,19 +403,27 @@ void MapWidget::drawPlayersMarkers(QPainter &p)
         }
     }
 
-    //finally drawing the markers
     for (int positionIndex : map.keys()) {
         if (!map[positionIndex].isEmpty()) {
             const MapMarker &marker = map[positionIndex].first();
             if (positionIndex >= 0 && positionIndex < mapPositions.size()) {
                 QPointF rectPosition = mapPositions.at(positionIndex).coords;
                 QPointF markerPosition = getMarkerScreenCoordinate(marker);
-                drawMarker(marker, p, markerPosition, rectPosition);
+                markersLayout.append(MarkerLayout(marker, markerPosition, rectPosition));
             }
         }
     }
 }
 
+void MapWidget::drawPlayersMarkers(QPainter &p)
+{
+    if (!markersLayoutIsValid)
+        updateMarkersLayout();
+
+    for (const MarkerLayout &layout : markersLayout)
+        drawMarker(layout.marker, p, layout.markerPosition, layout.rectPosition);
+}
+
 bool MapWidget::rectIntersectsSomeMarker(const QRectF &rect, const QList<MapMarker> &markers) const
 {
     QRectF r = rect.adjusted(-10, -10, 10, 10);
@@ -26,9 +26,6 @@ protected:
     QSize minimumSizeHint() const override;
     bool eventFilter(QObject *, QEvent *) override;
 
-private slots:
-    void loadTiles();
-
 private:
     static const int ZOOM;
     qreal latitude;
@@ -36,7 +33,9 @@ private:
 
     QPoint offset;
     QRect tilesRect;
-    static QHash<QPoint, QPixmap> tilePixmaps; // tiles cache
+    static QMap<bool, QPixmap> worldMaps; // all tiles and the night mode composition in one image shared by all map widgets, the night mode is the key
+    static const QPixmap &getWorldMap();
+    static QPixmap createWorldMap(bool nightMode);
 
     static bool usingNightMode;
 
@@ -59,7 +58,7 @@ private:
 
     void setCenter(QPointF latLong);
 
-    QPixmap loadTile(int zoomLevel, int x, int y);
+    static QPixmap loadTile(int zoomLevel, int x, int y);
 
     QPointF getCenterLatLong() const;
 
@@ -80,6 +79,19 @@ private:
     QList<MapWidget::Position> mapPositions;
     void updateMapPositionsCache();
 
+    struct MarkerLayout
+    {
+        MapMarker marker;
+        QPointF markerPosition; // the small circle
+        QPointF rectPosition; // the marker text
+        MarkerLayout(const MapMarker &marker, const QPointF &markerPosition, const QPointF &rectPosition)
+            : marker(marker), markerPosition(markerPosition), rectPosition(rectPosition){}
+    };
+
+    QList<MarkerLayout> markersLayout; // markers positions are computed when markers or widget size are changed, not in each paint
+    bool markersLayoutIsValid;
+    void updateMarkersLayout();
+
     QList<MapWidget::Position> getEllipsePositions(int markersHeight, const QRectF &ellipseRect) const;
     Position findBestEllipsePositionForMarker(const MapMarker &marker, const QList<MapMarker> &markers, const QList<Position> &positions);
     QList<MapWidget::Position> getEmptyPositions(const QMap<int, QList<MapMarker>> markers, const QList<MapWidget::Position> &allPositions) const;
@@ -0,0 +1,254 @@
+#include "LogWriter.h"
+
+#include <QFileInfo>
+#include <QDir>
+#include <QMutexLocker>
+#include <cstdio>
+#include <cstring>
+
+using namespace Log;
+
+const int LogRecord::MAX_RECORD_SIZE;
+
+LogRecordQueue::LogRecordQueue(int capacity) :
+    enqueuePosition(0),
+    dequeuePosition(0),
+    droppedRecords(0)
+{
+    quint32 size = 2;
+    while (size < static_cast<quint32>(capacity))
+        size <<= 1;
+
+    cells.resize(size);
+    for (quint32 i = 0; i < size; ++i)
+        cells[i].sequence.store(i);
+
+    mask = size - 1;
+}
+
+int LogRecordQueue::getCapacity() const
+{
+    return static_cast<int>(cells.size());
+}
+
+bool LogRecordQueue::push(const char *text, int length, int coloredLength, const char *color)
+{
+    Cell *cell = nullptr;
+    quint32 position = enqueuePosition.load();
+    forever {
+        cell = &cells[position & mask];
+        qint32 difference = static_cast<qint32>(cell->sequence.loadAcquire() - position);
+        if (difference == 0) { // free cell, try to reserve it
+            if (enqueuePosition.testAndSetRelaxed(position, position + 1))
+                break;
+            position = enqueuePosition.load();
+        }
+        else if (difference < 0) { // the consumer is not reading fast enough
+            droppedRecords.fetchAndAddRelaxed(1);
+            return false;
+        }
+        else { // another producer reserved this cell
+            position = enqueuePosition.load();
+        }
+    }
+
+    LogRecord &record = cell->record;
+    record.length = qBound(0, length, LogRecord::MAX_RECORD_SIZE);
+    record.coloredLength = qBound(0, coloredLength, record.length);
+    record.color = color;
+    std::memcpy(record.text, text, record.length);
+    if (length > record.length)
+        record.text[record.length - 1] = '\n'; // truncated record
+
+    cell->sequence.storeRelease(position + 1); // the record is visible to the consumer
+    return true;
+}
+
+bool LogRecordQueue::pop(LogRecord &record)
+{
+    Cell &cell = cells[dequeuePosition & mask];
+    qint32 difference = static_cast<qint32>(cell.sequence.loadAcquire() - (dequeuePosition + 1));
+    if (difference < 0)
+        return false; // empty queue
+
+    record.length = cell.record.length;
+    record.coloredLength = cell.record.coloredLength;
+    record.color = cell.record.color;
+    std::memcpy(record.text, cell.record.text, record.length);
+
+    cell.sequence.storeRelease(dequeuePosition + mask + 1); // the cell can be reused by producers
+    dequeuePosition++;
+    return true;
+}
+
+quint32 LogRecordQueue::takeDroppedRecords()
+{
+    return droppedRecords.fetchAndStoreRelaxed(0);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+const qint64 LogWriter::DEFAULT_MAX_FILE_SIZE = 2 * 1024 * 1024; // 2 MB
+const int LogWriter::DEFAULT_MAX_BACKUP_FILES = 2;
+const int LogWriter::QUEUE_CAPACITY = 1024;
+const int LogWriter::WRITE_INTERVAL = 100;
+
+#define COLOR_RESET "\033[0m"
+
+LogWriter::LogWriter(const QString &filePath, qint64 maxFileSize, int maxBackupFiles) :
+    queue(QUEUE_CAPACITY),
+    filePath(filePath),
+    maxFileSize(maxFileSize),
+    maxBackupFiles(maxBackupFiles),
+    echoToConsole(false),
+    stopRequested(0),
+    hasPendingTask(0)
+{
+    openFile(); // the log file is recreated in each Jamtaba session
+}
+
+LogWriter::~LogWriter()
+{
+    stop();
+}
+
+void LogWriter::setEchoToConsole(bool echo)
+{
+    echoToConsole = echo;
+}
+
+bool LogWriter::write(const QByteArray &text, int coloredLength, const char *color)
+{
+    return queue.push(text.constData(), text.size(), coloredLength, color);
+}
+
+bool LogWriter::write(const char *text, int length, int coloredLength, const char *color)
+{
+    return queue.push(text, length, coloredLength, color);
+}
+
+void LogWriter::runInWriterThread(const std::function<void()> &task)
+{
+    QMutexLocker locker(&taskMutex);
+    pendingTask = task;
+    hasPendingTask.storeRelease(1);
+}
+
+void LogWriter::runPendingTask()
+{
+    if (!hasPendingTask.loadAcquire())
+        return;
+
+    std::function<void()> task;
+    {
+        QMutexLocker locker(&taskMutex);
+        task.swap(pendingTask);
+        hasPendingTask.storeRelease(0);
+    }
+    if (task)
+        task();
+}
+
+void LogWriter::flush()
+{
+    writeQueuedRecords();
+}
+
+void LogWriter::stop()
+{
+    stopRequested.storeRelease(1);
+    if (isRunning())
+        wait();
+
+    writeQueuedRecords();
+    file.close();
+}
+
+void LogWriter::run()
+{
+    while (!stopRequested.loadAcquire()) {
+        runPendingTask();
+        writeQueuedRecords();
+        msleep(WRITE_INTERVAL);
+    }
+}
+
+void LogWriter::writeQueuedRecords()
+{
+    QMutexLocker locker(&consumerMutex);
+
+    fileBatch.clear(); // the capacity is preserved, no allocations after the first batches
+    consoleBatch.clear();
+
+    quint32 droppedRecords = queue.takeDroppedRecords();
+    if (droppedRecords > 0) {
+        QByteArray message = QByteArray::number(droppedRecords) + " log messages dropped, the log queue was full!\n";
+        fileBatch.append(message);
+        consoleBatch.append(message);
+    }
+
+    while (queue.pop(record)) {
+        fileBatch.append(record.text, record.length);
+        if (echoToConsole) {
+            if (record.color && record.coloredLength > 0) {
+                consoleBatch.append(record.color);
+                consoleBatch.append(record.text, record.coloredLength);
+                consoleBatch.append(COLOR_RESET);
+                consoleBatch.append(record.text + record.coloredLength, record.length - record.coloredLength);
+            }
+            else {
+                consoleBatch.append(record.text, record.length);
+            }
+        }
+    }
+
+    if (echoToConsole && !consoleBatch.isEmpty()) {
+        std::fwrite(consoleBatch.constData(), 1, consoleBatch.size(), stdout);
+        std::fflush(stdout);
+    }
+
+    if (fileBatch.isEmpty() || !file.isOpen())
+        return;
+
+    file.write(fileBatch);
+    file.flush();
+
+    if (maxFileSize > 0 && file.size() >= maxFileSize)
+        rotateFile();
+}
+
+QString LogWriter::getBackupFilePath(const QString &filePath, int backupIndex)
+{
+    QFileInfo fileInfo(filePath);
+    QString fileName = fileInfo.completeBaseName() + "." + QString::number(backupIndex);
+    if (!fileInfo.suffix().isEmpty())
+        fileName += "." + fileInfo.suffix();
+
+    return fileInfo.dir().absoluteFilePath(fileName);
+}
+
+void LogWriter::rotateFile()
+{
+    file.close();
+
+    if (maxBackupFiles > 0) {
+        QFile::remove(getBackupFilePath(filePath, maxBackupFiles));
+        for (int i = maxBackupFiles - 1; i >= 1; --i)
+            QFile::rename(getBackupFilePath(filePath, i), getBackupFilePath(filePath, i + 1));
+
+        QFile::rename(filePath, getBackupFilePath(filePath, 1));
+    }
+
+    openFile();
+}
+
+void LogWriter::openFile()
+{
+    QFileInfo(filePath).dir().mkpath("."); // the Jamtaba folders tree is not created in the first run
+
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        QByteArray error = "Can't open the log file " + filePath.toUtf8() + ": " + file.errorString().toUtf8() + "\n";
+        std::fwrite(error.constData(), 1, error.size(), stderr);
+    }
+}
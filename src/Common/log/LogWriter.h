@@ -0,0 +1,124 @@
+#ifndef LOG_WRITER_H
+#define LOG_WRITER_H
+
+#include <QThread>
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QString>
+#include <QMutex>
+#include <QFile>
+#include <vector>
+#include <functional>
+
+namespace Log {
+
+struct LogRecord
+{
+    static const int MAX_RECORD_SIZE = 512; // bigger records are truncated
+
+    char text[MAX_RECORD_SIZE];
+    int length;
+    int coloredLength; // the first 'coloredLength' chars are colored in console
+    const char *color; // ANSI color code, must be a string literal
+};
+
+/***
+    Fixed capacity lock free queue used to pass log records from any thread to the LogWriter thread.
+    Many producers and just one consumer. Pushing is never blocking or allocating, the records are
+    dropped (and counted) when the queue is full.
+ */
+class LogRecordQueue
+{
+public:
+    explicit LogRecordQueue(int capacity); // capacity is rounded up to a power of 2
+
+    bool push(const char *text, int length, int coloredLength = 0, const char *color = nullptr);
+    bool pop(LogRecord &record); // called only by the consumer thread
+
+    int getCapacity() const;
+
+    quint32 takeDroppedRecords(); // return the dropped records counter and reset it
+
+private:
+    struct Cell
+    {
+        QAtomicInteger<quint32> sequence;
+        LogRecord record;
+    };
+
+    std::vector<Cell> cells;
+    quint32 mask;
+    QAtomicInteger<quint32> enqueuePosition;
+    quint32 dequeuePosition;
+    QAtomicInteger<quint32> droppedRecords;
+};
+
+/***
+    Background thread owning the log file. The producers (including the audio thread) are just
+    pushing preformatted records in a LogRecordQueue, the writer thread is consuming the queued
+    records in batches using one open file handle. When the file is bigger than 'maxFileSize'
+    the file is rotated: log.txt is renamed to log.1.txt, log.1.txt to log.2.txt, and so on.
+ */
+class LogWriter : public QThread
+{
+public:
+    LogWriter(const QString &filePath, qint64 maxFileSize = DEFAULT_MAX_FILE_SIZE,
+              int maxBackupFiles = DEFAULT_MAX_BACKUP_FILES);
+    ~LogWriter();
+
+    // never blocking, return false if the record was dropped
+    bool write(const QByteArray &text, int coloredLength = 0, const char *color = nullptr);
+    bool write(const char *text, int length, int coloredLength = 0, const char *color = nullptr);
+
+    void flush(); // write the queued records in caller thread, used before abort in fatal messages
+    void stop(); // write the queued records and finish the writer thread
+
+    void setEchoToConsole(bool echo); // write the records in stdout too, using colors
+
+    // 'task' is executed once in the writer thread before the next batch, used to change the writer thread scheduling
+    void runInWriterThread(const std::function<void()> &task);
+
+    inline QString getFilePath() const
+    {
+        return filePath;
+    }
+
+    static QString getBackupFilePath(const QString &filePath, int backupIndex);
+
+    static const qint64 DEFAULT_MAX_FILE_SIZE;
+    static const int DEFAULT_MAX_BACKUP_FILES;
+
+protected:
+    void run() override;
+
+private:
+    LogRecordQueue queue;
+    QString filePath;
+    QFile file;
+    qint64 maxFileSize;
+    int maxBackupFiles;
+    bool echoToConsole;
+    QAtomicInt stopRequested;
+    QMutex consumerMutex; // the queue is consumed by writer thread and by flush(), producers never lock this mutex
+
+    QMutex taskMutex;
+    std::function<void()> pendingTask;
+    QAtomicInt hasPendingTask;
+
+    void runPendingTask();
+
+    QByteArray fileBatch;
+    QByteArray consoleBatch;
+    LogRecord record;
+
+    void writeQueuedRecords();
+    void openFile();
+    void rotateFile();
+
+    static const int QUEUE_CAPACITY;
+    static const int WRITE_INTERVAL; // ms
+};
+
+} // namespace
+
+#endif // LOG_WRITER_H
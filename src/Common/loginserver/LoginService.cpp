@@ -24,6 +24,11 @@ UserInfo::UserInfo(long long id, const QString &name, const QString &ip) :
 {
 }
 
+bool UserInfo::operator==(const UserInfo &other) const
+{
+    return id == other.id && name == other.name && ip == other.ip;
+}
+
 RoomInfo::RoomInfo(long long id, const QString &roomName, int roomPort, RoomTYPE roomType,
                    int maxUsers, const QList<UserInfo> &users, int maxChannels, int bpi, int bpm, const QString &streamUrl) :
     id(id),
@@ -82,6 +87,38 @@ bool RoomInfo::isEmpty() const
     return getNonBotUsersCount() == 0;
 }
 
+bool RoomInfo::operator==(const RoomInfo &other) const
+{
+    return id == other.id
+            && name == other.name
+            && port == other.port
+            && type == other.type
+            && maxUsers == other.maxUsers
+            && maxChannels == other.maxChannels
+            && bpi == other.bpi
+            && bpm == other.bpm
+            && streamUrl == other.streamUrl
+            && users == other.users;
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+RoomsListChanges::RoomsListChanges(const QList<RoomInfo> &previousRooms, const QList<RoomInfo> &currentRooms)
+{
+    QMap<long long, const RoomInfo *> previousRoomsMap;
+    for (const RoomInfo &room : previousRooms)
+        previousRoomsMap.insert(room.getID(), &room);
+
+    for (const RoomInfo &room : currentRooms) {
+        const RoomInfo *previousRoom = previousRoomsMap.take(room.getID());
+        if (!previousRoom)
+            addedRooms.append(room);
+        else if (*previousRoom != room)
+            updatedRooms.append(room);
+    }
+
+    removedRooms = previousRoomsMap.keys(); // rooms not found in current list
+}
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 class HttpParamsFactory
 {
@@ -172,7 +209,7 @@ void LoginService::connectInServer(const QString &userName, int instrumentID,
 void LoginService::refreshTimerSlot()
 {
     QUrlQuery query = HttpParamsFactory::createParametersToRefreshRoomsList();
-    pendingReply = sendCommandToServer(query);
+    pendingReply = sendCommandToServer(query, false, true); // conditional request, unchanged lists are not downloaded again
     if (pendingReply)
         connectNetworkReplySlots(pendingReply, LoginService::Command::REFRESH_ROOMS_LIST);
 }
@@ -198,10 +235,15 @@ void LoginService::disconnectFromServer()
     }
     this->connected = false;
 
+    lastRooms.clear();
+    lastRoomsListContent.clear();
+    lastETag.clear();
+    lastModified.clear();
+
     qDebug(jtLoginService) << "disconnected from login server!";
 }
 
-QNetworkReply *LoginService::sendCommandToServer(const QUrlQuery &query, bool synchronous)
+QNetworkReply *LoginService::sendCommandToServer(const QUrlQuery &query, bool synchronous, bool conditional)
 {
     if (pendingReply) {
         pendingReply->deleteLater();
@@ -213,6 +255,12 @@ QNetworkReply *LoginService::sendCommandToServer(const QUrlQuery &query, bool sy
     request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);// disable cache
     request.setHeader(QNetworkRequest::ContentTypeHeader,
                       QStringLiteral("application/x-www-form-urlencoded; charset=utf-8"));
+    if (conditional) { // the server can reply '304 Not Modified'
+        if (!lastETag.isEmpty())
+            request.setRawHeader("If-None-Match", lastETag);
+        if (!lastModified.isEmpty())
+            request.setRawHeader("If-Modified-Since", lastModified);
+    }
     pendingReply = httpClient->post(request, postData);
     if (synchronous && pendingReply) {
         QEventLoop loop;
@@ -297,17 +345,49 @@ void LoginService::connectedSlot()
 
 void LoginService::roomsListReceivedSlot()
 {
-    QString json = QString(pendingReply->readAll());
-    handleJson(json);
+    // failed replies are ignored, the last rooms list and the cache validators are preserved
+    if (pendingReply->error() != QNetworkReply::NoError) {
+        qCWarning(jtLoginService) << "Rooms list not received:" << pendingReply->errorString();
+        return;
+    }
+
+    int statusCode = pendingReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (statusCode == 304) {
+        qCDebug(jtLoginService) << "Rooms list not modified";
+        return;
+    }
+
+    if (statusCode < 200 || statusCode >= 300) {
+        qCWarning(jtLoginService) << "Rooms list not received, HTTP status:" << statusCode;
+        return;
+    }
+
+    QByteArray content = pendingReply->readAll();
+    if (connected && content == lastRoomsListContent)
+        return; // the same rooms list, json is not parsed again
+
+    if (!handleJson(content))
+        return;
+
+    lastRoomsListContent = content;
+    if (pendingReply->hasRawHeader("ETag"))
+        lastETag = pendingReply->rawHeader("ETag");
+    if (pendingReply->hasRawHeader("Last-Modified"))
+        lastModified = pendingReply->rawHeader("Last-Modified");
 }
 
-void LoginService::handleJson(const QString &json)
+bool LoginService::handleJson(const QByteArray &json)
 {
-    if (json.isEmpty())
-        return;
-    QJsonDocument document = QJsonDocument::fromJson(QByteArray(json.toStdString().c_str()));
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        qCWarning(jtLoginService) << "Invalid rooms list received:" << parseError.errorString();
+        return false;
+    }
+
     QJsonObject root = document.object();
-    if (!connected) {// first time handling json?
+    bool firstList = !connected;
+    if (firstList) {// first time handling json?
         bool clientIsServerCompatible = root["clientCompatibility"].toBool();
         bool newVersionAvailable = root["newVersionAvailable"].toBool();
 
@@ -315,13 +395,18 @@ void LoginService::handleJson(const QString &json)
             refreshTimer->stop();
             connected = false;
             emit incompatibilityWithServerDetected();
-            return;
+            return false;
         }
 
         if (newVersionAvailable)
             emit newVersionAvailableForDownload();
     }
 
+    if (!root["rooms"].isArray()) { // an empty list here would remove all rooms
+        qCWarning(jtLoginService) << "Invalid rooms list received, no rooms array!";
+        return false;
+    }
+
     QJsonArray allRooms = root["rooms"].toArray();
     QList<RoomInfo> publicRooms;
     for (int i = 0; i < allRooms.size(); ++i) {
@@ -335,7 +420,16 @@ void LoginService::handleJson(const QString &json)
         QString key = getRoomInfoUniqueName(roomInfo);
         lastChordProgressions.insert(key, lastChordProgression);
     }
+
+    RoomsListChanges changes(lastRooms, publicRooms);
+    lastRooms = publicRooms;
+
+    if (changes.isEmpty() && !firstList)
+        return true;
+
     emit roomsListAvailable(publicRooms);
+    emit roomsListChanged(changes);
+    return true;
 }
 
 QString LoginService::getChordProgressionFor(const RoomInfo &roomInfo) const
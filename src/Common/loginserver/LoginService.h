@@ -25,6 +25,8 @@ public:
         return name;
     }
 
+    bool operator==(const UserInfo &other) const;
+
 private:
     long long id;
     QString name;
@@ -109,6 +111,12 @@ public:
         return bpi;
     }
 
+    bool operator==(const RoomInfo &other) const;
+    inline bool operator!=(const RoomInfo &other) const
+    {
+        return !(*this == other);
+    }
+
 protected:
     long long id;
     QString name;
@@ -122,6 +130,42 @@ protected:
     int bpm;
 };
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++++
+/***
+  Structural difference between two public rooms list snapshots. A room is 'updated' when
+  some user joined or left, or when bpm, bpi, stream url, etc. changed.
+ */
+class RoomsListChanges
+{
+public:
+    RoomsListChanges(const QList<RoomInfo> &previousRooms, const QList<RoomInfo> &currentRooms);
+
+    inline const QList<RoomInfo> &getAddedRooms() const
+    {
+        return addedRooms;
+    }
+
+    inline const QList<RoomInfo> &getUpdatedRooms() const
+    {
+        return updatedRooms;
+    }
+
+    inline const QList<long long> &getRemovedRooms() const
+    {
+        return removedRooms; // the rooms IDs
+    }
+
+    inline bool isEmpty() const
+    {
+        return addedRooms.isEmpty() && updatedRooms.isEmpty() && removedRooms.isEmpty();
+    }
+
+private:
+    QList<RoomInfo> addedRooms;
+    QList<RoomInfo> updatedRooms;
+    QList<long long> removedRooms;
+};
+
 // +++++++++++++++++++++++++++++++++++++++++++++++++++
 class LoginService : public QObject
 {
@@ -148,6 +192,7 @@ public:
 
 signals:
     void roomsListAvailable(const QList<Login::RoomInfo> &publicRooms);
+    void roomsListChanged(const Login::RoomsListChanges &changes); // emitted only when the rooms list is changed
     void incompatibilityWithServerDetected();
     void newVersionAvailableForDownload();
     void errorWhenConnectingToServer(const QString &error);
@@ -159,10 +204,16 @@ private:
 
     QNetworkAccessManager *httpClient;
     QNetworkReply *pendingReply;
-    QNetworkReply *sendCommandToServer(const QUrlQuery &, bool synchronous = false);
+    QNetworkReply *sendCommandToServer(const QUrlQuery &, bool synchronous = false, bool conditional = false);
     static const QString SERVER;
     bool connected;
-    void handleJson(const QString &json);
+    bool handleJson(const QByteArray &json); // return false when the json is not a valid rooms list
+
+    // last received rooms list, used to skip unchanged lists and compute the changes
+    QList<RoomInfo> lastRooms;
+    QByteArray lastRoomsListContent;
+    QByteArray lastETag;
+    QByteArray lastModified;
 
     RoomInfo buildRoomInfoFromJson(const QJsonObject &json);
 
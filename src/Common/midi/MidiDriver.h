@@ -24,7 +24,8 @@ public:
     virtual int getMaxInputDevices() const = 0;
 
     virtual QString getInputDeviceName(uint index) const = 0;
-    virtual MidiMessageBuffer getBuffer() = 0;
+    // append the messages received since the last call, the frame offsets are computed using the audio block size
+    virtual void pullMessages(MidiMessageBuffer &outBuffer, int audioBlockFrames) = 0;
 
     virtual bool deviceIsGloballyEnabled(int deviceIndex) const;
     int getFirstGloballyEnableInputDevice() const;
@@ -65,9 +66,10 @@ class NullMidiDriver : public MidiDriver
         return "";
     }
 
-    inline virtual MidiMessageBuffer getBuffer() override
+    inline virtual void pullMessages(MidiMessageBuffer &outBuffer, int audioBlockFrames) override
     {
-        return MidiMessageBuffer(0);
+        Q_UNUSED(outBuffer);
+        Q_UNUSED(audioBlockFrames);
     }
 };
 }
@@ -0,0 +1,53 @@
+#include "MidiEventQueue.h"
+#include <algorithm>
+
+using namespace Midi;
+
+MidiEventQueue::MidiEventQueue(int capacity) :
+    capacity(std::max(1, capacity)),
+    size(this->capacity + 1),
+    events(this->capacity + 1),
+    readIndex(0),
+    writeIndex(0)
+{
+}
+
+int MidiEventQueue::getAvailableEvents() const
+{
+    return (writeIndex.loadAcquire() - readIndex.loadAcquire() + size) % size;
+}
+
+bool MidiEventQueue::push(const MidiMessage &message, qint64 timestamp)
+{
+    int currentWriteIndex = writeIndex.load();
+    int nextWriteIndex = (currentWriteIndex + 1) % size;
+    if (nextWriteIndex == readIndex.loadAcquire())
+        return false; // full
+
+    Event &event = events[currentWriteIndex];
+    event.message = message;
+    event.timestamp = timestamp;
+
+    writeIndex.storeRelease(nextWriteIndex); // publish the event to consumer
+    return true;
+}
+
+bool MidiEventQueue::pop(MidiMessage &message, qint64 &timestamp)
+{
+    int currentReadIndex = readIndex.load();
+    if (currentReadIndex == writeIndex.loadAcquire())
+        return false; // empty
+
+    const Event &event = events[currentReadIndex];
+    message = event.message;
+    timestamp = event.timestamp;
+
+    readIndex.storeRelease((currentReadIndex + 1) % size); // release the slot to producer
+    return true;
+}
+
+void MidiEventQueue::clear()
+{
+    readIndex.storeRelease(0);
+    writeIndex.storeRelease(0);
+}
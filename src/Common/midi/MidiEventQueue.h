@@ -0,0 +1,45 @@
+#ifndef MIDI_EVENT_QUEUE_H
+#define MIDI_EVENT_QUEUE_H
+
+#include "MidiMessage.h"
+#include <QAtomicInt>
+#include <vector>
+
+namespace Midi {
+
+/***
+  A fixed capacity queue of timestamped MIDI messages. No memory is allocated after the construction,
+  and one thread can push messages (the MIDI input thread) while another thread is popping messages
+  (the audio thread) without locks.
+ */
+class MidiEventQueue
+{
+public:
+    explicit MidiEventQueue(int capacity);
+
+    inline int getCapacity() const { return capacity; }
+    int getAvailableEvents() const;
+
+    bool push(const MidiMessage &message, qint64 timestamp); // producer side, false if the queue is full
+    bool pop(MidiMessage &message, qint64 &timestamp); // consumer side, false if the queue is empty
+
+    void clear(); // not thread safe, producer and consumer can't be running
+
+private:
+    struct Event
+    {
+        MidiMessage message;
+        qint64 timestamp;
+    };
+
+    int capacity;
+    int size; // capacity + 1, one slot is always empty to distinguish full and empty queues
+    std::vector<Event> events;
+
+    QAtomicInt readIndex; // changed only by the consumer
+    QAtomicInt writeIndex; // changed only by the producer
+};
+
+} // namespace
+
+#endif // MIDI_EVENT_QUEUE_H
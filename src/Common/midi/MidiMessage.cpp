@@ -4,9 +4,10 @@
 
 using namespace Midi;
 
-MidiMessage::MidiMessage(qint32 data, int sourceID)
+MidiMessage::MidiMessage(qint32 data, int sourceID, int frameOffset)
     : data(data),
-      sourceID(sourceID)
+      sourceID(sourceID),
+      frameOffset(frameOffset)
 {
 
 }
@@ -14,19 +15,21 @@ MidiMessage::MidiMessage(qint32 data, int sourceID)
 
 MidiMessage::MidiMessage()
     :data(-1),
-     sourceID(-1)
+     sourceID(-1),
+     frameOffset(0)
 {
 
 }
 
 MidiMessage::MidiMessage(const MidiMessage &other)
     : data(other.data),
-      sourceID(other.sourceID)
+      sourceID(other.sourceID),
+      frameOffset(other.frameOffset)
 {
 
 }
 
-MidiMessage MidiMessage::fromVector(std::vector<unsigned char> vector, qint32 deviceIndex)
+MidiMessage MidiMessage::fromVector(const std::vector<unsigned char> &vector, qint32 deviceIndex)
 {
     int msgData = 0;
     msgData |= vector.at(0);
@@ -9,11 +9,11 @@ namespace Midi {
 class MidiMessage
 {
 public:
-    MidiMessage(qint32 data, int sourceID);
+    MidiMessage(qint32 data, int sourceID, int frameOffset = 0);
     MidiMessage();
     MidiMessage(const MidiMessage &other);
 
-    static MidiMessage fromVector(std::vector<unsigned char> vector, qint32 sourceID);
+    static MidiMessage fromVector(const std::vector<unsigned char> &vector, qint32 sourceID);
     static MidiMessage fromArray(const char array[4], qint32 sourceID=-1);
 
     int getChannel() const;
@@ -36,9 +36,14 @@ public:
 
     bool isControl() const;
 
+    // position (in samples) of the message inside the current audio block, used to deliver sample accurate MIDI to plugins
+    int getFrameOffset() const;
+    void setFrameOffset(int frameOffset);
+
 private:
     qint32 data;
     int sourceID; //the id of the midi device generating the message.
+    int frameOffset;
 };
 
 inline int MidiMessage::getChannel() const
@@ -71,6 +76,16 @@ inline bool MidiMessage::isControl() const
     return getStatus() == 0xB0;
 }
 
+inline int MidiMessage::getFrameOffset() const
+{
+    return frameOffset;
+}
+
+inline void MidiMessage::setFrameOffset(int frameOffset)
+{
+    this->frameOffset = frameOffset;
+}
+
 }//namespace
 
 #endif
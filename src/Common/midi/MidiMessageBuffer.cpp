@@ -0,0 +1,68 @@
+#include "MidiMessageBuffer.h"
+
+#include <QDebug>
+
+using namespace Midi;
+
+const int MidiMessageBuffer::MAX_MESSAGES;
+
+MidiMessageBuffer::MidiMessageBuffer() :
+    messagesCount(0)
+{
+}
+
+MidiMessageBuffer::MidiMessageBuffer(const MidiMessageBuffer &other) :
+    messagesCount(other.messagesCount)
+{
+    for (int m = 0; m < other.messagesCount; ++m)
+        messages[m] = other.messages[m];
+}
+
+MidiMessageBuffer &MidiMessageBuffer::operator=(const MidiMessageBuffer &other)
+{
+    // only the valid messages are copied
+    messagesCount = other.messagesCount;
+    for (int m = 0; m < other.messagesCount; ++m)
+        messages[m] = other.messages[m];
+    return *this;
+}
+
+void MidiMessageBuffer::addMessage(const MidiMessage &m)
+{
+    if (messagesCount < MAX_MESSAGES) {
+        messages[messagesCount] = m;
+        messagesCount++;
+    } else {
+        qWarning() << "MidiBuffer full, discarding the message!";
+    }
+}
+
+void MidiMessageBuffer::append(const MidiMessageBuffer &other)
+{
+    if (&other == this)
+        return;
+
+    for (int m = 0; m < other.messagesCount; ++m)
+        addMessage(other.messages[m]);
+}
+
+void MidiMessageBuffer::sortByFrameOffset()
+{
+    // insertion sort, stable and without allocations. The buffer is small and almost sorted.
+    for (int m = 1; m < messagesCount; ++m) {
+        MidiMessage message = messages[m];
+        int index = m - 1;
+        while (index >= 0 && messages[index].getFrameOffset() > message.getFrameOffset()) {
+            messages[index + 1] = messages[index];
+            index--;
+        }
+        messages[index + 1] = message;
+    }
+}
+
+MidiMessage MidiMessageBuffer::getMessage(int index) const
+{
+    if (index >= 0 && index < messagesCount)
+        return messages[index];
+    return MidiMessage();
+}
@@ -1,30 +1,57 @@
 #ifndef _MIDI_MESSAGE_BUFFER_
 #define _MIDI_MESSAGE_BUFFER_
 
-#include <QList>
+#include "MidiMessage.h"
 
 namespace Midi {
 
-class MidiMessage;
-
+/***
+  Fixed capacity MIDI messages buffer. The messages are stored inside the buffer, so no memory is
+  allocated when buffers are created, copied or filled in the audio thread.
+ */
 class MidiMessageBuffer
 {
 public:
-    explicit MidiMessageBuffer(int maxMessages);
-    ~MidiMessageBuffer();
-    void addMessage(const MidiMessage &m);
+    MidiMessageBuffer();
+    MidiMessageBuffer(const MidiMessageBuffer &other);
+    MidiMessageBuffer &operator=(const MidiMessageBuffer &other);
+
+    void addMessage(const MidiMessage &m); // the message is discarded if the buffer is full
+    void append(const MidiMessageBuffer &other);
     MidiMessage getMessage(int index) const;
-    int getMessagesCount() const
+
+    inline int getMessagesCount() const
     {
         return messagesCount;
     }
 
-    QList<Midi::MidiMessage> toList() const;
+    inline bool isEmpty() const
+    {
+        return messagesCount == 0;
+    }
+
+    inline void clear()
+    {
+        messagesCount = 0;
+    }
+
+    void sortByFrameOffset(); // messages from different devices are sorted chronologically
+
+    // span like access to the stored messages, used in range based for loops
+    inline const MidiMessage *begin() const
+    {
+        return messages;
+    }
+
+    inline const MidiMessage *end() const
+    {
+        return messages + messagesCount;
+    }
+
+    static const int MAX_MESSAGES = 128;
 
-    MidiMessageBuffer(const MidiMessageBuffer &other);
 private:
-    int maxMessages;
-    MidiMessage *messages;
+    MidiMessage messages[MAX_MESSAGES];
     int messagesCount;
 };
 
@@ -2,15 +2,45 @@
 #include "RtMidi.h"
 
 #include "MidiMessage.h"
+#include "MidiEventQueue.h"
 
 using namespace Midi;
 
 #include "log/Logging.h"
 
-RtMidiDriver::RtMidiDriver(const QList<bool> &deviceStatuses){
+const int RtMidiDriver::MAX_QUEUED_MESSAGES = 256;
+const qint64 RtMidiDriver::DISCARDED_MESSAGES_REPORT_INTERVAL = Q_INT64_C(1000000000); // 1 second, in nanoseconds
+
+class RtMidiDriver::StreamContext
+{
+public:
+    StreamContext(int deviceIndex, const QElapsedTimer &clock) :
+        deviceIndex(deviceIndex),
+        clock(clock),
+        queue(MAX_QUEUED_MESSAGES),
+        droppedMessages(0),
+        ignoredMessages(0)
+    {
+    }
+
+    int deviceIndex;
+    const QElapsedTimer &clock;
+    MidiEventQueue queue;
+
+    // counted in RtMidi thread and reported later, logging in the callback is allocating
+    QAtomicInt droppedMessages; // the queue was full
+    QAtomicInt ignoredMessages; // not 3 bytes messages
+};
+
+RtMidiDriver::RtMidiDriver(const QList<bool> &deviceStatuses) :
+    lastBufferTimestamp(0),
+    lastDiscardedMessagesReport(0)
+{
 
     qCDebug(jtMidi) << "Initializing rtmidi...";
 
+    clock.start();
+
     QList<bool> statuses(deviceStatuses);
     int maxInputDevices = getMaxInputDevices();
 
@@ -46,6 +76,7 @@ void RtMidiDriver::setInputDevicesStatus(const QList<bool> &statuses){
 
     for (int s = 0; s < validStatuses.size(); ++s) {
         midiStreams.append(new RtMidiIn());
+        streamContexts.append(new StreamContext(s, clock));
     }
 }
 
@@ -67,6 +98,7 @@ void RtMidiDriver::start(const QList<bool> &deviceStatuses){
                     try{
                         qCInfo(jtMidi) << "Starting MIDI in " << QString::fromStdString(stream->getPortName(deviceIndex));
                         stream->ignoreTypes();// ignoring sysex, miditime and midi sense messages
+                        stream->setCallback(&RtMidiDriver::midiCallback, streamContexts.at(deviceIndex));
                         stream->openPort(deviceIndex);
                     }
                     catch(RtMidiError e){
@@ -107,6 +139,9 @@ void RtMidiDriver::release(){
         }
     }
     midiStreams.clear();
+
+    qDeleteAll(streamContexts); // the streams are deleted, so the callbacks are not running
+    streamContexts.clear();
 }
 
 QString RtMidiDriver::getInputDeviceName(uint index) const{
@@ -116,32 +151,77 @@ QString RtMidiDriver::getInputDeviceName(uint index) const{
     return "";
 }
 
-void RtMidiDriver::consumeMessagesFromStream(RtMidiIn *stream, int deviceIndex, MidiMessageBuffer &outBuffer)
+void RtMidiDriver::midiCallback(double deltaTime, std::vector<unsigned char> *message, void *userData)
 {
-    //qCDebug(jtMidi) << "consuming messages from stream - RtMidiDriver";
-    std::vector<unsigned char> messageBytes;
-    do{
-        messageBytes.clear();
-        stream->getMessage(&messageBytes);
-        if (messageBytes.size() == 3) { // Jamtaba is handling only the 3 bytes commond midi messages. Uncommon midi messages will be ignored.
-            outBuffer.addMessage(Midi::MidiMessage::fromVector(messageBytes, deviceIndex));
-        }
-        else{
-            if (!messageBytes.empty())
-                qWarning() << "A midi message containing " << messageBytes.size() << " bytes was received!";
+    Q_UNUSED(deltaTime) // RtMidi delta time is relative to the previous message, the arrival time is used instead
+
+    StreamContext *context = static_cast<StreamContext *>(userData);
+    if (!context || !message)
+        return;
+
+    if (message->size() == 3) { // Jamtaba is handling only the 3 bytes commond midi messages. Uncommon midi messages will be ignored.
+        qint64 timestamp = context->clock.nsecsElapsed();
+        if (!context->queue.push(MidiMessage::fromVector(*message, context->deviceIndex), timestamp))
+            context->droppedMessages.fetchAndAddRelaxed(1);
+    }
+    else{
+        if (!message->empty())
+            context->ignoredMessages.fetchAndAddRelaxed(1);
+    }
+}
+
+void RtMidiDriver::consumeMessagesFromStream(StreamContext *context, int audioBlockFrames, qint64 now, MidiMessageBuffer &outBuffer)
+{
+    /**
+        The messages received while the last audio block was playing are delivered in the current block,
+    using the arrival time to compute the position inside the block. The MIDI latency is always one block,
+    instead of a jitter between zero and one block when all messages are delivered in the block start.
+    */
+    qint64 blockDuration = now - lastBufferTimestamp;
+
+    MidiMessage message;
+    qint64 timestamp;
+    while (context->queue.pop(message, timestamp)) {
+        int frameOffset = 0;
+        if (lastBufferTimestamp > 0 && blockDuration > 0) {
+            qint64 elapsed = timestamp - lastBufferTimestamp;
+            frameOffset = qBound(0, (int)(elapsed * audioBlockFrames / blockDuration), audioBlockFrames - 1);
         }
+        message.setFrameOffset(frameOffset);
+        outBuffer.addMessage(message);
     }
-    while(!messageBytes.empty());
 }
 
-MidiMessageBuffer RtMidiDriver::getBuffer(){
-    MidiMessageBuffer buffer(64);//max 64 midi messages in each audio callback
-    int deviceIndex = 0;
-    foreach (RtMidiIn* stream, midiStreams) {
-        consumeMessagesFromStream(stream, deviceIndex, buffer);
-        deviceIndex++;
+void RtMidiDriver::pullMessages(MidiMessageBuffer &outBuffer, int audioBlockFrames){
+    qint64 now = clock.nsecsElapsed();
+    foreach (StreamContext *context, streamContexts)
+        consumeMessagesFromStream(context, audioBlockFrames, now, outBuffer);
+
+    lastBufferTimestamp = now;
+
+    outBuffer.sortByFrameOffset();
+
+    if (now - lastDiscardedMessagesReport >= DISCARDED_MESSAGES_REPORT_INTERVAL) {
+        reportDiscardedMessages();
+        lastDiscardedMessagesReport = now;
     }
-    return buffer;
+}
+
+void RtMidiDriver::reportDiscardedMessages()
+{
+    int droppedMessages = 0;
+    int ignoredMessages = 0;
+    foreach (StreamContext *context, streamContexts) {
+        droppedMessages += context->droppedMessages.fetchAndStoreRelaxed(0);
+        ignoredMessages += context->ignoredMessages.fetchAndStoreRelaxed(0);
+    }
+
+    // at most one warning per interval, even when the MIDI input is flooding the queues
+    if (droppedMessages > 0)
+        qWarning() << "MIDI queue full, " << droppedMessages << " messages discarded!";
+
+    if (ignoredMessages > 0)
+        qWarning() << ignoredMessages << " midi messages not containing 3 bytes were ignored!";
 }
 
 bool RtMidiDriver::hasInputDevices() const{
@@ -3,6 +3,7 @@
 
 #include "MidiDriver.h"
 #include "RtMidi.h"
+#include <QElapsedTimer>
 
 namespace Midi {
 class RtMidiDriver : public MidiDriver
@@ -20,12 +21,29 @@ public:
     bool hasInputDevices() const override;
     int getMaxInputDevices() const override;
     QString getInputDeviceName(uint index) const override;
-    MidiMessageBuffer getBuffer() override;
+    void pullMessages(MidiMessageBuffer &outBuffer, int audioBlockFrames) override;
 
 private:
     QList<RtMidiIn *> midiStreams;
 
-    void consumeMessagesFromStream(RtMidiIn *stream, int deviceIndex, MidiMessageBuffer &outBuffer);
+    /**
+        The messages are received in RtMidi threads (callbacks) and timestamped in arrival. Each stream
+    has your own lock-free queue, and these queues are consumed in audio thread.
+    */
+    class StreamContext;
+    QList<StreamContext *> streamContexts;
+
+    QElapsedTimer clock; // used to timestamp the received messages
+    qint64 lastBufferTimestamp; // when the last audio block started, in nanoseconds
+    qint64 lastDiscardedMessagesReport; // in nanoseconds
+
+    static void midiCallback(double deltaTime, std::vector<unsigned char> *message, void *userData);
+
+    void consumeMessagesFromStream(StreamContext *context, int audioBlockFrames, qint64 now, MidiMessageBuffer &outBuffer);
+    void reportDiscardedMessages(); // called from pullMessages, rate limited
+
+    static const int MAX_QUEUED_MESSAGES;
+    static const qint64 DISCARDED_MESSAGES_REPORT_INTERVAL;
 
 };
 }
@@ -0,0 +1,69 @@
+#include "AudioCallbackStatistics.h"
+
+AudioCallbackStatistics::AudioCallbackStatistics() :
+    processingTime(0),
+    bufferTime(0),
+    inputUnderflows(0),
+    inputOverflows(0),
+    outputUnderflows(0),
+    outputOverflows(0)
+{
+}
+
+void AudioCallbackStatistics::addCallback(qint64 processingNanoseconds, int frames, int sampleRate)
+{
+    if (sampleRate <= 0)
+        return;
+
+    processingTime.fetchAndAddRelaxed(static_cast<int>((processingNanoseconds + 500) / 1000));
+    bufferTime.fetchAndAddRelaxed(static_cast<int>((frames * Q_INT64_C(1000000) + sampleRate / 2) / sampleRate));
+}
+
+void AudioCallbackStatistics::addXruns(bool inputUnderflow, bool inputOverflow, bool outputUnderflow, bool outputOverflow)
+{
+    if (inputUnderflow)
+        inputUnderflows.fetchAndAddRelaxed(1);
+
+    if (inputOverflow)
+        inputOverflows.fetchAndAddRelaxed(1);
+
+    if (outputUnderflow)
+        outputUnderflows.fetchAndAddRelaxed(1);
+
+    if (outputOverflow)
+        outputOverflows.fetchAndAddRelaxed(1);
+}
+
+AudioCallbackStatistics::Snapshot AudioCallbackStatistics::getSnapshot() const
+{
+    Snapshot snapshot;
+    snapshot.processingTime = static_cast<quint32>(processingTime.load());
+    snapshot.bufferTime = static_cast<quint32>(bufferTime.load());
+    snapshot.inputUnderflows = static_cast<quint32>(inputUnderflows.load());
+    snapshot.inputOverflows = static_cast<quint32>(inputOverflows.load());
+    snapshot.outputUnderflows = static_cast<quint32>(outputUnderflows.load());
+    snapshot.outputOverflows = static_cast<quint32>(outputOverflows.load());
+    return snapshot;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+double AudioCallbackStatistics::Snapshot::getDspLoad(const Snapshot &previous) const
+{
+    quint32 periodBufferTime = bufferTime - previous.bufferTime;
+    if (periodBufferTime == 0)
+        return 0; // no callbacks in this period
+
+    quint32 periodProcessingTime = processingTime - previous.processingTime;
+    return periodProcessingTime * 100.0 / periodBufferTime;
+}
+
+quint32 AudioCallbackStatistics::Snapshot::getXruns(const Snapshot &previous) const
+{
+    return getXruns() - previous.getXruns();
+}
+
+quint32 AudioCallbackStatistics::Snapshot::getXruns() const
+{
+    return inputUnderflows + inputOverflows + outputUnderflows + outputOverflows;
+}
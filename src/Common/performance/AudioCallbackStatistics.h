@@ -0,0 +1,46 @@
+#ifndef AUDIO_CALLBACK_STATISTICS_H
+#define AUDIO_CALLBACK_STATISTICS_H
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+/***
+    Audio callbacks load and xruns. The counters are updated in the audio thread without locks
+    and read in the GUI thread. All counters are wrapping around, the readers use the difference
+    between two snapshots.
+ */
+class AudioCallbackStatistics
+{
+public:
+    struct Snapshot
+    {
+        quint32 processingTime; // microseconds spent inside the audio callbacks
+        quint32 bufferTime; // microseconds of processed audio (the sum of the buffer periods)
+        quint32 inputUnderflows;
+        quint32 inputOverflows;
+        quint32 outputUnderflows;
+        quint32 outputOverflows;
+
+        double getDspLoad(const Snapshot &previous) const; // callbacks time / buffers period, in percentage
+        quint32 getXruns(const Snapshot &previous) const;
+        quint32 getXruns() const; // since the start
+    };
+
+    AudioCallbackStatistics();
+
+    // called in the audio thread
+    void addCallback(qint64 processingNanoseconds, int frames, int sampleRate);
+    void addXruns(bool inputUnderflow, bool inputOverflow, bool outputUnderflow, bool outputOverflow);
+
+    Snapshot getSnapshot() const;
+
+private:
+    QAtomicInt processingTime;
+    QAtomicInt bufferTime;
+    QAtomicInt inputUnderflows;
+    QAtomicInt inputOverflows;
+    QAtomicInt outputUnderflows;
+    QAtomicInt outputOverflows;
+};
+
+#endif // AUDIO_CALLBACK_STATISTICS_H
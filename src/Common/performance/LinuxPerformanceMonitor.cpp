@@ -1,7 +1,36 @@
 #include "PerformanceMonitor.h"
+#include "../log/Logging.h"
 
+#include <QFile>
+#include <QList>
+#include <QByteArray>
+#include <unistd.h>
 
-PerformanceMonitor::PerformanceMonitor(){
+// read the small /proc files, the reported size of these files is zero
+static QByteArray readProcFile(const char *path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(jtCore) << "Can't read" << path << file.errorString();
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+static qint64 getResidentPages()
+{
+    // /proc/self/statm: size resident shared text lib data dt (in pages)
+    QList<QByteArray> fields = readProcFile("/proc/self/statm").split(' ');
+    if (fields.size() < 2)
+        return 0;
+
+    return fields.at(1).toLongLong();
+}
+
+PerformanceMonitor::PerformanceMonitor() :
+    processorsCount(qMax(1, static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)))),
+    lastProcessTime(-1)
+{
 
 }
 
@@ -10,6 +39,43 @@ PerformanceMonitor::~PerformanceMonitor(){
 }
 
 int PerformanceMonitor::getMemmoryUsed(){
+    qint64 physicalPages = sysconf(_SC_PHYS_PAGES);
+    if (physicalPages <= 0)
+        return 0;
+
+    return static_cast<int>(getResidentPages() * 100 / physicalPages);
+}
+
+int PerformanceMonitor::getResidentMemory(){
+    static const qint64 DIVIDER = 1024 * 1024;
+    return static_cast<int>(getResidentPages() * sysconf(_SC_PAGESIZE) / DIVIDER);
+}
+
+double PerformanceMonitor::getCpuUsage(){
+    // the process name in /proc/self/stat can contain spaces, the fields are counted after the last ')'
+    QByteArray stat = readProcFile("/proc/self/stat");
+    int nameEnd = stat.lastIndexOf(')');
+    if (nameEnd < 0)
+        return -1;
+
+    // state is the field 3 in proc(5), utime is the field 14 and stime is the field 15
+    QList<QByteArray> fields = stat.mid(nameEnd + 2).split(' ');
+    if (fields.size() < 13)
+        return -1;
+
+    qint64 clockTicks = fields.at(11).toLongLong() + fields.at(12).toLongLong();
+    qint64 processTime = clockTicks * 1000 / sysconf(_SC_CLK_TCK);
+
+    qint64 elapsedTime = 0;
+    if (cpuUsageTimer.isValid())
+        elapsedTime = cpuUsageTimer.restart();
+    else
+        cpuUsageTimer.start(); // the first call is just starting the measurement
+
+    double cpuUsage = 0;
+    if (lastProcessTime >= 0 && elapsedTime > 0)
+        cpuUsage = (processTime - lastProcessTime) * 100.0 / (elapsedTime * processorsCount);
 
-    return 0;
+    lastProcessTime = processTime;
+    return cpuUsage;
 }
@@ -1,7 +1,10 @@
 #include "PerformanceMonitor.h"
 
 
-PerformanceMonitor::PerformanceMonitor(){
+PerformanceMonitor::PerformanceMonitor() :
+    processorsCount(1),
+    lastProcessTime(-1)
+{
 
 }
 
@@ -9,13 +12,16 @@ PerformanceMonitor::~PerformanceMonitor(){
 
 }
 
-/*
 double PerformanceMonitor::getCpuUsage(){
-    return 0;
+    return -1; // not implemented yet
 }
-*/
 
 int PerformanceMonitor::getMemmoryUsed(){
 
     return 0;
 }
+
+int PerformanceMonitor::getResidentMemory(){
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "PerformanceHistory.h"
+#include "log/Logging.h"
+
+#include <QDateTime>
+#include <QFile>
+
+const int PerformanceHistory::DEFAULT_CAPACITY = 3600; // one hour using one sample per second
+
+PerformanceHistory::Sample::Sample() :
+    timestamp(0),
+    cpuUsage(-1),
+    memoryUsage(0),
+    residentMemory(0),
+    dspLoad(0),
+    xruns(0)
+{
+}
+
+PerformanceHistory::PerformanceHistory(int capacity) :
+    capacity(qMax(1, capacity))
+{
+}
+
+void PerformanceHistory::add(const Sample &sample)
+{
+    if (samples.size() >= capacity)
+        samples.removeFirst();
+
+    samples.append(sample);
+}
+
+void PerformanceHistory::clear()
+{
+    samples.clear();
+}
+
+QByteArray PerformanceHistory::toCsv() const
+{
+    QByteArray csv("time,cpu (%),memory (%),resident memory (MB),dsp load (%),xruns\n");
+    for (const Sample &sample : samples) {
+        csv += QDateTime::fromMSecsSinceEpoch(sample.timestamp).toString(Qt::ISODate).toUtf8();
+        csv += ',';
+        if (sample.cpuUsage >= 0) // empty cell when not available
+            csv += QByteArray::number(sample.cpuUsage, 'f', 1);
+        csv += ',';
+        csv += QByteArray::number(sample.memoryUsage);
+        csv += ',';
+        csv += QByteArray::number(sample.residentMemory);
+        csv += ',';
+        csv += QByteArray::number(sample.dspLoad, 'f', 1);
+        csv += ',';
+        csv += QByteArray::number(sample.xruns);
+        csv += '\n';
+    }
+    return csv;
+}
+
+bool PerformanceHistory::exportToCsv(const QString &filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCWarning(jtCore) << "Can't export the performance history to" << filePath << file.errorString();
+        return false;
+    }
+
+    return file.write(toCsv()) >= 0;
+}
@@ -0,0 +1,53 @@
+#ifndef PERFORMANCE_HISTORY_H
+#define PERFORMANCE_HISTORY_H
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+
+/***
+    The last resources usage samples, one sample for each performance monitor update in
+    MainWindow. The oldest samples are discarded when the history is full. The history can be
+    exported as CSV and opened in any spreadsheet.
+ */
+class PerformanceHistory
+{
+public:
+    struct Sample
+    {
+        Sample();
+
+        qint64 timestamp; // milliseconds since epoch
+        double cpuUsage; // process CPU usage in percentage, negative when not available
+        int memoryUsage; // in percentage
+        int residentMemory; // process resident memory in MB, zero when not available
+        double dspLoad; // audio callbacks time / buffers period, in percentage
+        quint32 xruns; // since the start
+    };
+
+    explicit PerformanceHistory(int capacity = DEFAULT_CAPACITY);
+
+    void add(const Sample &sample);
+    void clear();
+
+    inline const QList<Sample> &getSamples() const // oldest sample first
+    {
+        return samples;
+    }
+
+    inline int getCapacity() const
+    {
+        return capacity;
+    }
+
+    QByteArray toCsv() const;
+    bool exportToCsv(const QString &filePath) const;
+
+    static const int DEFAULT_CAPACITY;
+
+private:
+    QList<Sample> samples;
+    int capacity;
+};
+
+#endif // PERFORMANCE_HISTORY_H
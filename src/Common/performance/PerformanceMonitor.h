@@ -1,9 +1,11 @@
 #ifndef PERFORMANCE_MONITOR_H
 #define PERFORMANCE_MONITOR_H
 
+#include <QElapsedTimer>
+
 //this class is implemented in different files for multiplatform purposes.
 //The implementation files are WindowsPerformanceMonitor.cpp, MacPerformanceMonitor.cpp
-//and in the future LinuxPerformanceMonitor
+//and LinuxPerformanceMonitor.cpp
 //The correct implementation file is selected in Jamtaba-common.pri
 
 class PerformanceMonitor{
@@ -11,11 +13,14 @@ public:
     explicit PerformanceMonitor();
     ~PerformanceMonitor();
     //int getMemmoryUsage();
-      int getMemmoryUsed();
-    //double getCpuUsage();
+      int getMemmoryUsed(); // in percentage
+      int getResidentMemory(); // process resident memory in MB, zero when not available
+      double getCpuUsage(); // process CPU usage since the last call, in percentage of all processors. Negative when not available
     //double getTotalCpuUsage();
 private:
     int processorsCount;
+    QElapsedTimer cpuUsageTimer;
+    qint64 lastProcessTime; // process user + system time in milliseconds, used to compute the CPU usage
 };
 
 #endif // PERFORMANCE_MONITOR_H
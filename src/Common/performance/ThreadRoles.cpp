@@ -0,0 +1,210 @@
+#include "ThreadRoles.h"
+#include "log/Logging.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThreadStorage>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+
+struct Registry
+{
+    Registry()
+    {
+        for (int role = 0; role < ThreadRoles::RolesCount; ++role)
+            policies[role] = ThreadRoles::getDefaultPolicy(static_cast<ThreadRoles::Role>(role));
+    }
+
+    QMutex mutex;
+    ThreadRoles::Policy policies[ThreadRoles::RolesCount];
+    QStringList report;
+};
+
+}
+
+Q_GLOBAL_STATIC(Registry, registry)
+
+static QThreadStorage<int> appliedRole; // the role applied in each thread
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+ThreadRoles::Policy ThreadRoles::getDefaultPolicy(Role role)
+{
+    switch (role) {
+    case AudioCallback:
+        return Policy(FifoScheduling, 70);
+    case Encoding:
+        return Policy(RoundRobinScheduling, 40, -5); // nice -5 when real time is not permitted
+    case Logging:
+        return Policy(DefaultScheduling, 0, 5);
+    default:
+        return Policy();
+    }
+}
+
+void ThreadRoles::setPolicy(Role role, const Policy &policy)
+{
+    if (role < 0 || role >= RolesCount)
+        return;
+
+    QMutexLocker locker(&registry->mutex);
+    registry->policies[role] = policy;
+}
+
+ThreadRoles::Policy ThreadRoles::getPolicy(Role role)
+{
+    if (role < 0 || role >= RolesCount)
+        return Policy();
+
+    QMutexLocker locker(&registry->mutex);
+    return registry->policies[role];
+}
+
+void ThreadRoles::applyToCurrentThread(Role role)
+{
+    if (appliedRole.hasLocalData())
+        return; // only the first call in each thread is changing the thread
+
+    appliedRole.setLocalData(role);
+
+    QString granted = applyPolicy(getPolicy(role));
+    qCInfo(jtCore) << getRoleName(role) << "thread:" << granted;
+    addToReport(getRoleName(role) + ": " + granted);
+}
+
+QString ThreadRoles::applyPolicy(const Policy &policy)
+{
+    if (policy.isDefault())
+        return "default scheduling";
+
+    QStringList granted;
+#ifdef Q_OS_LINUX
+    bool usingRealTime = false;
+    if (policy.scheduling != DefaultScheduling) {
+        int schedulingPolicy = policy.scheduling == FifoScheduling ? SCHED_FIFO : SCHED_RR;
+        sched_param parameters;
+        parameters.sched_priority = qBound(sched_get_priority_min(schedulingPolicy), policy.realTimePriority,
+                                           sched_get_priority_max(schedulingPolicy));
+        int error = pthread_setschedparam(pthread_self(), schedulingPolicy, &parameters);
+        if (error == 0) {
+            usingRealTime = true;
+            granted << QString("%1 priority %2").arg(getSchedulingName(policy.scheduling)).arg(parameters.sched_priority);
+        }
+        else {
+            granted << QString("%1 not permitted (%2)").arg(getSchedulingName(policy.scheduling), std::strerror(error));
+        }
+    }
+
+    if (!usingRealTime && policy.niceLevel != 0) {
+        pid_t threadId = static_cast<pid_t>(syscall(SYS_gettid)); // nice levels are per thread in Linux
+        if (setpriority(PRIO_PROCESS, threadId, policy.niceLevel) == 0)
+            granted << QString("nice %1").arg(policy.niceLevel);
+        else
+            granted << QString("nice %1 not permitted (%2)").arg(policy.niceLevel).arg(std::strerror(errno));
+    }
+
+    if (!policy.cpus.isEmpty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        QStringList cpus;
+        for (int cpu : policy.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpuSet);
+                cpus << QString::number(cpu);
+            }
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if (error == 0)
+            granted << "pinned to CPU " + cpus.join(",");
+        else
+            granted << QString("CPU pinning not permitted (%1)").arg(std::strerror(error));
+    }
+#else
+    granted << "thread policies are not supported in this platform";
+#endif
+
+    return granted.join(", ");
+}
+
+bool ThreadRoles::lockMemory()
+{
+#ifdef Q_OS_LINUX
+    // with a small RLIMIT_MEMLOCK the MCL_FUTURE flag is breaking the next allocations, so we don't try
+    rlimit limit;
+    if (geteuid() != 0 && getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        QString text = QString("Memory locking skipped, RLIMIT_MEMLOCK is %1 KB").arg(limit.rlim_cur / 1024);
+        qCWarning(jtCore) << text;
+        addToReport(text);
+        return false;
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        QString text = QString("Memory locking not permitted (%1)").arg(std::strerror(errno));
+        qCWarning(jtCore) << text;
+        addToReport(text);
+        return false;
+    }
+
+    qCInfo(jtCore) << "Memory locked";
+    addToReport("Memory locked");
+    return true;
+#else
+    addToReport("Memory locking is not supported in this platform");
+    return false;
+#endif
+}
+
+void ThreadRoles::addToReport(const QString &text)
+{
+    QMutexLocker locker(&registry->mutex);
+    registry->report.append(text);
+}
+
+QStringList ThreadRoles::getReport()
+{
+    QMutexLocker locker(&registry->mutex);
+    return registry->report;
+}
+
+QString ThreadRoles::getRoleName(Role role)
+{
+    switch (role) {
+    case AudioCallback: return "audio";
+    case Encoding:      return "encoding";
+    case Workers:       return "workers";
+    case Gui:           return "gui";
+    case Logging:       return "logging";
+    default:            return QString();
+    }
+}
+
+QString ThreadRoles::getSchedulingName(Scheduling scheduling)
+{
+    switch (scheduling) {
+    case FifoScheduling:        return "fifo";
+    case RoundRobinScheduling:  return "rr";
+    default:                    return "default";
+    }
+}
+
+ThreadRoles::Scheduling ThreadRoles::getSchedulingFromName(const QString &name)
+{
+    if (name == "fifo")
+        return FifoScheduling;
+
+    if (name == "rr")
+        return RoundRobinScheduling;
+
+    return DefaultScheduling;
+}
@@ -0,0 +1,82 @@
+#ifndef THREAD_ROLES_H
+#define THREAD_ROLES_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/***
+    Scheduling policies for the Jamtaba threads, grouped by role. Each thread applies the policy
+    of its role calling applyToCurrentThread(), only the first call in each thread is changing the
+    thread, so the call can be placed in the audio callback or in QtConcurrent tasks.
+
+    When a policy is not permitted (no RLIMIT_RTPRIO for real time scheduling, no CAP_SYS_NICE
+    for negative nice levels, etc.) the next fallback is used and the thread keeps running. What
+    was granted for each thread is logged and available in getReport().
+
+    Real time scheduling, nice levels, CPU pinning and memory locking are implemented only in Linux.
+ */
+class ThreadRoles
+{
+public:
+    enum Role
+    {
+        AudioCallback,
+        Encoding, // NinjamController encoding thread
+        Workers, // QtConcurrent global pool (interval decoding, jam recorder files)
+        Gui,
+        Logging, // LogWriter thread
+        RolesCount
+    };
+
+    enum Scheduling
+    {
+        DefaultScheduling,
+        FifoScheduling,
+        RoundRobinScheduling
+    };
+
+    struct Policy
+    {
+        Policy(Scheduling scheduling = DefaultScheduling, int realTimePriority = 0, int niceLevel = 0,
+               const QList<int> &cpus = QList<int>()) :
+            scheduling(scheduling),
+            realTimePriority(realTimePriority),
+            niceLevel(niceLevel),
+            cpus(cpus)
+        {
+        }
+
+        inline bool isDefault() const
+        {
+            return scheduling == DefaultScheduling && niceLevel == 0 && cpus.isEmpty();
+        }
+
+        Scheduling scheduling;
+        int realTimePriority; // 1 to 99, used in FIFO and round robin scheduling
+        int niceLevel; // -20 to 19, used in default scheduling or when real time scheduling is not permitted
+        QList<int> cpus; // CPU pinning, empty list to run in any CPU
+    };
+
+    static void setPolicy(Role role, const Policy &policy); // used by threads applying the policy after this call
+    static Policy getPolicy(Role role);
+    static Policy getDefaultPolicy(Role role);
+
+    static void applyToCurrentThread(Role role);
+
+    static bool lockMemory(); // mlockall(), process wide
+
+    static QStringList getReport(); // what was granted for each thread
+
+    static QString getRoleName(Role role);
+    static QString getSchedulingName(Scheduling scheduling);
+    static Scheduling getSchedulingFromName(const QString &name);
+
+private:
+    ThreadRoles();
+
+    static QString applyPolicy(const Policy &policy);
+    static void addToReport(const QString &text);
+};
+
+#endif // THREAD_ROLES_H
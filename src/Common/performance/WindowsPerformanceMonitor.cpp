@@ -6,7 +6,10 @@
 
 //http://hackage.haskell.org/package/criterion-1.1.0.0/src/cbits/time-windows.c
 
-PerformanceMonitor::PerformanceMonitor(){
+PerformanceMonitor::PerformanceMonitor() :
+    processorsCount(1),
+    lastProcessTime(-1)
+{
 /*
     HANDLE thisProcessHande = GetCurrentProcess();
     SYSTEM_INFO sysInfo;
@@ -94,3 +97,13 @@ int PerformanceMonitor::getMemmoryUsed(){
     }
     return 0;
 }
+
+int PerformanceMonitor::getResidentMemory(){
+
+    return 0; // the memory usage is reported in percentage by getMemmoryUsed()
+}
+
+double PerformanceMonitor::getCpuUsage(){
+
+    return -1; // not implemented yet, see the commented getCpuUsage() above
+}
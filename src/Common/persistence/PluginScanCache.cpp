@@ -0,0 +1,96 @@
+#include "PluginScanCache.h"
+
+#include <QJsonObject>
+#include <QDateTime>
+
+using namespace Persistence;
+
+qint64 PluginScanCache::getLastModified(const QFileInfo &file)
+{
+    return file.lastModified().toMSecsSinceEpoch();
+}
+
+bool PluginScanCache::isUpToDate(const QFileInfo &pluginFile) const
+{
+    auto it = entries.find(pluginFile.absoluteFilePath());
+    if (it == entries.end())
+        return false;
+
+    return it->fileSize == pluginFile.size() && it->lastModified == getLastModified(pluginFile);
+}
+
+bool PluginScanCache::isValidPlugin(const QString &pluginPath) const
+{
+    auto it = entries.find(pluginPath);
+    return it != entries.end() && it->validPlugin;
+}
+
+qint64 PluginScanCache::getScanTime(const QString &pluginPath) const
+{
+    auto it = entries.find(pluginPath);
+    if (it == entries.end())
+        return -1;
+
+    return it->scanTime;
+}
+
+QStringList PluginScanCache::getValidPlugins() const
+{
+    QStringList validPlugins;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->validPlugin)
+            validPlugins.append(it.key());
+    }
+    return validPlugins;
+}
+
+void PluginScanCache::update(const QFileInfo &pluginFile, bool validPlugin, qint64 scanTime)
+{
+    Entry entry;
+    entry.fileSize = pluginFile.size();
+    entry.lastModified = getLastModified(pluginFile);
+    entry.scanTime = scanTime;
+    entry.validPlugin = validPlugin;
+    entries.insert(pluginFile.absoluteFilePath(), entry);
+}
+
+void PluginScanCache::remove(const QString &pluginPath)
+{
+    entries.remove(pluginPath);
+}
+
+void PluginScanCache::clear()
+{
+    entries.clear();
+}
+
+void PluginScanCache::write(QJsonArray &out) const
+{
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        QJsonObject object;
+        object["path"] = it.key();
+        object["size"] = QString::number(it->fileSize); // qint64 values are stored as strings, json numbers are doubles
+        object["modified"] = QString::number(it->lastModified);
+        object["scanTime"] = QString::number(it->scanTime);
+        object["valid"] = it->validPlugin;
+        out.append(object);
+    }
+}
+
+void PluginScanCache::read(const QJsonArray &in)
+{
+    entries.clear();
+    for (int i = 0; i < in.size(); ++i) {
+        QJsonObject object = in.at(i).toObject();
+        QString path = object["path"].toString();
+        if (path.isEmpty())
+            continue;
+
+        Entry entry;
+        entry.fileSize = object["size"].toString().toLongLong();
+        entry.lastModified = object["modified"].toString().toLongLong();
+        entry.scanTime = object["scanTime"].toString().toLongLong();
+        entry.validPlugin = object["valid"].toBool();
+        entries.insert(path, entry);
+    }
+}
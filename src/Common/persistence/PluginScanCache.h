@@ -0,0 +1,54 @@
+#ifndef PLUGIN_SCAN_CACHE_H
+#define PLUGIN_SCAN_CACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QJsonArray>
+#include <QFileInfo>
+
+namespace Persistence {
+
+/***
+  Results of the previous plugin scans. Each scanned file is stored with the file size and the last
+  modification time, so unchanged files (valid plugins or not) are skipped in the next scans. Plugins
+  crashing the scanner are never cached, these plugins are handled by the black list.
+ */
+class PluginScanCache
+{
+public:
+    bool isUpToDate(const QFileInfo &pluginFile) const; // true if the file was scanned and is unchanged
+    bool isValidPlugin(const QString &pluginPath) const;
+    qint64 getScanTime(const QString &pluginPath) const; // in milliseconds, -1 if the plugin is not cached
+
+    QStringList getValidPlugins() const;
+
+    void update(const QFileInfo &pluginFile, bool validPlugin, qint64 scanTime);
+    void remove(const QString &pluginPath);
+    void clear();
+
+    inline int size() const
+    {
+        return entries.size();
+    }
+
+    void write(QJsonArray &out) const;
+    void read(const QJsonArray &in);
+
+private:
+    struct Entry
+    {
+        qint64 fileSize;
+        qint64 lastModified; // msecs since epoch
+        qint64 scanTime; // msecs
+        bool validPlugin;
+    };
+
+    QMap<QString, Entry> entries; // the absolute file path is the key
+
+    static qint64 getLastModified(const QFileInfo &file);
+};
+
+} // namespace
+
+#endif // PLUGIN_SCAN_CACHE_H
@@ -323,7 +323,8 @@ void WindowSettings::write(QJsonObject &out) const
 
 // +++++++++++++++++++++++++++++++++++++++
 VstSettings::VstSettings() :
-    SettingsObject("VST")
+    SettingsObject("VST"),
+    scanProcesses(0)
 {
 }
 
@@ -344,6 +345,12 @@ void VstSettings::write(QJsonObject &out) const
     foreach (const QString &blackVst, blackedPlugins)
         BlackedArray.append(blackVst);
     out["BlackListPlugins"] = BlackedArray;
+
+    QJsonArray scanCacheArray;
+    scanCache.write(scanCacheArray);
+    out["scanCache"] = scanCacheArray;
+
+    out["scanProcesses"] = scanProcesses;
 }
 
 void VstSettings::read(const QJsonObject &in)
@@ -370,6 +377,9 @@ void VstSettings::read(const QJsonObject &in)
         for (int x = 0; x < cacheArray.size(); ++x)
             blackedPlugins.append(cacheArray.at(x).toString());
     }
+
+    scanCache.read(getValueFromJson(in, "scanCache", QJsonArray()));
+    scanProcesses = qMax(0, getValueFromJson(in, "scanProcesses", 0));
 }
 // +++++++++++++++++++++++++++++++++++++++
 
@@ -661,6 +671,11 @@ QStringList Settings::getVstScanFolders() const
     return vstSettings.foldersToScan;
 }
 
+void Settings::setVstScanCache(const PluginScanCache &scanCache)
+{
+    vstSettings.scanCache = scanCache;
+}
+
 QStringList Settings::getBlackListedPlugins() const
 {
     return vstSettings.blackedPlugins;
@@ -911,6 +926,7 @@ void Settings::load()
     sections.append(&recordingSettings);
     sections.append(&privateServerSettings);
     sections.append(&meteringSettings);
+    sections.append(&threadsSettings);
 
     readFile(sections);
 }
@@ -940,6 +956,7 @@ void Settings::save(const LocalInputTrackSettings &localInputsSettings)
     sections.append(&recordingSettings);
     sections.append(&privateServerSettings);
     sections.append(&meteringSettings);
+    sections.append(&threadsSettings);
 
     writeFile(sections);
 }
@@ -993,3 +1010,50 @@ void MeteringSettings::write(QJsonObject &out) const
     out["refreshRate"]      = refreshRate;
     out["waveDrawingMode"]  = waveDrawingMode;
 }
+
+//__________________________________________________________
+
+ThreadsSettings::ThreadsSettings()
+    : SettingsObject(QStringLiteral("Threads")),
+      lockingMemory(false)
+{
+    for (int role = 0; role < ThreadRoles::RolesCount; ++role)
+        policies[role] = ThreadRoles::getDefaultPolicy(static_cast<ThreadRoles::Role>(role));
+}
+
+void ThreadsSettings::read(const QJsonObject &in)
+{
+    for (int role = 0; role < ThreadRoles::RolesCount; ++role) {
+        ThreadRoles::Role threadRole = static_cast<ThreadRoles::Role>(role);
+        ThreadRoles::Policy defaultPolicy = ThreadRoles::getDefaultPolicy(threadRole);
+        QJsonObject policyObject = getValueFromJson(in, ThreadRoles::getRoleName(threadRole), QJsonObject());
+
+        ThreadRoles::Policy &policy = policies[role];
+        QString scheduling = getValueFromJson(policyObject, "scheduling", ThreadRoles::getSchedulingName(defaultPolicy.scheduling));
+        policy.scheduling = ThreadRoles::getSchedulingFromName(scheduling);
+        policy.realTimePriority = qBound(1, getValueFromJson(policyObject, "priority", defaultPolicy.realTimePriority), 99);
+        policy.niceLevel = qBound(-20, getValueFromJson(policyObject, "nice", defaultPolicy.niceLevel), 19);
+        policy.cpus.clear();
+        QJsonArray cpusArray = getValueFromJson(policyObject, "cpus", QJsonArray());
+        for (int i = 0; i < cpusArray.size(); ++i)
+            policy.cpus.append(cpusArray.at(i).toInt());
+    }
+    lockingMemory = getValueFromJson(in, "lockMemory", false);
+}
+
+void ThreadsSettings::write(QJsonObject &out) const
+{
+    for (int role = 0; role < ThreadRoles::RolesCount; ++role) {
+        const ThreadRoles::Policy &policy = policies[role];
+        QJsonObject policyObject;
+        policyObject["scheduling"] = ThreadRoles::getSchedulingName(policy.scheduling);
+        policyObject["priority"] = policy.realTimePriority;
+        policyObject["nice"] = policy.niceLevel;
+        QJsonArray cpusArray;
+        for (int cpu : policy.cpus)
+            cpusArray.append(cpu);
+        policyObject["cpus"] = cpusArray;
+        out[ThreadRoles::getRoleName(static_cast<ThreadRoles::Role>(role))] = policyObject;
+    }
+    out["lockMemory"] = lockingMemory;
+}
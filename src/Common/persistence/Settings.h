@@ -9,7 +9,9 @@
 #include <QStringList>
 #include <QFile>
 #include "Configurator.h"
+#include "PluginScanCache.h"
 #include "audio/core/PluginDescriptor.h"
+#include "performance/ThreadRoles.h"
 
 namespace Persistence {
 class Settings;
@@ -122,6 +124,8 @@ public:
     QStringList cachedPlugins;
     QStringList foldersToScan;
     QStringList blackedPlugins;// vst in blackbox....
+    PluginScanCache scanCache; // all scanned files, including the invalid plugins
+    int scanProcesses; // parallel scanner processes, zero to use one process per CPU core
 };
 
 class AudioUnitSettings  : public SettingsObject
@@ -282,6 +286,18 @@ public:
     quint8 waveDrawingMode;
 };
 
+// ++++++++++++++++++++++++
+class ThreadsSettings : public SettingsObject
+{
+public:
+    ThreadsSettings();
+    void write(QJsonObject &out) const override;
+    void read(const QJsonObject &in) override;
+
+    ThreadRoles::Policy policies[ThreadRoles::RolesCount];
+    bool lockingMemory; // mlockall() in standalone, disabled by default
+};
+
 // ++++++++++++++++++++++++
 class Settings
 {
@@ -299,6 +315,7 @@ private:
     RecordingSettings recordingSettings;
     PrivateServerSettings privateServerSettings;
     MeteringSettings meteringSettings;
+    ThreadsSettings threadsSettings;
 
     QString lastUserName;// the last nick name choosed by user
     QString translation;// the translation language (en, fr, jp, pt, etc.) being used in chat
@@ -498,6 +515,19 @@ public:
     void removeVstScanPath(const QString &path);
     QStringList getVstScanFolders() const;
 
+    // VST scan cache
+    inline const PluginScanCache &getVstScanCache() const
+    {
+        return vstSettings.scanCache;
+    }
+
+    void setVstScanCache(const PluginScanCache &scanCache);
+
+    inline int getVstScanProcesses() const
+    {
+        return vstSettings.scanProcesses;
+    }
+
     // AU plugins
 #ifdef Q_OS_MAC
     void addAudioUnitPlugin(const QString &pluginPath);
@@ -603,6 +633,10 @@ public:
     inline void storeMeterOption(quint8 meterOption) { meteringSettings.meterOption = meterOption; }
     inline void storeMeterShowingMaxPeaks(bool showingMaxPeaks) { meteringSettings.showingMaxPeakMarkers = showingMaxPeaks; }
     inline void storeMeterRefreshRate(quint8 newRate) { meteringSettings.refreshRate = newRate; }
+
+    // threads
+    inline ThreadRoles::Policy getThreadPolicy(ThreadRoles::Role role) const { return threadsSettings.policies[role]; }
+    inline bool isLockingMemory() const { return threadsSettings.lockingMemory; }
 };
 }
 
@@ -4,6 +4,12 @@
 #include <QFile>
 #include <QStandardPaths>
 #include <QDataStream>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QVector>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
 #include "Configurator.h"
 #include "CacheHeader.h"
 
@@ -118,91 +124,332 @@ void CacheEntry::setGain(float gain)
     this->gain = gain;
 }
 
-UsersDataCache::UsersDataCache(const QDir &cacheDir)
-    :CACHE_FILE_NAME("tracks_cache.bin"),
-     cacheDir(cacheDir)
+const QString UsersDataCache::JOURNAL_FILE_NAME = "tracks_cache.journal";
+const QString UsersDataCache::OLD_CACHE_FILE_NAME = "tracks_cache.bin";
+const quint32 UsersDataCache::JOURNAL_REVISION = 1;
+const int UsersDataCache::RECORD_SIZE = 26; // key (8), last use (4), muted (1), low cut state (1), gain, pan and boost (3x4)
+const int UsersDataCache::HEADER_SIZE = 12; // CacheHeader size
+const int UsersDataCache::COMPACTION_SLACK = 1024;
+const quint32 UsersDataCache::TOUCH_RESOLUTION = 24 * 60 * 60; // one day
+
+const int UsersDataCache::DEFAULT_MAX_ENTRIES = 50000;
+const int UsersDataCache::DEFAULT_MAX_AGE_IN_DAYS = 365;
+
+UsersDataCache::UsersDataCache(const QDir &cacheDir, int maxEntries, int maxAgeInDays)
+    :cacheDir(cacheDir),
+     journal(cacheDir.absoluteFilePath(JOURNAL_FILE_NAME)),
+     journalRecords(0),
+     maxEntries(qMax(1, maxEntries)),
+     maxAgeInDays(qMax(1, maxAgeInDays))
 {
     //check if the tracks_cache_bin file is in the old dir and copy the file to the 'cache' dir.
     //This piece of code will be deleted in future versions.
     QDir baseDir = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
-    QFile oldCacheFile(baseDir.absoluteFilePath(CACHE_FILE_NAME));
+    QFile oldCacheFile(baseDir.absoluteFilePath(OLD_CACHE_FILE_NAME));
     if (oldCacheFile.exists()) {
-        if (oldCacheFile.rename(cacheDir.absoluteFilePath(CACHE_FILE_NAME)))
-            qDebug() << CACHE_FILE_NAME << " copyed to the new cache folder!";
+        if (oldCacheFile.rename(cacheDir.absoluteFilePath(OLD_CACHE_FILE_NAME)))
+            qDebug() << OLD_CACHE_FILE_NAME << " copyed to the new cache folder!";
         else
-            qDebug() << "Error when copying " << CACHE_FILE_NAME << " to the new cache folder!";
+            qDebug() << "Error when copying " << OLD_CACHE_FILE_NAME << " to the new cache folder!";
     }
 
-    loadCacheEntriesFromFile();
+    loadJournal();
+
+    importOldCacheFile();
+
+    if (needCompaction())
+        compactJournal();
 }
 
 UsersDataCache::~UsersDataCache()
 {
-    if (!cacheEntries.isEmpty())
-        writeCacheEntriesToFile();
+    if (journal.isOpen())
+        journal.close(); // all changes are already in the journal
 }
 
 CacheEntry UsersDataCache::getUserCacheEntry(const QString &userIp, const QString &userName,
                                              quint8 channelID)
 {
-    QString userUniqueKey = getUserUniqueKey(userIp, userName, channelID);
-    if (cacheEntries.contains(userUniqueKey))
-        return cacheEntries[userUniqueKey];
-    return CacheEntry(userIp, userName, channelID);// return a entry using default values for pan, gain, mute, etc.
+    CacheEntry entry(userIp, userName, channelID);
+
+    quint64 key = getUserUniqueKey(userIp, userName, channelID);
+    QHash<quint64, Record>::iterator it = records.find(key);
+    if (it == records.end())
+        return entry;// return a entry using default values for pan, gain, mute, etc.
+
+    Record &record = it.value();
+    entry.setMuted(record.muted);
+    entry.setGain(record.gain);
+    entry.setPan(record.pan);
+    entry.setBoost(record.boost);
+    entry.setLowCutState(record.lowCutState);
+
+    // remember the last use, the least recently used entries are discarded first
+    quint32 currentTime = now();
+    if (currentTime - record.lastUse >= TOUCH_RESOLUTION) {
+        record.lastUse = currentTime;
+        appendToJournal(key, record);
+    }
+
+    return entry;
 }
 
-void UsersDataCache::updateUserCacheEntry(CacheEntry entry)
+void UsersDataCache::updateUserCacheEntry(const CacheEntry &entry)
 {
-    QString userKey
-        = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
-    cacheEntries.insert(userKey, entry);// replace the last value or insert
+    Record record;
+    record.lastUse = now();
+    record.muted = entry.isMuted();
+    record.lowCutState = entry.getLowCutState();
+    record.gain = entry.getGain();
+    record.pan = entry.getPan();
+    record.boost = entry.getBoost();
+
+    quint64 key = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
+    records.insert(key, record);// replace the last value or insert
+
+    appendToJournal(key, record);
+
+    if (needCompaction())
+        compactJournal();
 }
 
-QString UsersDataCache::getUserUniqueKey(const QString &userIp, const QString &userName,
+quint64 UsersDataCache::getUserUniqueKey(const QString &userIp, const QString &userName,
                                          quint8 channelID)
 {
-    // the unique key is just a string...
-    return userIp + userName + QString::number(channelID);
+    // 64 bits FNV-1a hash, stable between Jamtaba versions and platforms
+    QByteArray data = userIp.toUtf8();
+    data.append('\0');
+    data.append(userName.toUtf8());
+    data.append('\0');
+    data.append(static_cast<char>(channelID));
+
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    for (char byte : data) {
+        hash ^= static_cast<quint8>(byte);
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
 }
 
-void UsersDataCache::loadCacheEntriesFromFile()
+quint32 UsersDataCache::now()
 {
-    // load tracks cache content from file
-    QFile cacheFile(cacheDir.absoluteFilePath(CACHE_FILE_NAME));
-    if (cacheFile.open(QFile::ReadOnly)) {
-        QDataStream stream(&cacheFile);
+    return QDateTime::currentDateTimeUtc().toTime_t();
+}
 
-        CacheHeader cacheHeader;
+void UsersDataCache::writeRecord(uchar *buffer, quint64 key, const Record &record)
+{
+    quint32 gain, pan, boost;
+    std::memcpy(&gain, &record.gain, sizeof(gain));
+    std::memcpy(&pan, &record.pan, sizeof(pan));
+    std::memcpy(&boost, &record.boost, sizeof(boost));
+
+    qToLittleEndian<quint64>(key, buffer);
+    qToLittleEndian<quint32>(record.lastUse, buffer + 8);
+    buffer[12] = record.muted ? 1 : 0;
+    buffer[13] = record.lowCutState;
+    qToLittleEndian<quint32>(gain, buffer + 14);
+    qToLittleEndian<quint32>(pan, buffer + 18);
+    qToLittleEndian<quint32>(boost, buffer + 22);
+}
+
+void UsersDataCache::readRecord(const uchar *buffer, quint64 &key, Record &record)
+{
+    key = qFromLittleEndian<quint64>(buffer);
+    record.lastUse = qFromLittleEndian<quint32>(buffer + 8);
+    record.muted = buffer[12] != 0;
+    record.lowCutState = buffer[13];
+
+    quint32 gain = qFromLittleEndian<quint32>(buffer + 14);
+    quint32 pan = qFromLittleEndian<quint32>(buffer + 18);
+    quint32 boost = qFromLittleEndian<quint32>(buffer + 22);
+    std::memcpy(&record.gain, &gain, sizeof(gain));
+    std::memcpy(&record.pan, &pan, sizeof(pan));
+    std::memcpy(&record.boost, &boost, sizeof(boost));
+}
+
+void UsersDataCache::loadJournal()
+{
+    records.clear();
+    journalRecords = 0;
+
+    QFile journalFile(journal.fileName());
+    if (!journalFile.open(QFile::ReadOnly))
+        return; // no journal yet
+
+    QByteArray content = journalFile.readAll();
+    journalFile.close();
+
+    CacheHeader cacheHeader;
+    {
+        QDataStream stream(content.left(HEADER_SIZE));
         stream >> cacheHeader;
-        quint32 expectedHeaderRevision = UsersDataCacheHeader::REVISION;
-        if (cacheHeader.isValid(expectedHeaderRevision))
-            stream >> cacheEntries;
+    }
+    if (!cacheHeader.isValid(JOURNAL_REVISION)) {
+        qCritical() << "Invalid cache header when loading users data cache.";
+        journalRecords = -1; // force the compaction, the invalid journal will be discarded
+        return;
+    }
+
+    const quint32 oldestAllowedUse = now() - maxAgeInDays * TOUCH_RESOLUTION;
+    const uchar *data = reinterpret_cast<const uchar *>(content.constData());
+    int validBytes = content.size() - HEADER_SIZE;
+    journalRecords = validBytes / RECORD_SIZE; // a partial record in the end (a crash while appending) is ignored
+    records.reserve(journalRecords);
+
+    for (int i = 0; i < journalRecords; ++i) {
+        quint64 key;
+        Record record;
+        readRecord(data + HEADER_SIZE + i * RECORD_SIZE, key, record);
+        if (record.lastUse >= oldestAllowedUse)
+            records.insert(key, record); // the last record for each key is the valid one
         else
-            qCritical() << "Invalid cache header when loading users data cache.";
+            records.remove(key);
+    }
 
-        qCDebug(jtCache) << "Tracks cache items loaded from file: " << cacheEntries.size();
+    if (validBytes % RECORD_SIZE != 0) {
+        qCWarning(jtCache) << "Discarding a partial record in the end of users data cache journal";
+        journalRecords = -1; // force the compaction to rewrite the file without the partial record
     }
+
+    qCDebug(jtCache) << "Tracks cache items loaded from journal: " << records.size();
 }
 
-void UsersDataCache::writeCacheEntriesToFile()
+bool UsersDataCache::needCompaction() const
 {
-    qCDebug(jtCache) << "Saving cache file";
+    if (journalRecords < 0) // invalid or truncated journal
+        return true;
 
-    QFile cacheFile(cacheDir.absoluteFilePath(CACHE_FILE_NAME));
-    if (cacheFile.open(QFile::WriteOnly)) {
-        qCDebug(jtCache) << "Tracks cache file opened to write.";
-        QDataStream stream(&cacheFile);
+    return records.size() > maxEntries || journalRecords > records.size() * 2 + COMPACTION_SLACK;
+}
 
-        CacheHeader cacheHeader(UsersDataCacheHeader::REVISION);
-        stream << cacheHeader;
+void UsersDataCache::compactJournal()
+{
+    if (journal.isOpen())
+        journal.close();
+
+    // retention policy: discard the least recently used entries when the cache is full. Some room is left
+    // for new entries, so the journal is not compacted again in the next update.
+    if (records.size() > maxEntries) {
+        int entriesToDrop = records.size() - (maxEntries - maxEntries / 10);
+
+        QVector<quint32> lastUses;
+        lastUses.reserve(records.size());
+        for (const Record &record : records)
+            lastUses.append(record.lastUse);
+
+        std::nth_element(lastUses.begin(), lastUses.begin() + entriesToDrop - 1, lastUses.end());
+        const quint32 newestDroppedUse = lastUses.at(entriesToDrop - 1);
+
+        // first pass drops the entries older than the threshold, the second pass the entries used exactly in the threshold
+        for (int pass = 0; pass < 2 && entriesToDrop > 0; ++pass) {
+            QHash<quint64, Record>::iterator it = records.begin();
+            while (it != records.end() && entriesToDrop > 0) {
+                quint32 lastUse = it.value().lastUse;
+                bool drop = pass == 0 ? lastUse < newestDroppedUse : lastUse == newestDroppedUse;
+                if (drop) {
+                    it = records.erase(it);
+                    entriesToDrop--;
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
 
-        stream << cacheEntries;
+    QByteArray content;
+    content.reserve(HEADER_SIZE + records.size() * RECORD_SIZE);
+    {
+        QDataStream stream(&content, QIODevice::WriteOnly);
+        stream << CacheHeader(JOURNAL_REVISION);
+    }
+    content.resize(HEADER_SIZE + records.size() * RECORD_SIZE);
 
-        qCDebug(jtCache) << cacheEntries.size() << " items stored in tracks cache file!";
+    uchar *data = reinterpret_cast<uchar *>(content.data()) + HEADER_SIZE;
+    for (QHash<quint64, Record>::const_iterator it = records.constBegin(); it != records.constEnd(); ++it) {
+        writeRecord(data, it.key(), it.value());
+        data += RECORD_SIZE;
+    }
+
+    QSaveFile saveFile(journal.fileName()); // the old journal is replaced only if the new one is fully written
+    if (saveFile.open(QFile::WriteOnly) && saveFile.write(content) == content.size() && saveFile.commit()) {
+        journalRecords = records.size();
+        qCDebug(jtCache) << "Users data cache journal compacted: " << records.size() << " items";
     } else {
-        qCritical() << "Can't open the tracks cache file in"
-                            << QFileInfo(cacheFile).absoluteFilePath();
+        qCritical() << "Can't compact the tracks cache journal in" << journal.fileName();
+    }
+}
+
+bool UsersDataCache::openJournalToAppend()
+{
+    if (journal.isOpen())
+        return true;
+
+    bool writeHeader = !journal.exists() || journal.size() < HEADER_SIZE;
+    QIODevice::OpenMode openMode = writeHeader ? QFile::WriteOnly : QFile::WriteOnly | QFile::Append;
+    if (!journal.open(openMode)) {
+        qCritical() << "Can't open the tracks cache journal in" << QFileInfo(journal).absoluteFilePath();
+        return false;
+    }
+
+    if (writeHeader) {
+        QDataStream stream(&journal);
+        stream << CacheHeader(JOURNAL_REVISION);
+        journalRecords = 0;
     }
+
+    return true;
 }
 
-// ++++++++++++++++++
+void UsersDataCache::appendToJournal(quint64 key, const Record &record)
+{
+    if (!openJournalToAppend())
+        return;
+
+    uchar buffer[RECORD_SIZE];
+    writeRecord(buffer, key, record);
+    if (journal.write(reinterpret_cast<const char *>(buffer), RECORD_SIZE) == RECORD_SIZE) {
+        journal.flush(); // the change is in the file even if Jamtaba crashes
+        journalRecords++;
+    }
+}
+
+void UsersDataCache::importOldCacheFile()
+{
+    // import the old tracks cache content (the full QMap was rewrited on exit). This piece of code will be deleted in future versions.
+    QFile cacheFile(cacheDir.absoluteFilePath(OLD_CACHE_FILE_NAME));
+    if (!cacheFile.open(QFile::ReadOnly))
+        return;
+
+    QMap<QString, CacheEntry> oldEntries;
+    {
+        QDataStream stream(&cacheFile);
+        CacheHeader cacheHeader;
+        stream >> cacheHeader;
+        if (cacheHeader.isValid(UsersDataCacheHeader::REVISION))
+            stream >> oldEntries;
+        else
+            qCritical() << "Invalid cache header when importing the old users data cache.";
+    }
+    cacheFile.close();
+
+    const quint32 currentTime = now();
+    for (const CacheEntry &entry : oldEntries) {
+        quint64 key = getUserUniqueKey(entry.getUserIP(), entry.getUserName(), entry.getChannelID());
+        if (records.contains(key))
+            continue;
+
+        Record record;
+        record.lastUse = currentTime;
+        record.muted = entry.isMuted();
+        record.lowCutState = entry.getLowCutState();
+        record.gain = entry.getGain();
+        record.pan = entry.getPan();
+        record.boost = entry.getBoost();
+        records.insert(key, record);
+    }
+
+    qCDebug(jtCache) << oldEntries.size() << " items imported from the old tracks cache file";
+
+    journalRecords = -1; // force the compaction to store the imported items
+    cacheFile.remove();
+}
@@ -3,8 +3,10 @@
 
 #include <QString>
 #include <QMap>
+#include <QHash>
 #include <QRegExp>
 #include <QDir>
+#include <QFile>
 
 /***
   This class is used to store/remember the users level, pan, mute and boost. When a user enter in the jam
@@ -97,28 +99,74 @@ private:
 };
 
 // ++++++++++++++++++++++++++++++++
+/***
+  The cache entries are stored in an append-only journal: each change is appended to the file as
+  a small fixed size record (keyed by a hash of user IP, user name and channel ID), so nothing is
+  lost if Jamtaba crashes. The journal is compacted when it contains too many stale records, and
+  the entries not used for a long time (or the least recently used, when the cache is full) are
+  dropped in the compaction.
+ */
 class UsersDataCache
 {
 public:
-    UsersDataCache(const QDir &cacheDir);
+    UsersDataCache(const QDir &cacheDir, int maxEntries = DEFAULT_MAX_ENTRIES, int maxAgeInDays = DEFAULT_MAX_AGE_IN_DAYS);
     ~UsersDataCache();
 
     // return default values for pan, gain and mute if user is not cached yet
     CacheEntry getUserCacheEntry(const QString &userIp, const QString &userName, quint8 channelID);
 
-    void updateUserCacheEntry(CacheEntry entry);
+    void updateUserCacheEntry(const CacheEntry &entry);
+
+    inline int size() const
+    {
+        return records.size();
+    }
+
+    static const int DEFAULT_MAX_ENTRIES;
+    static const int DEFAULT_MAX_AGE_IN_DAYS;
+
 private:
-    QMap<QString, CacheEntry> cacheEntries;
+    struct Record
+    {
+        quint32 lastUse; // seconds since epoch
+        bool muted;
+        quint8 lowCutState;
+        float gain;
+        float pan;
+        float boost;
+    };
+
+    QHash<quint64, Record> records;
 
     QDir cacheDir;
+    QFile journal;
+    int journalRecords; // valid and stale records stored in the journal file
+
+    int maxEntries;
+    int maxAgeInDays;
+
+    static quint64 getUserUniqueKey(const QString &userIp, const QString &userName, quint8 channelID);
+
+    void loadJournal();
+    void compactJournal();
+    bool openJournalToAppend();
+    void appendToJournal(quint64 key, const Record &record);
+    bool needCompaction() const;
+
+    void importOldCacheFile(); // used to import the cache content stored until the version 2.0.19
 
-    static QString getUserUniqueKey(const QString &userIp, const QString &userName,
-                                    quint8 channelID);
+    static void writeRecord(uchar *buffer, quint64 key, const Record &record);
+    static void readRecord(const uchar *buffer, quint64 &key, Record &record);
 
-    void loadCacheEntriesFromFile();
-    void writeCacheEntriesToFile();
+    static quint32 now();
 
-    const QString CACHE_FILE_NAME;
+    static const QString JOURNAL_FILE_NAME;
+    static const QString OLD_CACHE_FILE_NAME;
+    static const quint32 JOURNAL_REVISION;
+    static const int RECORD_SIZE;
+    static const int HEADER_SIZE;
+    static const int COMPACTION_SLACK; // stale records tolerated before compacting the journal
+    static const quint32 TOUCH_RESOLUTION; // the last use time is stored again only after this interval (in seconds)
 };
 }// namespace
 
@@ -3,6 +3,7 @@
 #include <QDebug>
 #include <QtConcurrent/QtConcurrent>
 #include "../log/Logging.h"
+#include "../performance/ThreadRoles.h"
 
 using namespace Recorder;
 
@@ -88,6 +89,8 @@ QString JamRecorder::getNewJamName() {
 
 void JamRecorder::writeEncodedFile(const QByteArray& encodedData, const QString &path){
 
+    ThreadRoles::applyToCurrentThread(ThreadRoles::Workers); // running in QtConcurrent pool
+
     QFile audioFile(path);
     if(!audioFile.open(QFile::WriteOnly)){
         qCritical() << "can't open file " << path;
@@ -56,11 +56,10 @@ void VstHost::setPlayingFlag(bool playing)
         clearVstTimeInfoFlags();
 }
 
-QList<Midi::MidiMessage> VstHost::pullReceivedMidiMessages()
+void VstHost::pullReceivedMidiMessages(Midi::MidiMessageBuffer &outBuffer)
 {
-    QList<Midi::MidiMessage> messages(receivedMidiMessages);
+    outBuffer.append(receivedMidiMessages);
     receivedMidiMessages.clear();
-    return messages;
 }
 
 void VstHost::setPositionInSamples(int intervalPosition)
@@ -199,13 +198,17 @@ long VSTCALLBACK VstHost::hostCallback(AEffect *effect, long opcode, long index,
                 if (vstEvents->events[i]->type == kVstMidiType) {
                     VstMidiEvent *vstMidiEvent = (VstMidiEvent *)vstEvents->events[i];
                     Midi::MidiMessage msg = Midi::MidiMessage::fromArray(vstMidiEvent->midiData);
-                    hostInstance->receivedMidiMessages.append(msg);
+                    msg.setFrameOffset(vstMidiEvent->deltaFrames);
+                    hostInstance->receivedMidiMessages.addMessage(msg);
                 }
             }
         }
         return 1L;
     }
 
+    case audioMasterIOChanged:// 13 - plugin latency (initialDelay) changed, the new value is used in the next audio callback
+        return 1L;
+
     case audioMasterUpdateDisplay:// 42
         //QCoreApplication::processEvents();  crashing in MAC
         return 1L;
@@ -30,7 +30,7 @@ public:
         return blockSize;
     }
 
-    QList<Midi::MidiMessage> pullReceivedMidiMessages() override;
+    void pullReceivedMidiMessages(Midi::MidiMessageBuffer &outBuffer) override;
 
     void setSampleRate(int sampleRate) override;
     void setBlockSize(int blockSize) override;
@@ -51,17 +51,16 @@ public:
 
     Persistence::Preset loadPreset(const QString &name) override;
 
-    inline Midi::MidiMessageBuffer pullMidiMessagesFromPlugins() override
+    inline void pullMidiMessagesFromPlugins(Midi::MidiMessageBuffer &outBuffer) override
     {
-        static Midi::MidiMessageBuffer emptyBuffer(0);
-        return emptyBuffer;
+        Q_UNUSED(outBuffer)
     }
 
 protected:
-    inline Midi::MidiMessageBuffer pullMidiMessagesFromDevices() override
+    inline void pullMidiMessagesFromDevices(Midi::MidiMessageBuffer &outBuffer, int audioBlockFrames) override
     {
-        static Midi::MidiMessageBuffer emptyBuffer(0);
-        return emptyBuffer;
+        Q_UNUSED(outBuffer)
+        Q_UNUSED(audioBlockFrames)
     }
 
     JamTabaPlugin *plugin;
@@ -41,8 +41,24 @@ Audio::PluginDescriptor VstPluginScanner::getPluginDescriptor(const QFileInfo &p
     return Audio::PluginDescriptor();// invalid descriptor
 }
 
+void VstPluginScanner::scanPlugin(const QFileInfo &pluginFileInfo)
+{
+    writeToProcessOutput("JT-Scanner-Scanning: "+ pluginFileInfo.absoluteFilePath());
+    auto descriptor = getPluginDescriptor(pluginFileInfo);
+    if (descriptor.isValid())
+        writeToProcessOutput("JT-Scanner-Scan-Finished: " + descriptor.getPath());
+}
+
 void VstPluginScanner::scan()
 {
+    if (!pluginsToScan.isEmpty()) {
+        writeToProcessOutput("JT-Scanner-Starting");
+        foreach (const QString &pluginPath, pluginsToScan)
+            scanPlugin(QFileInfo(pluginPath));
+        writeToProcessOutput("JT-Scanner-Finished");
+        return;
+    }
+
     if (foldersToScan.isEmpty()) {
         qCInfo(jtStandalonePluginFinder) << "Folders to scan is empty!";
         return;
@@ -61,12 +77,8 @@ void VstPluginScanner::scan()
 
             if (!skipList.contains(pluginFileInfo.absoluteFilePath()))
             {
-                if (canScan(pluginFileInfo)) {
-                    writeToProcessOutput("JT-Scanner-Scanning: "+ pluginFileInfo.absoluteFilePath());
-                    auto descriptor = getPluginDescriptor(pluginFileInfo);
-                    if (descriptor.isValid())
-                        writeToProcessOutput("JT-Scanner-Scan-Finished: " + descriptor.getPath());
-                }
+                if (canScan(pluginFileInfo))
+                    scanPlugin(pluginFileInfo);
             }
         }
     }
@@ -87,7 +99,8 @@ void VstPluginScanner::initialize(int argc, char *argv[])
 {
     /**
      The first arg is always the executable path. We need at least the folders strinb (2nd arg).
-     The blacklist can be empty.
+     The blacklist can be empty. When the 2nd arg is '--plugins' the 3rd arg is the list of plugin
+     files to scan, used when Jamtaba is scanning the plugins in parallel processes.
     */
 
     qCInfo(jtStandalonePluginFinder) << "Initializing scan folders list and blackList!";
@@ -95,6 +108,12 @@ void VstPluginScanner::initialize(int argc, char *argv[])
     if (argc < 2)
         return;
 
+    if (QString::fromUtf8(argv[1]) == "--plugins") {
+        if (argc > 2)
+            this->pluginsToScan = QString::fromUtf8(argv[2]).split(";", QString::SkipEmptyParts);
+        return;
+    }
+
     QString foldersString = QString::fromUtf8(argv[1]);
 
     if (!foldersString.isEmpty())
@@ -14,11 +14,14 @@ private:
 
     QStringList foldersToScan;
     QStringList skipList; //contain blackListed and cached plugins
+    QStringList pluginsToScan; // plugin files passed by Jamtaba when the plugins are scanned in parallel processes
 
     void initialize(int argc, char *argv[]) override;
 
     Audio::PluginDescriptor getPluginDescriptor(const QFileInfo &pluginFile);
 
+    void scanPlugin(const QFileInfo &pluginFileInfo);
+
 protected:
 
     void scan() override;
@@ -27,9 +27,9 @@ AudioUnitHost::AudioUnitHost()
 
 }
 
-QList<Midi::MidiMessage> AudioUnitHost::pullReceivedMidiMessages()
+void AudioUnitHost::pullReceivedMidiMessages(Midi::MidiMessageBuffer &outBuffer)
 {
-    return QList<Midi::MidiMessage>();
+    Q_UNUSED(outBuffer)
 }
 
 void AudioUnitHost::setSampleRate(int sampleRate)
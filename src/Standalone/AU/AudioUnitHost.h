@@ -17,7 +17,7 @@ public:
     int getSampleRate() const override;
     int getBufferSize() const override;
 
-    QList<Midi::MidiMessage> pullReceivedMidiMessages() override;
+    void pullReceivedMidiMessages(Midi::MidiMessageBuffer &outBuffer) override;
 
     void setSampleRate(int sampleRate) override;
     void setBlockSize(int blockSize) override;
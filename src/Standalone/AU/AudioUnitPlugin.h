@@ -32,7 +32,7 @@ namespace AU {
         void setSampleRate(int newSampleRate) override;
 
         void process(const Audio::SamplesBuffer &inBuffer, Audio::SamplesBuffer &outBuffer,
-                             const QList<Midi::MidiMessage> &midiBuffer) override;
+                             const Midi::MidiMessageBuffer &midiBuffer) override;
 
         void suspend() override;
         void resume() override;
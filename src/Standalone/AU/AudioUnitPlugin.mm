@@ -406,7 +406,7 @@ OSStatus AudioUnitPlugin::inputCallback (void* hostRef, AudioUnitRenderActionFla
 }
 
 void AudioUnitPlugin::process(const Audio::SamplesBuffer &inBuffer, Audio::SamplesBuffer &outBuffer,
-                     const QList<Midi::MidiMessage> &midiBuffer)
+                     const Midi::MidiMessageBuffer &midiBuffer)
 {
 
     AudioUnitRenderActionFlags flags = 0;
@@ -415,23 +415,28 @@ void AudioUnitPlugin::process(const Audio::SamplesBuffer &inBuffer, Audio::Sampl
 
     if (!bufferList) {
         qCritical() << "Buffer list is null";
+        outBuffer.set(inBuffer);
         return;
     }
 
     currentInputBuffer = &inBuffer;
 
+    // the insert chain buffer is used as AU output when the channels are matching, avoiding a copy
+    bool usingChainOutput = static_cast<int>(bufferList->mNumberBuffers) == outBuffer.getChannels();
+    Audio::SamplesBuffer &renderBuffer = usingChainOutput ? outBuffer : internalOutBuffer;
+
     // prepare the output AudioBufferList
-    quint8 channels = qMin(static_cast<int>(bufferList->mNumberBuffers), internalOutBuffer.getChannels());
+    quint8 channels = qMin(static_cast<int>(bufferList->mNumberBuffers), renderBuffer.getChannels());
     for (quint8 i = 0; i < channels; i++) {
         bufferList->mBuffers[i].mNumberChannels = 1; // each buffer contain one audio channel (left or right, for example)
         bufferList->mBuffers[i].mDataByteSize = (UInt32) (sizeof (float) * (size_t) frames);
-        bufferList->mBuffers[i].mData = internalOutBuffer.getSamplesArray(i);
+        bufferList->mBuffers[i].mData = renderBuffer.getSamplesArray(i);
     }
 
     if (wantsMidiMessages && !midiBuffer.isEmpty())
     {
-        UInt32 midiEventPosition = 0; // in jamtaba all MIDI messages are real time
         for (const Midi::MidiMessage &message : midiBuffer) {
+            UInt32 midiEventPosition = message.getFrameOffset(); // sample accurate position inside the audio block
             MusicDeviceMIDIEvent(audioUnit, message.getStatus(), message.getData1(),
                                                             message.getData2(), midiEventPosition);
         }
@@ -442,6 +447,7 @@ void AudioUnitPlugin::process(const Audio::SamplesBuffer &inBuffer, Audio::Sampl
 
     if (status != noErr) {
         qWarning() << "Error rendering audio unit " << getName() << " OSStatus: " << status;
+        outBuffer.set(inBuffer);
         return;
     }
 
@@ -455,9 +461,15 @@ void AudioUnitPlugin::process(const Audio::SamplesBuffer &inBuffer, Audio::Sampl
     */
 
     if(isVirtualInstrument()){
-        outBuffer.add(internalOutBuffer);// AUi add and preserve the last generated output samples
+        if (usingChainOutput) {
+            outBuffer.add(inBuffer);// AUi add and preserve the last generated output samples
+        }
+        else {
+            outBuffer.set(inBuffer);
+            outBuffer.add(internalOutBuffer);
+        }
     }
-    else{
+    else if (!usingChainOutput) {
         outBuffer.set(internalOutBuffer);// AUs are replacing
     }
 
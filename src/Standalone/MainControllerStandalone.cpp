@@ -3,6 +3,9 @@
     #include "midi/RtMidiDriver.h"
     #include "midi/MidiMessage.h"
     #include "audio/PortAudioDriver.h"
+    #ifdef JT_JACK_DRIVER
+        #include "audio/JackAudioDriver.h"
+    #endif
     #include "audio/core/LocalInputNode.h"
     #include "vst/VstPlugin.h"
     #include "vst/VstHost.h"
@@ -31,6 +34,8 @@
     #include <QtConcurrent/QtConcurrent>
     #include "log/Logging.h"
     #include "Configurator.h"
+    #include "StartupTimeline.h"
+    #include "performance/ThreadRoles.h"
 
     using namespace Controller;
 
@@ -322,6 +327,11 @@
         }
     }
 
+    void MainControllerStandalone::updateVstScanCache()
+    {
+        settings.setVstScanCache(vstPluginFinder->getScanCache());
+    }
+
 #ifdef Q_OS_MAC
     void MainControllerStandalone::addFoundedAudioUnitPlugin(const QString &name, const QString &path)
     {
@@ -362,6 +372,22 @@
     Audio::AudioDriver *MainControllerStandalone::createAudioDriver(
         const Persistence::Settings &settings)
     {
+    #ifdef JT_JACK_DRIVER
+        // using JACK directly when the JACK server is running, PortAudio (ALSA) is used otherwise
+        Audio::JackAudioDriver *jackDriver = new Audio::JackAudioDriver(
+            this,
+            settings.getFirstGlobalAudioInput(),
+            settings.getLastGlobalAudioInput(),
+            settings.getFirstGlobalAudioOutput(),
+            settings.getLastGlobalAudioOutput()
+            );
+        if (jackDriver->isConnected())
+            return jackDriver;
+
+        qCInfo(jtCore) << "JACK server is not running, using PortAudio";
+        delete jackDriver;
+    #endif
+
         return new Audio::PortAudioDriver(
             this,
             settings.getLastAudioDevice(),
@@ -404,11 +430,23 @@
     {
         // creating audio and midi driver before call start() in base class (MainController::start())
 
+        // midi devices are enumerated in a worker thread while the audio driver is created. CoreMidi clients need the main thread run loop in Mac.
+        QFuture<void> midiDriverCreation;
         if (!midiDriver) {
             qCInfo(jtCore) << "Creating midi driver...";
-            midiDriver.reset(createMidiDriver());
+            auto createMidi = [this]{
+                StartupPhase phase("Creating midi driver");
+                midiDriver.reset(createMidiDriver());
+            };
+    #ifndef Q_OS_MAC
+            if (StartupTimeline::isParallelStartup())
+                midiDriverCreation = QtConcurrent::run(createMidi);
+            else
+    #endif
+                createMidi();
         }
         if (!audioDriver) {
+            StartupPhase phase("Creating audio driver");
             qCInfo(jtCore) << "Creating audio driver...";
             Audio::AudioDriver *driver = nullptr;
             try{
@@ -430,9 +468,16 @@
             QObject::connect(audioDriver.data(), SIGNAL(started()), this, SLOT(on_audioDriverStarted()));
         }
 
+        midiDriverCreation.waitForFinished();
+
         //calling the base class
         MainController::start();
 
+        // the process and the main thread are changed only in standalone, in the plugin they are owned by the host
+        if (settings.isLockingMemory())
+            ThreadRoles::lockMemory();
+        ThreadRoles::applyToCurrentThread(ThreadRoles::Gui);
+
         if (audioDriver) {
             if (!audioDriver->canBeStarted())
                 useNullAudioDriver();
@@ -453,6 +498,9 @@
         connect(vstPluginFinder.data(), &audio::VSTPluginFinder::pluginScanFinished, this,
                                                     &MainControllerStandalone::addFoundedVstPlugin);
 
+        connect(vstPluginFinder.data(), &audio::VSTPluginFinder::scanFinished, this,
+                                                    &MainControllerStandalone::updateVstScanCache);
+
         if (audioDriver) {
             for(Host *host : hosts) {
                 host->setSampleRate(audioDriver->getSampleRate());
@@ -586,13 +634,16 @@
         QStringList skipList(settings.getBlackListedPlugins());
         skipList.append(settings.getVstPluginsPaths());
 
+        const Persistence::PluginScanCache &scanCache = settings.getVstScanCache();
+
         bool newVstFounded = false;
         foreach (const QString &scanFolder, foldersToScan) {
             QDirIterator folderIterator(scanFolder, QDir::AllDirs | QDir::NoDotAndDotDot,  QDirIterator::Subdirectories);
             while (folderIterator.hasNext()) {
                 folderIterator.next();// point to next file inside current folder
                 QString filePath = folderIterator.filePath();
-                if (!skipList.contains(filePath) && Vst::PluginChecker::isValidPluginFile(filePath)) {
+                if (!skipList.contains(filePath) && !scanCache.isUpToDate(folderIterator.fileInfo())
+                        && Vst::PluginChecker::isValidPluginFile(filePath)) {
                      newVstFounded = true;
                      break;
                 }
@@ -673,6 +724,10 @@
             if (scanOnlyNewPlugins)
                 skipList.append(settings.getVstPluginsPaths());
 
+            // unchanged files in the scan cache are not scanned again, even when all plugins are scanned
+            vstPluginFinder->setScanCache(settings.getVstScanCache());
+            vstPluginFinder->setMaxScanProcesses(settings.getVstScanProcesses());
+
             QStringList foldersToScan = settings.getVstScanFolders();
             vstPluginFinder->scan(foldersToScan, skipList);
         }
@@ -707,26 +762,17 @@
         application->quit();
     }
 
-    Midi::MidiMessageBuffer MainControllerStandalone::pullMidiMessagesFromPlugins()
+    void MainControllerStandalone::pullMidiMessagesFromPlugins(Midi::MidiMessageBuffer &outBuffer)
     {
-        // return midi messages created by vst and AU plugins, not by midi controllers.
-        QList<Midi::MidiMessage> receivedMidiMessages;
+        // append midi messages created by vst and AU plugins, not by midi controllers.
         for(Host *host : hosts)
-            receivedMidiMessages.append(host->pullReceivedMidiMessages());
-
-        Midi::MidiMessageBuffer midiBuffer(receivedMidiMessages.count());
-        foreach (const Midi::MidiMessage &vstMidiMessage, receivedMidiMessages) {
-            midiBuffer.addMessage(vstMidiMessage);
-        }
-        return midiBuffer;
+            host->pullReceivedMidiMessages(outBuffer);
     }
 
-    Midi::MidiMessageBuffer MainControllerStandalone::pullMidiMessagesFromDevices()
+    void MainControllerStandalone::pullMidiMessagesFromDevices(Midi::MidiMessageBuffer &outBuffer, int audioBlockFrames)
     {
-        if (!midiDriver)
-            return Midi::MidiMessageBuffer(0);
-
-        return Midi::MidiMessageBuffer(midiDriver->getBuffer());
+        if (midiDriver)
+            midiDriver->pullMessages(outBuffer, audioBlockFrames);
     }
 
     bool MainControllerStandalone::isUsingNullAudioDriver() const
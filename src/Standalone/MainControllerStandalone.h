@@ -92,7 +92,7 @@ public:
     QMap<QString, QList<Audio::PluginDescriptor> > getPluginsDescriptors(Audio::PluginDescriptor::Category category);
     Audio::Plugin *addPlugin(quint32 inputTrackIndex, quint32 pluginSlotIndex, const Audio::PluginDescriptor &descriptor);
 
-    Midi::MidiMessageBuffer pullMidiMessagesFromPlugins() override;
+    void pullMidiMessagesFromPlugins(Midi::MidiMessageBuffer &outBuffer) override;
 
 public slots:
     void setSampleRate(int newSampleRate) override;
@@ -121,7 +121,7 @@ protected:
 
     void setupNinjamControllerSignals() override;
 
-    Midi::MidiMessageBuffer pullMidiMessagesFromDevices() override;
+    void pullMidiMessagesFromDevices(Midi::MidiMessageBuffer &outBuffer, int audioBlockFrames) override;
 
 protected slots:
     void updateBpm(int newBpm) override;
@@ -136,6 +136,7 @@ protected slots:
     void on_ninjamStartProcessing(int intervalPosition) ;
 
     void addFoundedVstPlugin(const QString &name, const QString &path);
+    void updateVstScanCache();
 #ifdef Q_OS_MAC
     void addFoundedAudioUnitPlugin(const QString &name, const QString &path);
 #endif
@@ -2,91 +2,301 @@
 #include "audio/core/PluginDescriptor.h"
 #include "log/Logging.h"
 
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QSet>
+
 using namespace audio;
 
+const int PluginFinder::PLUGINS_PER_PROCESS = 8;
+const int PluginFinder::MAX_SCAN_PROCESSES = 16;
+const qint64 PluginFinder::SLOW_PLUGIN_SCAN_TIME = 3000; // in milliseconds
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-void PluginFinder::finishScan()
+
+class PluginFinder::ScanWorker
 {
-    QProcess::ExitStatus exitStatus = scanProcess.exitStatus();
-    scanProcess.close();
-    bool exitingWithoutError = exitStatus == QProcess::NormalExit;
+public:
+    explicit ScanWorker(QObject *parent) :
+        process(new QProcess(parent)),
+        currentPluginIsValid(false)
+    {
+    }
 
-    qCDebug(jtStandalonePluginFinder) << "Closing scan process! exited without error:" << exitingWithoutError;
+    QProcess *process;
+    QStringList pluginsToScan; // plugins in this process batch not started yet
+    QString currentPlugin; // used to recover the plugin path when the scanner process crash
+    bool currentPluginIsValid;
+    QElapsedTimer currentPluginTimer;
+};
 
-    emit scanFinished(exitingWithoutError);
-    QString lastScanned(lastScannedPlugin);
-    lastScannedPlugin.clear();
-    if (!exitingWithoutError)
-        handleProcessError(lastScanned);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+PluginFinder::PluginFinder() :
+    maxScanProcesses(1),
+    scanning(false),
+    canceled(false),
+    finishedWithoutError(true)
+{
+    setMaxScanProcesses(0);
 }
 
-void PluginFinder::handleScanError(QProcess::ProcessError error)
+PluginFinder::~PluginFinder()
 {
-    qCritical() << error << scanProcess.errorString();
-    finishScan();
+    for (ScanWorker *worker : workers) {
+        QObject::disconnect(worker->process, nullptr, this, nullptr);
+        delete worker->process; // the scanner process is killed
+        delete worker;
+    }
+    workers.clear();
 }
 
-void PluginFinder::handleProcessError(const QString &lastScannedPlugin)
+void PluginFinder::setMaxScanProcesses(int maxProcesses)
 {
-    if (!lastScannedPlugin.isEmpty())
-        emit badPluginDetected(lastScannedPlugin);
+    if (maxProcesses <= 0)
+        maxProcesses = QThread::idealThreadCount();
+
+    maxScanProcesses = qBound(1, maxProcesses, MAX_SCAN_PROCESSES);
 }
 
-void PluginFinder::consumeOutputFromScanProcess()
+void PluginFinder::setScanCache(const Persistence::PluginScanCache &scanCache)
 {
-    QByteArray readedData = scanProcess.readAll();
-    QTextStream stream(readedData, QIODevice::ReadOnly);
-    while (!stream.atEnd()) {
-        QString readedLine = stream.readLine();
-        if (!readedLine.isNull() && !readedLine.isEmpty()) {
-            bool startScanning = readedLine.startsWith("JT-Scanner-Scanning:");
-            bool finishedScanning = readedLine.startsWith("JT-Scanner-Scan-Finished");
-            if (startScanning)
-                handleScanningStart(readedLine);
-            else if(finishedScanning)
-                handleScanningFinished(readedLine);
-        }
-    }
+    this->scanCache = scanCache;
+}
+
+bool PluginFinder::isScanning() const
+{
+    return scanning;
 }
 
+bool PluginFinder::canScanInParallel() const
+{
+    return false;
+}
+
+bool PluginFinder::isPluginFile(const QFileInfo &file) const
+{
+    return file.isFile();
+}
+
+QString PluginFinder::getPluginName(const QString &pluginPath) const
+{
+    return QFileInfo(pluginPath).baseName();
+}
 
 void PluginFinder::scan(const QStringList &scanFolders, const QStringList &skipList)
 {
-    if (scanProcess.isOpen()) {
+    if (scanning) {
         qCritical() << "scan process is already open!";
         return;
     }
 
-    QString scannerExePath = getScannerExecutablePath();
+    scannerExePath = getScannerExecutablePath();
     if (scannerExePath.isEmpty())
         return;// scanner executable not found!
 
+    scanning = true;
+    canceled = false;
+    finishedWithoutError = true;
+
     emit scanStarted();
-    // execute the scanner in another process to avoid crash Jamtaba process
-    QStringList parameters;
-    parameters.append(buildCommaSeparatedString(scanFolders));
-    parameters.append(buildCommaSeparatedString(skipList));
-    QObject::connect(&scanProcess, SIGNAL(readyReadStandardOutput()), this,
-                     SLOT(consumeOutputFromScanProcess()));
-    QObject::connect(&scanProcess, SIGNAL(finished(int)), this, SLOT(finishScan()));
-    QObject::connect(&scanProcess, SIGNAL(error(QProcess::ProcessError)), this,
-                     SLOT(handleScanError(QProcess::ProcessError)));
-
-    scanProcess.start(scannerExePath, parameters);
+
+    // execute the scanner in other processes to avoid crash Jamtaba process
+    if (canScanInParallel()) {
+        pendingPlugins = findPluginsToScan(scanFolders, skipList);
+        qCDebug(jtStandalonePluginFinder) << pendingPlugins.size() << "plugins to scan using" << maxScanProcesses << "processes";
+        startWorkers();
+    }
+    else {
+        QStringList parameters;
+        parameters.append(buildCommaSeparatedString(scanFolders));
+        parameters.append(buildCommaSeparatedString(skipList));
+        startWorker(parameters, QStringList());
+    }
+
+    finishScanIfDone(); // nothing to scan?
+}
+
+QStringList PluginFinder::findPluginsToScan(const QStringList &scanFolders, const QStringList &skipList)
+{
+    QSet<QString> skippedPlugins = skipList.toSet();
+    QSet<QString> foundPlugins;
+    QStringList pluginsToScan;
+    foreach (const QString &scanFolder, scanFolders) {
+        QDirIterator folderIterator(scanFolder, QDir::AllEntries | QDir::NoDotAndDotDot | QDir::NoSymLinks, QDirIterator::Subdirectories);
+        while (folderIterator.hasNext()) {
+            folderIterator.next();// point to next file inside current folder
+            QFileInfo pluginFile = folderIterator.fileInfo();
+            QString pluginPath = pluginFile.absoluteFilePath();
+            if (foundPlugins.contains(pluginPath) || skippedPlugins.contains(pluginPath) || !isPluginFile(pluginFile))
+                continue;
+
+            foundPlugins.insert(pluginPath);
+
+            if (scanCache.isUpToDate(pluginFile)) { // unchanged files are not scanned again
+                if (scanCache.isValidPlugin(pluginPath))
+                    emit pluginScanFinished(getPluginName(pluginPath), pluginPath);
+                continue;
+            }
+
+            pluginsToScan.append(pluginPath);
+        }
+    }
+    return pluginsToScan;
+}
+
+void PluginFinder::startWorkers()
+{
+    while (workers.size() < maxScanProcesses && !pendingPlugins.isEmpty()) {
+        // small batches when we have few plugins, so all processes are used
+        int batchSize = (pendingPlugins.size() + maxScanProcesses - 1) / maxScanProcesses;
+        batchSize = qBound(1, batchSize, PLUGINS_PER_PROCESS);
+
+        QStringList batch = pendingPlugins.mid(0, batchSize);
+        pendingPlugins = pendingPlugins.mid(batchSize);
+
+        QStringList parameters;
+        parameters.append("--plugins");
+        parameters.append(buildCommaSeparatedString(batch));
+        startWorker(parameters, batch);
+    }
+}
+
+void PluginFinder::startWorker(const QStringList &parameters, const QStringList &pluginsToScan)
+{
+    ScanWorker *worker = new ScanWorker(this);
+    worker->pluginsToScan = pluginsToScan;
+    workers.append(worker);
+
+    QProcess *process = worker->process;
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, worker]() {
+        consumeOutputFromWorker(worker);
+    });
+
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished), this,
+            [this, worker](int exitCode, QProcess::ExitStatus exitStatus) {
+        Q_UNUSED(exitCode);
+        finishWorker(worker, exitStatus != QProcess::NormalExit);
+    });
+
+    connect(process, static_cast<void (QProcess::*)(QProcess::ProcessError)>(&QProcess::error), this,
+            [this, worker](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart)
+            return; // crashes are handled when the process is finished
+
+        qCritical() << error << worker->process->errorString();
+        finishedWithoutError = false;
+        pendingPlugins.clear(); // the other processes will fail too
+        finishWorker(worker, false);
+    });
+
+    process->start(scannerExePath, parameters);
     qCDebug(jtStandalonePluginFinder) << "Scan process started with " << scannerExePath
-                                          << " (PID: " << scanProcess.processId() << ")";
+                                          << " (PID: " << process->processId() << ")";
 }
 
-void PluginFinder::cancel()
+void PluginFinder::consumeOutputFromWorker(ScanWorker *worker)
 {
-    if (!scanProcess.atEnd()) {
-        qCDebug(jtStandalonePluginFinder) << "Terminating scan process!";
-        scanProcess.terminate();
-        qDebug() << "process closed";
+    QProcess *process = worker->process;
+    while (process->canReadLine()) { // incomplete lines are consumed in the next call
+        QString readedLine = QString::fromUtf8(process->readLine()).trimmed();
+        if (readedLine.isEmpty())
+            continue;
+
+        if (readedLine.startsWith("JT-Scanner-Scanning:")) {
+            finishPluginScan(worker); // the previous plugin in this process
+            worker->currentPlugin = readedLine.section(": ", 1);
+            worker->currentPluginIsValid = false;
+            worker->currentPluginTimer.start();
+            worker->pluginsToScan.removeOne(worker->currentPlugin);
+            handleScanningStart(readedLine);
+        }
+        else if (readedLine.startsWith("JT-Scanner-Scan-Finished")) {
+            worker->currentPluginIsValid = true;
+            handleScanningFinished(readedLine);
+        }
+        else if (readedLine.startsWith("JT-Scanner-Finished")) {
+            finishPluginScan(worker);
+        }
     }
 }
 
+void PluginFinder::finishPluginScan(ScanWorker *worker)
+{
+    if (worker->currentPlugin.isEmpty())
+        return;
+
+    qint64 scanTime = worker->currentPluginTimer.elapsed();
+    if (canScanInParallel()) // only plugin files are cached
+        scanCache.update(QFileInfo(worker->currentPlugin), worker->currentPluginIsValid, scanTime);
+
+    if (scanTime >= SLOW_PLUGIN_SCAN_TIME)
+        qCWarning(jtStandalonePluginFinder) << "Slow plugin, scanned in" << scanTime << "ms:" << worker->currentPlugin;
+    else
+        qCDebug(jtStandalonePluginFinder) << "Plugin scanned in" << scanTime << "ms:" << worker->currentPlugin;
+
+    worker->currentPlugin.clear();
+}
+
+void PluginFinder::finishWorker(ScanWorker *worker, bool crashed)
+{
+    if (!workers.removeOne(worker))
+        return; // already finished
+
+    consumeOutputFromWorker(worker);
+    worker->process->close();
+
+    qCDebug(jtStandalonePluginFinder) << "Closing scan process! exited without error:" << !crashed;
+
+    if (crashed && !canceled) {
+        finishedWithoutError = false;
+        if (!worker->currentPlugin.isEmpty()) {
+            emit badPluginDetected(worker->currentPlugin); // crashed plugins are not cached
+            worker->currentPlugin.clear();
+
+            // the remaining plugins in the batch are scanned by another process
+            pendingPlugins = worker->pluginsToScan + pendingPlugins;
+        }
+        else if (!worker->pluginsToScan.isEmpty()) {
+            qCritical() << "Scanner process crashed before scan the plugins:" << worker->pluginsToScan;
+        }
+    }
+    else {
+        finishPluginScan(worker);
+    }
+
+    worker->process->deleteLater(); // we are inside a process signal
+    delete worker;
+
+    if (!canceled)
+        startWorkers();
+
+    finishScanIfDone();
+}
+
+void PluginFinder::finishScanIfDone()
+{
+    if (!scanning || !workers.isEmpty())
+        return;
+
+    scanning = false;
+    pendingPlugins.clear();
+    emit scanFinished(finishedWithoutError && !canceled);
+}
+
+void PluginFinder::cancel()
+{
+    if (!scanning)
+        return;
+
+    qCDebug(jtStandalonePluginFinder) << "Terminating scan processes!";
+    canceled = true;
+    pendingPlugins.clear();
+    for (ScanWorker *worker : workers)
+        worker->process->terminate();
+}
+
 QString PluginFinder::buildCommaSeparatedString(const QStringList &list) const
 {
     QString folderString;
@@ -97,4 +307,3 @@ QString PluginFinder::buildCommaSeparatedString(const QStringList &list) const
     }
     return folderString;
 }
-
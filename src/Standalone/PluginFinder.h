@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QProcess>
 #include <QFileInfo>
+#include <QStringList>
+#include "persistence/PluginScanCache.h"
 
 namespace Audio {
 class PluginDescriptor;
@@ -11,31 +13,47 @@ class PluginDescriptor;
 
 namespace audio {
 
+/***
+  Plugins are scanned in external processes to avoid crash Jamtaba process. When the subclass can
+  scan files in parallel the plugin files found in scan folders are distributed between a pool
+  of scanner processes, each process is scanning a small batch of plugins. A plugin crashing the
+  scanner is reported with badPluginDetected and the other plugins in the batch are scanned by
+  another process. Unchanged files in the scan cache are not scanned again.
+ */
 class PluginFinder : public QObject
 {
     Q_OBJECT
 
 public:
+    PluginFinder();
+    virtual ~PluginFinder();
+
     void scan(const QStringList &foldersToScan = QStringList(), const QStringList &skipList = QStringList());
     void cancel();
 
-protected:
-    QProcess scanProcess;
-    QString lastScannedPlugin;
+    bool isScanning() const;
+
+    void setMaxScanProcesses(int maxProcesses); // zero or negative values to use one process per CPU core
 
+    void setScanCache(const Persistence::PluginScanCache &scanCache);
+
+    inline const Persistence::PluginScanCache &getScanCache() const
+    {
+        return scanCache;
+    }
+
+protected:
     virtual QString getScannerExecutablePath() const = 0;
 
-    void handleProcessError(const QString &lastScannedPlugin);
+    // when 'false' the folders are scanned by just one process, the scanner is searching the plugins (Audio Units are not files)
+    virtual bool canScanInParallel() const;
+    virtual bool isPluginFile(const QFileInfo &file) const;
+    virtual QString getPluginName(const QString &pluginPath) const;
 
     virtual void handleScanningStart(const QString &scannedLine) = 0;
     virtual void handleScanningFinished(const QString &scannedLine) = 0;
 
-     QString buildCommaSeparatedString(const QStringList &list) const;
-
-protected slots:
-    void consumeOutputFromScanProcess();
-    void finishScan();
-    void handleScanError(QProcess::ProcessError);
+    QString buildCommaSeparatedString(const QStringList &list) const;
 
 signals:
     void scanStarted();
@@ -44,6 +62,31 @@ signals:
     void pluginScanFinished(const QString &name, const QString &path);
     void badPluginDetected(const QString &pluginPath);// a plugin crashed the scanner process
 
+private:
+    class ScanWorker; // one scanner process
+
+    QList<ScanWorker *> workers;
+    QStringList pendingPlugins; // plugins waiting for a free scanner process
+    QString scannerExePath;
+    int maxScanProcesses;
+    bool scanning;
+    bool canceled;
+    bool finishedWithoutError;
+
+    Persistence::PluginScanCache scanCache;
+
+    QStringList findPluginsToScan(const QStringList &foldersToScan, const QStringList &skipList);
+
+    void startWorkers();
+    void startWorker(const QStringList &parameters, const QStringList &pluginsToScan);
+    void consumeOutputFromWorker(ScanWorker *worker);
+    void finishPluginScan(ScanWorker *worker);
+    void finishWorker(ScanWorker *worker, bool crashed);
+    void finishScanIfDone();
+
+    static const int PLUGINS_PER_PROCESS;
+    static const int MAX_SCAN_PROCESSES;
+    static const qint64 SLOW_PLUGIN_SCAN_TIME;
 };
 
 } // namespace
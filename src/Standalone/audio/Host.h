@@ -1,8 +1,7 @@
 #ifndef HOST_H
 #define HOST_H
 
-#include <QList>
-#include "midi/MidiMessage.h"
+#include "midi/MidiMessageBuffer.h"
 
 class Host
 {
@@ -13,7 +12,7 @@ public:
     virtual int getSampleRate() const = 0;
     virtual int getBufferSize() const = 0;
 
-    virtual QList<Midi::MidiMessage> pullReceivedMidiMessages() = 0;
+    virtual void pullReceivedMidiMessages(Midi::MidiMessageBuffer &outBuffer) = 0; // append and clear the received messages
 
     virtual void setSampleRate(int sampleRate) = 0;
     virtual void setBlockSize(int blockSize) = 0;
@@ -22,7 +21,7 @@ public:
     virtual void setPositionInSamples(int position) = 0;
 
 protected:
-    QList<Midi::MidiMessage> receivedMidiMessages;
+    Midi::MidiMessageBuffer receivedMidiMessages;
 
 };
 
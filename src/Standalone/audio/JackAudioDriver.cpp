@@ -0,0 +1,398 @@
+#include "JackAudioDriver.h"
+#include "MainController.h"
+#include "log/Logging.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace Audio {
+
+const char *JackAudioDriver::CLIENT_NAME = "Jamtaba";
+
+JackAudioDriver::JackAudioDriver(Controller::MainController *mainController, int firstInputIndex,
+                                 int lastInputIndex, int firstOutputIndex, int lastOutputIndex) :
+    AudioDriver(mainController),
+    client(nullptr),
+    active(false),
+    serverShutdown(0),
+    xruns(0)
+{
+    jack_status_t status;
+    client = jack_client_open(CLIENT_NAME, JackNoStartServer, &status);
+    if (!client) {
+        qCDebug(jtAudio) << "Can't connect with JACK server, status:" << status;
+        return;
+    }
+
+    qCInfo(jtAudio) << "Connected with JACK server as" << jack_get_client_name(client);
+
+    sampleRate = jack_get_sample_rate(client);
+    bufferSize = jack_get_buffer_size(client);
+
+    jack_set_process_callback(client, &JackAudioDriver::processCallback, this);
+    jack_set_buffer_size_callback(client, &JackAudioDriver::bufferSizeCallback, this);
+    jack_set_sample_rate_callback(client, &JackAudioDriver::sampleRateCallback, this);
+    jack_set_xrun_callback(client, &JackAudioDriver::xrunCallback, this);
+    jack_on_shutdown(client, &JackAudioDriver::shutdownCallback, this);
+
+    refreshPhysicalPorts();
+
+    globalInputRange = ChannelRange(firstInputIndex, (lastInputIndex - firstInputIndex) + 1);
+    globalOutputRange = ChannelRange(firstOutputIndex, (lastOutputIndex - firstOutputIndex) + 1);
+    ensureRangesAreValid();
+}
+
+JackAudioDriver::~JackAudioDriver()
+{
+    qCDebug(jtAudio) << "JackAudioDriver destructor";
+    if (client)
+        release();
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++ JACK callbacks
+
+int JackAudioDriver::processCallback(jack_nframes_t frames, void *arg)
+{
+    static_cast<JackAudioDriver *>(arg)->process(frames);
+    return 0;
+}
+
+int JackAudioDriver::bufferSizeCallback(jack_nframes_t frames, void *arg)
+{
+    JackAudioDriver *driver = static_cast<JackAudioDriver *>(arg);
+    if (driver->bufferSize != (int)frames) {
+        qCDebug(jtAudio) << "JACK buffer size changed to" << frames;
+        driver->bufferSize = frames;
+
+        // plugins block size and settings are updated in the main thread
+        if (driver->mainController)
+            QMetaObject::invokeMethod(driver->mainController, "setBufferSize", Qt::QueuedConnection, Q_ARG(int, frames));
+    }
+    return 0;
+}
+
+int JackAudioDriver::sampleRateCallback(jack_nframes_t sampleRate, void *arg)
+{
+    JackAudioDriver *driver = static_cast<JackAudioDriver *>(arg);
+    driver->setSampleRate(sampleRate); // sampleRateChanged is emitted and delivered (queued) in the main thread
+    return 0;
+}
+
+int JackAudioDriver::xrunCallback(void *arg)
+{
+    JackAudioDriver *driver = static_cast<JackAudioDriver *>(arg);
+    int xruns = driver->xruns.fetchAndAddRelaxed(1) + 1;
+    qCDebug(jtAudio) << "JACK xrun detected, total xruns:" << xruns;
+    if (driver->mainController) // JACK is not telling the xrun direction
+        driver->mainController->getAudioCallbackStatistics().addXruns(false, false, true, false);
+    return 0;
+}
+
+void JackAudioDriver::shutdownCallback(void *arg)
+{
+    JackAudioDriver *driver = static_cast<JackAudioDriver *>(arg);
+    qCritical() << "JACK server was shut down!";
+    driver->serverShutdown.store(1);
+    driver->active = false;
+    emit driver->stopped(); // plugins are suspended in the main thread
+}
+
+void JackAudioDriver::process(jack_nframes_t frames)
+{
+    if (!inputBuffer || !outputBuffer)
+        return;
+
+    for (size_t i = 0; i < inputPorts.size(); ++i)
+        inputChannels[i] = static_cast<float *>(jack_port_get_buffer(inputPorts[i], frames));
+
+    for (size_t i = 0; i < outputPorts.size(); ++i)
+        outputChannels[i] = static_cast<float *>(jack_port_get_buffer(outputPorts[i], frames));
+
+    inputBuffer->setFrameLenght(frames);
+    outputBuffer->setFrameLenght(frames);
+
+    if (!inputChannels.empty())
+        inputBuffer->setPlanar(inputChannels.data(), frames, inputChannels.size());
+    else
+        inputBuffer->zero();
+
+    outputBuffer->zero();
+
+    //all application audio processing is computed here
+    if (mainController)
+        mainController->process(*inputBuffer, *outputBuffer, sampleRate);
+
+    outputBuffer->copyToPlanar(outputChannels.data(), frames, outputChannels.size());
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++
+
+void JackAudioDriver::refreshPhysicalPorts()
+{
+    physicalInputs.clear();
+    physicalOutputs.clear();
+
+    // in JACK the physical capture ports are 'output' ports (the audio is coming from these ports)
+    const char **ports = jack_get_ports(client, nullptr, JACK_DEFAULT_AUDIO_TYPE, JackPortIsPhysical | JackPortIsOutput);
+    if (ports) {
+        for (int i = 0; ports[i]; ++i)
+            physicalInputs.append(QString::fromUtf8(ports[i]));
+        jack_free(ports);
+    }
+
+    ports = jack_get_ports(client, nullptr, JACK_DEFAULT_AUDIO_TYPE, JackPortIsPhysical | JackPortIsInput);
+    if (ports) {
+        for (int i = 0; ports[i]; ++i)
+            physicalOutputs.append(QString::fromUtf8(ports[i]));
+        jack_free(ports);
+    }
+
+    qCDebug(jtAudio) << "JACK physical ports:" << physicalInputs.size() << "inputs and" << physicalOutputs.size() << "outputs";
+}
+
+void JackAudioDriver::ensureRangesAreValid()
+{
+    int maxInputs = getMaxInputs();
+    int inputsCount = globalInputRange.getChannels();
+    if (inputsCount > maxInputs || globalInputRange.getFirstChannel() >= maxInputs || inputsCount <= 0)
+        globalInputRange = ChannelRange(0, std::min(maxInputs, 1));
+
+    // JACK ports can be routed to anywhere, so we have at least a stereo output even without physical outputs
+    int maxOutputs = getMaxOutputs();
+    int outputsCount = globalOutputRange.getChannels();
+    if (outputsCount > maxOutputs || globalOutputRange.getFirstChannel() >= maxOutputs || outputsCount <= 0)
+        globalOutputRange = ChannelRange(0, std::min(maxOutputs, 2));
+}
+
+void JackAudioDriver::registerPorts()
+{
+    for (int c = 0; c < globalInputRange.getChannels(); ++c) {
+        QString portName = QString("in_%1").arg(globalInputRange.getFirstChannel() + c + 1);
+        jack_port_t *port = jack_port_register(client, portName.toUtf8().constData(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+        if (!port) {
+            qCritical() << "Can't register the JACK port" << portName;
+            continue;
+        }
+        inputPorts.push_back(port);
+    }
+
+    for (int c = 0; c < globalOutputRange.getChannels(); ++c) {
+        QString portName = QString("out_%1").arg(globalOutputRange.getFirstChannel() + c + 1);
+        jack_port_t *port = jack_port_register(client, portName.toUtf8().constData(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+        if (!port) {
+            qCritical() << "Can't register the JACK port" << portName;
+            continue;
+        }
+        outputPorts.push_back(port);
+    }
+
+    inputChannels.assign(inputPorts.size(), nullptr);
+    outputChannels.assign(outputPorts.size(), nullptr);
+}
+
+void JackAudioDriver::unregisterPorts()
+{
+    if (client && !serverShutdown.load()) {
+        for (jack_port_t *port : inputPorts)
+            jack_port_unregister(client, port);
+        for (jack_port_t *port : outputPorts)
+            jack_port_unregister(client, port);
+    }
+
+    inputPorts.clear();
+    outputPorts.clear();
+    inputChannels.clear();
+    outputChannels.clear();
+}
+
+void JackAudioDriver::connectPorts()
+{
+    // ports can be connected only when the client is active
+    for (size_t c = 0; c < inputPorts.size(); ++c) {
+        int physicalIndex = globalInputRange.getFirstChannel() + c;
+        if (physicalIndex < physicalInputs.size()) {
+            QByteArray source = physicalInputs.at(physicalIndex).toUtf8();
+            if (jack_connect(client, source.constData(), jack_port_name(inputPorts[c])) != 0)
+                qCWarning(jtAudio) << "Can't connect" << physicalInputs.at(physicalIndex) << "to" << jack_port_name(inputPorts[c]);
+        }
+    }
+
+    for (size_t c = 0; c < outputPorts.size(); ++c) {
+        int physicalIndex = globalOutputRange.getFirstChannel() + c;
+        if (physicalIndex < physicalOutputs.size()) {
+            QByteArray destination = physicalOutputs.at(physicalIndex).toUtf8();
+            if (jack_connect(client, jack_port_name(outputPorts[c]), destination.constData()) != 0)
+                qCWarning(jtAudio) << "Can't connect" << jack_port_name(outputPorts[c]) << "to" << physicalOutputs.at(physicalIndex);
+        }
+    }
+}
+
+bool JackAudioDriver::start()
+{
+    if (!canBeStarted())
+        return false;
+
+    stop();
+
+    ensureRangesAreValid();
+
+    recreateBuffers();//adjust the input and output buffers channels
+
+    registerPorts();
+
+    qCDebug(jtAudio) << "Starting JACK driver using" << sampleRate << "Hz and" << bufferSize << "samples as buffer size.";
+    if (jack_activate(client) != 0) {
+        qCritical() << "Can't activate the JACK client!";
+        unregisterPorts();
+        return false;
+    }
+    active = true;
+
+    connectPorts();
+
+    qCDebug(jtAudio) << "JACK driver started ok!";
+    emit started();
+
+    return true;
+}
+
+void JackAudioDriver::stop(bool refreshDevicesList)
+{
+    if (client && active) {
+        qCDebug(jtAudio) << "Stopping JACK driver ...";
+        if (!serverShutdown.load())
+            jack_deactivate(client); // the process callback is not called after this point
+        active = false;
+        emit stopped();
+        qCDebug(jtAudio) << "JACK driver stoped!";
+    }
+
+    unregisterPorts();
+
+    if (refreshDevicesList && client && !serverShutdown.load()) {
+        qCDebug(jtAudio) << "   Refreshing JACK physical ports list";
+        refreshPhysicalPorts();
+    }
+}
+
+void JackAudioDriver::release()
+{
+    qCDebug(jtAudio) << "releasing JACK resources...";
+    stop();
+    if (client) {
+        jack_client_close(client);
+        client = nullptr;
+    }
+    qCDebug(jtAudio) << "JACK client closed!";
+}
+
+void JackAudioDriver::setBufferSize(int newBufferSize)
+{
+    if (!client || serverShutdown.load() || newBufferSize == bufferSize)
+        return;
+
+    // the buffer size is changed for the entire JACK graph, bufferSizeCallback is called when the new size is applied
+    if (jack_set_buffer_size(client, newBufferSize) != 0)
+        qCWarning(jtAudio) << "JACK server rejected the buffer size" << newBufferSize;
+}
+
+QList<int> JackAudioDriver::getValidSampleRates(int deviceIndex) const
+{
+    Q_UNUSED(deviceIndex)
+
+    return QList<int>() << sampleRate; // the sample rate is defined when the JACK server is started
+}
+
+QList<int> JackAudioDriver::getValidBufferSizes(int deviceIndex) const
+{
+    Q_UNUSED(deviceIndex)
+
+    QList<int> bufferSizes;
+    for (int size = 16; size <= 4096; size *= 2)
+        bufferSizes.append(size);
+    return bufferSizes;
+}
+
+int JackAudioDriver::getMaxInputs() const
+{
+    return physicalInputs.size();
+}
+
+int JackAudioDriver::getMaxOutputs() const
+{
+    return std::max(physicalOutputs.size(), 2);
+}
+
+QString JackAudioDriver::getPortShortName(const QString &portName)
+{
+    int index = portName.indexOf(':');
+    return index >= 0 ? portName.mid(index + 1) : portName;
+}
+
+QString JackAudioDriver::getInputChannelName(const unsigned int index) const
+{
+    if (index < (uint)physicalInputs.size())
+        return getPortShortName(physicalInputs.at(index));
+    return "In " + QString::number(index + 1);
+}
+
+QString JackAudioDriver::getOutputChannelName(const unsigned int index) const
+{
+    if (index < (uint)physicalOutputs.size())
+        return getPortShortName(physicalOutputs.at(index));
+    return "Out " + QString::number(index + 1);
+}
+
+QString JackAudioDriver::getAudioInputDeviceName(int index) const
+{
+    Q_UNUSED(index)
+    return "JACK";
+}
+
+QString JackAudioDriver::getAudioOutputDeviceName(int index) const
+{
+    Q_UNUSED(index)
+    return "JACK";
+}
+
+QString JackAudioDriver::getAudioInputDeviceName() const
+{
+    return getAudioInputDeviceName(0);
+}
+
+QString JackAudioDriver::getAudioOutputDeviceName() const
+{
+    return getAudioOutputDeviceName(0);
+}
+
+int JackAudioDriver::getAudioDeviceIndex() const
+{
+    return 0; // the JACK server is the only device
+}
+
+void JackAudioDriver::setAudioDeviceIndex(int index)
+{
+    Q_UNUSED(index)
+    stop();
+}
+
+int JackAudioDriver::getDevicesCount() const
+{
+    return 1;
+}
+
+bool JackAudioDriver::canBeStarted() const
+{
+    return client != nullptr && !serverShutdown.load();
+}
+
+bool JackAudioDriver::hasControlPanel() const
+{
+    return false;
+}
+
+void JackAudioDriver::openControlPanel(void *mainWindowHandle)
+{
+    Q_UNUSED(mainWindowHandle)
+}
+
+} // namespace
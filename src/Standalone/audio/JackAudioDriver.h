@@ -0,0 +1,107 @@
+#ifndef JACK_AUDIO_DRIVER_H
+#define JACK_AUDIO_DRIVER_H
+
+#include "audio/core/AudioDriver.h"
+#include <jack/jack.h>
+#include <QStringList>
+#include <QAtomicInt>
+#include <vector>
+
+namespace Audio {
+
+/***
+  Native JACK driver (Linux). The audio is processed in the JACK realtime thread, one JACK port
+  is registered for each channel in the selected input and output ranges, and the ports are
+  connected to the correspondent physical ports. The sample rate and the buffer size are
+  controlled by the JACK server, so the JACK server is the only "device" exposed by this driver.
+ */
+class JackAudioDriver : public AudioDriver
+{
+public:
+    JackAudioDriver(Controller::MainController *mainController, int firstInputIndex,
+                    int lastInputIndex, int firstOutputIndex, int lastOutputIndex);
+    virtual ~JackAudioDriver();
+
+    bool isConnected() const; // false if the JACK server is not running
+
+    bool start() override;
+    void stop(bool refreshDevicesList = false) override;
+    void release() override;
+
+    void setBufferSize(int newBufferSize) override;
+
+    QList<int> getValidSampleRates(int deviceIndex) const override;
+    QList<int> getValidBufferSizes(int deviceIndex) const override;
+
+    int getMaxInputs() const override;
+    int getMaxOutputs() const override;
+
+    QString getInputChannelName(unsigned const int index) const override;
+    QString getOutputChannelName(unsigned const int index) const override;
+
+    QString getAudioInputDeviceName(int index) const override;
+    QString getAudioOutputDeviceName(int index) const override;
+    QString getAudioInputDeviceName() const override;
+    QString getAudioOutputDeviceName() const override;
+
+    int getAudioDeviceIndex() const override;
+    void setAudioDeviceIndex(int index) override;
+
+    int getDevicesCount() const override;
+
+    bool canBeStarted() const override;
+
+    bool hasControlPanel() const override;
+    void openControlPanel(void *mainWindowHandle) override;
+
+    int getXRunsCount() const;
+
+private:
+    // JACK callbacks, the 'arg' parameter is the JackAudioDriver instance
+    static int processCallback(jack_nframes_t frames, void *arg);
+    static int bufferSizeCallback(jack_nframes_t frames, void *arg);
+    static int sampleRateCallback(jack_nframes_t sampleRate, void *arg);
+    static int xrunCallback(void *arg);
+    static void shutdownCallback(void *arg);
+
+    void process(jack_nframes_t frames); // running in JACK realtime thread
+
+    void refreshPhysicalPorts();
+    void registerPorts();
+    void unregisterPorts();
+    void connectPorts();
+    void ensureRangesAreValid();
+
+    static QString getPortShortName(const QString &portName);
+
+    jack_client_t *client;
+    bool active;
+    QAtomicInt serverShutdown;
+    QAtomicInt xruns;
+
+    QStringList physicalInputs; // physical capture ports (JACK output ports)
+    QStringList physicalOutputs; // physical playback ports (JACK input ports)
+
+    std::vector<jack_port_t *> inputPorts;
+    std::vector<jack_port_t *> outputPorts;
+
+    // device buffers, the pointers are filled in each process callback without allocations
+    std::vector<float *> inputChannels;
+    std::vector<float *> outputChannels;
+
+    static const char *CLIENT_NAME;
+};
+
+inline bool JackAudioDriver::isConnected() const
+{
+    return client != nullptr;
+}
+
+inline int JackAudioDriver::getXRunsCount() const
+{
+    return xruns.load();
+}
+
+} // namespace
+
+#endif
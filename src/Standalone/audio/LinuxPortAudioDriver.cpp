@@ -8,7 +8,8 @@ PortAudioDriver::PortAudioDriver(Controller::MainController *mainController, int
                                  int firstInIndex, int lastInIndex, int firstOutIndex,
                                  int lastOutIndex, int sampleRate, int bufferSize) :
     AudioDriver(mainController),
-    useSystemDefaultDevices(false)
+    useSystemDefaultDevices(false),
+    usingNonInterleavedBuffers(false)
 {
 
     Q_UNUSED(firstInIndex)
@@ -7,7 +7,8 @@ PortAudioDriver::PortAudioDriver(Controller::MainController *mainController, int
                                  int firstInIndex, int lastInIndex, int firstOutIndex,
                                  int lastOutIndex, int sampleRate, int bufferSize) :
     AudioDriver(mainController),
-    useSystemDefaultDevices(true) // in mac deviceIndex is always the system default values
+    useSystemDefaultDevices(true), // in mac deviceIndex is always the system default values
+    usingNonInterleavedBuffers(false)
 {
 
     Q_UNUSED(firstInIndex)
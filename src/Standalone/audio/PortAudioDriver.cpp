@@ -7,6 +7,7 @@
 #include "persistence/Settings.h"
 #include "MainController.h"
 #include "log/Logging.h"
+#include "performance/ThreadRoles.h"
 #include <QtGlobal>
 
 /*
@@ -126,14 +127,12 @@ void PortAudioDriver::translatePortAudioCallBack(const void *in, void *out, unsi
     //prepare buffers and expose then to application process
     inputBuffer->setFrameLenght(framesPerBuffer);
     outputBuffer->setFrameLenght(framesPerBuffer);
-    if(!globalInputRange.isEmpty()){
-        float* inputs = (float*)in;
-        int inputChannels = globalInputRange.getChannels();
-        for(unsigned int i=0; i < framesPerBuffer; i++){
-            for (int c = 0; c < inputChannels; c++){
-                inputBuffer->set(c, i, *inputs++);
-            }
-        }
+    int inputChannels = globalInputRange.getChannels();
+    if(!globalInputRange.isEmpty() && in){
+        if (usingNonInterleavedBuffers)
+            inputBuffer->setPlanar(static_cast<const float * const *>(in), framesPerBuffer, inputChannels);
+        else
+            inputBuffer->deinterleave(static_cast<const float *>(in), framesPerBuffer, inputChannels);
     }
     else{
         inputBuffer->zero();
@@ -148,22 +147,28 @@ void PortAudioDriver::translatePortAudioCallBack(const void *in, void *out, unsi
     }
 
     //convert application output buffers to portaudio format
-    float* outputs = (float*)out;
     int outputChannels = globalOutputRange.getChannels();
-    for(unsigned int i=0; i < framesPerBuffer; i++){
-        for (int c = 0; c < outputChannels; c++){
-            *outputs++ = outputBuffer->get(c, i);
-        }
-    }
+    if (usingNonInterleavedBuffers)
+        outputBuffer->copyToPlanar(static_cast<float * const *>(out), framesPerBuffer, outputChannels);
+    else
+        outputBuffer->interleave(static_cast<float *>(out), framesPerBuffer, outputChannels);
 }
 
 //friend function, receive the pointer to PortAudioDriver instance in userData param
 int portaudioCallBack(const void *inputBuffer, void *outputBuffer,
                       unsigned long framesPerBuffer, const PaStreamCallbackTimeInfo* /*timeInfo*/,
-                      PaStreamCallbackFlags /*statusFlags*/, void *userData)
+                      PaStreamCallbackFlags statusFlags, void *userData)
 {
     //qDebug() << "portAudioCallBack  Thread ID: " << QThread::currentThreadId();
+    ThreadRoles::applyToCurrentThread(ThreadRoles::AudioCallback); // just the first callback is changing the thread
     PortAudioDriver* instance = static_cast<PortAudioDriver*>(userData);
+    static const PaStreamCallbackFlags XRUN_FLAGS = paInputUnderflow | paInputOverflow | paOutputUnderflow | paOutputOverflow;
+    if ((statusFlags & XRUN_FLAGS) && instance->mainController) {
+        instance->mainController->getAudioCallbackStatistics().addXruns(statusFlags & paInputUnderflow,
+                                                                        statusFlags & paInputOverflow,
+                                                                        statusFlags & paOutputUnderflow,
+                                                                        statusFlags & paOutputOverflow);
+    }
     instance->translatePortAudioCallBack(inputBuffer, outputBuffer, framesPerBuffer);
     return paContinue;
 }
@@ -195,7 +200,8 @@ bool PortAudioDriver::start()
 
     unsigned long framesPerBuffer = bufferSize;// paFramesPerBufferUnspecified;
     qCDebug(jtAudio) << "Starting portaudio using" << framesPerBuffer << " as buffer size.";
-    PaSampleFormat sampleFormat = paFloat32;// | paNonInterleaved;
+    // using non interleaved buffers when possible, the device buffers are copied channel by channel
+    PaSampleFormat sampleFormat = paFloat32 | paNonInterleaved;
 
     PaStreamParameters inputParams;
     inputParams.channelCount = globalInputRange.getChannels();// maxInputChannels;//*/ inputChannels;
@@ -231,32 +237,25 @@ bool PortAudioDriver::start()
     if(globalOutputRange.isEmpty())
         return false;
 
-    // test if output format is supported
-    PaError error =  Pa_IsFormatSupported(nullptr, &outputParams, sampleRate);
+    // test if input and output formats are supported
+    PaError error = isFormatSupported(inputParams, outputParams);
     if(error != paNoError){
-        qCritical() << "unsuported output format: " <<
-                       Pa_GetErrorText(error) <<
-                       "sampleRate: " << sampleRate <<
-                       "channels: " << outputParams.channelCount << endl;
-        this->audioDeviceIndex = paNoDevice;
-        releaseHostSpecificParameters(inputParams, outputParams);
-        return false;
-    }
-
-
-    // test if input format is supported
-    if(!globalInputRange.isEmpty()){
-        error =  Pa_IsFormatSupported(&inputParams, nullptr, sampleRate);
+        // some host APIs can't open non interleaved streams, falling back to interleaved buffers
+        inputParams.sampleFormat = outputParams.sampleFormat = paFloat32;
+        error = isFormatSupported(inputParams, outputParams);
         if(error != paNoError){
-            qCritical() << "unsuported input format: " <<
+            qCritical() << "unsuported stream format: " <<
                            Pa_GetErrorText(error) <<
                            "sampleRate: " << sampleRate <<
-                           "channels: " << inputParams.channelCount << endl;
+                           "inputs: " << inputParams.channelCount <<
+                           "outputs: " << outputParams.channelCount << endl;
             this->audioDeviceIndex = paNoDevice;
             releaseHostSpecificParameters(inputParams, outputParams);
             return false;
         }
     }
+    usingNonInterleavedBuffers = (outputParams.sampleFormat & paNonInterleaved) != 0;
+    qCDebug(jtAudio) << "Using" << (usingNonInterleavedBuffers ? "non interleaved" : "interleaved") << "buffers";
 
     paStream = NULL;
     error = Pa_OpenStream(&paStream,
@@ -284,6 +283,15 @@ bool PortAudioDriver::start()
     return true;
 }
 
+PaError PortAudioDriver::isFormatSupported(const PaStreamParameters &inputParams, const PaStreamParameters &outputParams) const
+{
+    PaError error = Pa_IsFormatSupported(nullptr, &outputParams, sampleRate);
+    if (error == paNoError && !globalInputRange.isEmpty())
+        error = Pa_IsFormatSupported(&inputParams, nullptr, sampleRate);
+
+    return error;
+}
+
 QList<int> PortAudioDriver::getValidSampleRates(int deviceIndex) const
 {
     PaStreamParameters outputParams;
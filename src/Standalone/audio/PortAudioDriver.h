@@ -53,6 +53,8 @@ private:
     PaStream *paStream;
     void translatePortAudioCallBack(const void *in, void *out, unsigned long framesPerBuffer);
 
+    PaError isFormatSupported(const PaStreamParameters &inputParams, const PaStreamParameters &outputParams) const;
+
     void changeInputSelection(int firstInputChannelIndex, int inputChannelCount);
 
     void configureHostSpecificInputParameters(PaStreamParameters &inputParameters);
@@ -68,6 +70,8 @@ private:
 
     const bool useSystemDefaultDevices;
 
+    bool usingNonInterleavedBuffers; // the stream buffers are float** (one array per channel) instead of float*
+
 };
 }
 
@@ -6,7 +6,8 @@ namespace Audio{
 
 PortAudioDriver::PortAudioDriver(Controller::MainController* mainController, int deviceIndex, int firstInputIndex, int lastInputIndex, int firstOutputIndex, int lastOutputIndex, int sampleRate, int bufferSize )
     :AudioDriver(mainController),
-      useSystemDefaultDevices(false)
+      useSystemDefaultDevices(false),
+      usingNonInterleavedBuffers(false)
 {
     globalInputRange = ChannelRange(firstInputIndex, (lastInputIndex - firstInputIndex) + 1);
     globalOutputRange = ChannelRange(firstOutputIndex, (lastOutputIndex - firstOutputIndex) + 1);
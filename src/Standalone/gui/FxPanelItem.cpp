@@ -22,6 +22,7 @@ using namespace Audio;
 FxPanelItem::FxPanelItem(LocalTrackViewStandalone *parent, Controller::MainControllerStandalone *mainController) :
     QFrame(parent),
     plugin(nullptr),
+    sleeping(false),
     bypassButton(new QPushButton(this)),
     label(new QLabel()),
     mainController(mainController),
@@ -49,6 +50,15 @@ bool FxPanelItem::pluginIsBypassed()
     return containPlugin() && plugin->isBypassed();
 }
 
+void FxPanelItem::setPluginSleeping(bool sleeping)
+{
+    if (sleeping == this->sleeping)
+        return;
+
+    this->sleeping = sleeping;
+    updateStyleSheet();
+}
+
 void FxPanelItem::on_buttonClicked()
 {
     if (plugin) {
@@ -86,6 +96,7 @@ void FxPanelItem::unsetPlugin()
     mainController->removePlugin(this->localTrackView->getInputIndex(), plugin);
 
     this->plugin = nullptr;
+    this->sleeping = false;
 
     updateStyleSheet();
 }
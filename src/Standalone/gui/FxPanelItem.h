@@ -37,8 +37,16 @@ public:
         return plugin;
     }
 
+    inline bool pluginIsSleeping() const
+    {
+        return sleeping;
+    }
+
+    void setPluginSleeping(bool sleeping);// plugin is not processed because the input is silent
+
     Q_PROPERTY(bool bypassed READ pluginIsBypassed())// to use in stylesheet
     Q_PROPERTY(bool containPlugin READ containPlugin())// to use in stylesheet
+    Q_PROPERTY(bool sleeping READ pluginIsSleeping())// to use in stylesheet
 
 protected:
     void mousePressEvent(QMouseEvent *event) override;
@@ -53,6 +61,7 @@ private slots:
 
 private:
     Audio::Plugin *plugin;
+    bool sleeping;
     QPushButton *bypassButton;
     QLabel *label;
     Controller::MainControllerStandalone *mainController;// used to ask about plugins
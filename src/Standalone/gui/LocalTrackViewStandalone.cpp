@@ -23,6 +23,12 @@ LocalTrackViewStandalone::LocalTrackViewStandalone(
 
     mainLayout->addWidget(fxPanel, mainLayout->rowCount(), 0, 1, 2);
 
+    latencyLabel = new QLabel(this);
+    latencyLabel->setObjectName(QStringLiteral("latencyLabel"));
+    latencyLabel->setAlignment(Qt::AlignCenter);
+    latencyLabel->setVisible(false);
+    mainLayout->addWidget(latencyLabel, mainLayout->rowCount(), 0, 1, 2);
+
     // create input panel in the bottom
     this->inputPanel = createInputPanel();
 
@@ -175,6 +181,41 @@ void LocalTrackViewStandalone::updateGuiElements()
     }
     if (midiPeakMeter->isVisible())
         midiPeakMeter->update();
+
+    // show the sleeping plugins (input is silent and the plugin is not processed)
+    if (inputNode && fxPanel) {
+        QList<FxPanelItem *> items = fxPanel->getItems();
+        for (int slotIndex = 0; slotIndex < items.size(); ++slotIndex)
+            items.at(slotIndex)->setPluginSleeping(inputNode->processorIsSleeping(slotIndex));
+    }
+
+    updateLatencyLabel();
+}
+
+void LocalTrackViewStandalone::updateLatencyLabel()
+{
+    if (!inputNode)
+        return;
+
+    // the total delay is the same in all tracks when the plugins latency is compensated
+    int latency = inputNode->getProcessorsLatency();
+    int compensation = inputNode->getLatencyCompensation();
+    int totalDelay = latency + compensation;
+    bool showLabel = totalDelay > 0 && !isShowingPeakMetersOnly();
+    if (latencyLabel->isHidden() == showLabel)
+        latencyLabel->setVisible(showLabel);
+
+    if (!showLabel)
+        return;
+
+    double delayInMs = totalDelay * 1000.0 / mainController->getSampleRate();
+    QString text = QString::number(delayInMs, 'f', 1) + " ms";
+    if (latencyLabel->text() != text)
+        latencyLabel->setText(text);
+
+    QString toolTip = tr("Plugins latency: %1 samples\nDelay compensation: %2 samples").arg(latency).arg(compensation);
+    if (latencyLabel->toolTip() != toolTip)
+        latencyLabel->setToolTip(toolTip);
 }
 
 void LocalTrackViewStandalone::reset()
@@ -91,6 +91,7 @@ private:
     QLabel *inputTypeIconLabel;
     QWidget *inputPanel;
     FxPanel *fxPanel;
+    QLabel *latencyLabel; // plugins latency + delay compensation
 
     MidiActivityMeter *midiPeakMeter;// show midi activity
 
@@ -111,6 +112,7 @@ private:
 
     void updateInputText();
     void updateInputIcon();
+    void updateLatencyLabel();
 
     QString getInputText();
     QString getAudioInputText();
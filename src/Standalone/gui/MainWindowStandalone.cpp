@@ -7,6 +7,7 @@
 
 #include <QTimer>
 #include <QDesktopWidget>
+#include "StartupTimeline.h"
 
 using namespace Persistence;
 using namespace Controller;
@@ -244,7 +245,24 @@ void MainWindowStandalone::initializeLocalSubChannel(LocalTrackView *subChannelV
     // check if the loaded input selections (midi, audio mono, audio stereo) are stil valid and fallback if not
     sanitizeSubchannelInputSelections(subChannelView, subChannel);
 
-    restoreLocalSubchannelPluginsList(trackView, subChannel);
+    // when starting the plugins are restored after the main window is interactive (see restoreDeferredPlugins)
+    if (StartupTimeline::isParallelStartup() && !StartupTimeline::isFinished())
+        deferredPluginsRestoration.append(qMakePair(QPointer<LocalTrackViewStandalone>(trackView), subChannel));
+    else
+        restoreLocalSubchannelPluginsList(trackView, subChannel);
+}
+
+void MainWindowStandalone::restoreDeferredPlugins()
+{
+    if (deferredPluginsRestoration.isEmpty())
+        return;
+
+    StartupPhase phase("Restoring plugins");
+    for (const auto &restoration : deferredPluginsRestoration) {
+        if (restoration.first) // the track view can be removed before the plugins are restored
+            restoreLocalSubchannelPluginsList(restoration.first.data(), restoration.second);
+    }
+    deferredPluginsRestoration.clear();
 }
 
 LocalTrackGroupViewStandalone *MainWindowStandalone::createLocalTrackGroupView(int channelGroupIndex)
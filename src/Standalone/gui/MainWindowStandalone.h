@@ -6,6 +6,7 @@
 #include "LocalTrackViewStandalone.h"
 #include "MainControllerStandalone.h"
 #include "PluginScanDialog.h"
+#include <QPointer>
 
 using namespace Controller;
 
@@ -21,6 +22,8 @@ public:
 
     void refreshTrackInputSelection(int inputTrackIndex);
 
+    void restoreDeferredPlugins(); // plugins are restored after the main window is interactive when starting
+
     MainControllerStandalone * getMainController() override
     {
         return controller;
@@ -83,6 +86,8 @@ private:
 
     void initializePluginFinder();
 
+    QList<QPair<QPointer<LocalTrackViewStandalone>, Persistence::Subchannel>> deferredPluginsRestoration;
+
 };
 
 #endif // MAINFRAMEVST_H
@@ -1,6 +1,8 @@
 #include <QApplication>
 #include <QMainWindow>
 #include <QDir>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrent>
 
 #include "MainControllerStandalone.h"
 #include "gui/MainWindowStandalone.h"
@@ -8,39 +10,95 @@
 #include "log/Logging.h"
 #include "SingleApplication/singleapplication.h"
 #include "Configurator.h"
+#include "StartupTimeline.h"
+
+// the startup phases are executed one after another when '--serial-startup' is used
+bool useSerialStartup(int argc, char* args[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (QString(args[i]) == "--serial-startup")
+            return true;
+    }
+    return false;
+}
 
 int main(int argc, char* args[] ){
 
+    StartupTimeline::start();
+    StartupTimeline::setParallelStartup(!useSerialStartup(argc, args));
+
     QApplication::setApplicationName("JamTaba 2");
     QApplication::setApplicationVersion(APP_VERSION);
 
     // start the configurator
     Configurator* configurator = Configurator::getInstance();
-    if (!configurator->setUp())
-        qCritical() << "JTBConfig->setUp() FAILED !" ;
+    {
+        StartupPhase phase("Configurator setup");
+        if (!configurator->setUp())
+            qCritical() << "JTBConfig->setUp() FAILED !" ;
+    }
 
+    // the settings json file is parsed while the QApplication is created
     Persistence::Settings settings;
-    settings.load();
+    QFuture<void> settingsLoading;
+    if (StartupTimeline::isParallelStartup()) {
+        settingsLoading = QtConcurrent::run([&settings]{
+            StartupPhase phase("Loading settings");
+            settings.load();
+        });
+    }
+    else {
+        StartupPhase phase("Loading settings");
+        settings.load();
+    }
 
+    QApplication* application = nullptr;
+    {
+        StartupPhase phase("Creating application");
 // SingleApplication is not working in mac. Using a dirty ifdef until have time to solve the SingleApplication issue in Mac
 #ifdef Q_OS_WIN
-    QApplication* application = new SingleApplication(argc, args);
+        application = new SingleApplication(argc, args);
 #else
-    QApplication* application = new QApplication(argc, args);
+        application = new QApplication(argc, args);
 #endif
+    }
+
+    settingsLoading.waitForFinished();
 
     Controller::MainControllerStandalone mainController(settings, (QApplication*)application);
-    mainController.start();
+    {
+        StartupPhase phase("Starting main controller (audio and midi drivers)");
+        mainController.start();
+    }
     if(mainController.isUsingNullAudioDriver()){
         QMessageBox::about(nullptr, "Fatal error!", "Jamtaba can't detect any audio device in your machine!");
     }
+
+    QScopedPointer<StartupPhase> windowCreationPhase(new StartupPhase("Creating main window"));
     MainWindowStandalone mainWindow(&mainController);
     mainController.setMainWindow(&mainWindow);
+    windowCreationPhase.reset();
+
+    {
+        StartupPhase phase("Initializing main window (theme and local channels)");
+        mainWindow.initialize();
+    }
+    {
+        StartupPhase phase("Showing main window");
+        mainWindow.show();
+    }
+
+    // the first event loop iteration: the main window is painted and interactive
+    QTimer::singleShot(0, [&mainController, &mainWindow]{
+        StartupTimeline::finish("Main window is interactive");
 
-    mainWindow.initialize();
-    mainWindow.show();
+        {
+            StartupPhase phase("Connecting in Jamtaba server");
+            mainController.connectInJamtabaServer();
+        }
 
-    mainController.connectInJamtabaServer();
+        mainWindow.restoreDeferredPlugins();
+    });
 
 #ifdef Q_OS_WIN
     // The SingleApplication class implements a showUp() signal. You can bind to that signal to raise your application's
@@ -37,7 +37,9 @@ VstPlugin::VstPlugin(Vst::VstHost* host, const QString &pluginPath)
     :   Audio::Plugin(Vst::utils::createDescriptor(nullptr, pluginPath)),
         effect(nullptr),
         internalOutputBuffer(nullptr),
+        internalInputBuffer(nullptr),
         host(host),
+        tailLength(0),
         loaded(false),
         started(false),
         turnedOn(false),
@@ -85,6 +87,17 @@ bool VstPlugin::canGenerateMidiMessages() const{
     return returnValue >= 0;
 }
 
+int VstPlugin::getLatency() const{
+    if(!effect || !started){
+        return 0;
+    }
+    return effect->initialDelay;
+}
+
+int VstPlugin::getTailLength() const{
+    return tailLength;
+}
+
 bool VstPlugin::isVirtualInstrument() const{
     if(!effect){
         return false;
@@ -171,6 +184,10 @@ void VstPlugin::start(){
     wantMidi = (effect->dispatcher(effect, effCanDo, 0, 0, (void*)"receiveVstMidiEvent", 0) == 1);
     //qCDebug(vst) << "plugin midi capabilities done: " << wantMidi;
 
+    //zero is returned when the plugin don't report the tail size, and 1 means 'no tail'
+    VstIntPtr tailSize = effect->dispatcher(effect, effGetTailSize, 0, 0, NULL, 0);
+    tailLength = tailSize > 1 ? (int)tailSize : 0;
+
     started = true;
     turnedOn = false;
 
@@ -194,6 +211,7 @@ VstPlugin::~VstPlugin(){
         editorWindow = nullptr;
     }
     delete internalOutputBuffer;
+    delete internalInputBuffer;
 
     for (int i = 0; i < MAX_MIDI_EVENTS; ++i) {
         delete this->vstMidiEvents.events[i];
@@ -222,15 +240,16 @@ void VstPlugin::unload(){
     }
 }
 
-void VstPlugin::fillVstEventsList(const QList<Midi::MidiMessage> &midiBuffer){
-    int midiMessages = qMin( midiBuffer.count(), MAX_MIDI_EVENTS);
+void VstPlugin::fillVstEventsList(const Midi::MidiMessageBuffer &midiBuffer){
+    int midiMessages = qMin( midiBuffer.getMessagesCount(), MAX_MIDI_EVENTS);
     this->vstMidiEvents.numEvents = midiMessages;
     for (int m = 0; m < midiMessages; ++m) {
-        Midi::MidiMessage message = midiBuffer.at(m);
+        Midi::MidiMessage message = midiBuffer.getMessage(m);
         VstMidiEvent* vstEvent = (VstMidiEvent*)vstMidiEvents.events[m];
         vstEvent->type = kVstMidiType;
-        vstEvent->byteSize = sizeof(vstEvent);
-        vstEvent->deltaFrames = vstEvent->reserved1 = vstEvent->reserved2 = 0;
+        vstEvent->byteSize = sizeof(VstMidiEvent);
+        vstEvent->deltaFrames = message.getFrameOffset(); // sample accurate position inside the audio block
+        vstEvent->reserved1 = vstEvent->reserved2 = 0;
         vstEvent->midiData[0] = message.getStatus();
         vstEvent->midiData[1] = message.getData1();
         vstEvent->midiData[2] = message.getData2();
@@ -239,10 +258,10 @@ void VstPlugin::fillVstEventsList(const QList<Midi::MidiMessage> &midiBuffer){
     }
 }
 
-void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &outBuffer, const QList<Midi::MidiMessage> &midiBuffer){
+void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &outBuffer, const Midi::MidiMessageBuffer &midiBuffer){
 
-    Q_UNUSED(in)
     if( isBypassed() || !effect || !loaded || !started){
+        outBuffer.set(in);
         return;
     }
 
@@ -256,25 +275,41 @@ void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &ou
         effect->dispatcher(effect, effProcessEvents, 0, 0, (void*)&vstMidiEvents, 0);
     }
 
-    internalOutputBuffer->setFrameLenght(outBuffer.getFrameLenght());
-    internalInputBuffer->setFrameLenght(outBuffer.getFrameLenght());
+    if(!(effect->flags & effFlagsCanReplacing)){
+        outBuffer.set(in);
+        return;
+    }
+
+    VstInt32 sampleFrames = outBuffer.getFrameLenght();
 
-    internalInputBuffer->set(in);
+    /**
+        The insert chain buffers are passed directly to the plugin when the channels are matching, so
+    the samples are not copied. Plugins with different channels (mono plugins, multi-output VSTis, etc.)
+    are using the internal buffers.
+    */
 
     int inChannels = internalInputBuffer->getChannels();
+    bool usingChainInput = in.getChannels() == inChannels;
+    if(!usingChainInput){
+        internalInputBuffer->setFrameLenght(sampleFrames);
+        internalInputBuffer->set(in);
+    }
+    const Audio::SamplesBuffer &inputBuffer = usingChainInput ? in : *internalInputBuffer;
     for (int c = 0; c < inChannels; ++c) {
-        vstInputArray[c] = internalInputBuffer->getSamplesArray(c);
+        vstInputArray[c] = inputBuffer.getSamplesArray(c);
     }
 
     int outChannels = internalOutputBuffer->getChannels();
+    bool usingChainOutput = outBuffer.getChannels() == outChannels;
+    if(!usingChainOutput){
+        internalOutputBuffer->setFrameLenght(sampleFrames);
+    }
+    Audio::SamplesBuffer &outputBuffer = usingChainOutput ? outBuffer : *internalOutputBuffer;
     for (int c = 0; c < outChannels; ++c) {
-        vstOutputArray[c] = internalOutputBuffer->getSamplesArray(c);
+        vstOutputArray[c] = outputBuffer.getSamplesArray(c);
     }
 
-    VstInt32 sampleFrames = outBuffer.getFrameLenght();
-    if(effect->flags & effFlagsCanReplacing){
-        effect->processReplacing(effect, vstInputArray, vstOutputArray, sampleFrames);
-    }
+    effect->processReplacing(effect, vstInputArray, vstOutputArray, sampleFrames);
 
     /**
         VSTs are processing input samples and replacing the output buffer with these processed samples.
@@ -285,9 +320,15 @@ void VstPlugin::process(const Audio::SamplesBuffer &in, Audio::SamplesBuffer &ou
     */
 
     if(isVirtualInstrument()){
-        outBuffer.add(*internalOutputBuffer);//VSTis add and preserve the last generated output samples
+        if(usingChainOutput){
+            outBuffer.add(in);//VSTis add and preserve the last generated output samples
+        }
+        else{
+            outBuffer.set(in);
+            outBuffer.add(*internalOutputBuffer);
+        }
     }
-    else{
+    else if(!usingChainOutput){
         outBuffer.set(*internalOutputBuffer);//VSTs are replacing
     }
 }
@@ -24,7 +24,7 @@ public:
     ~VstPlugin();
 
     void process(const Audio::SamplesBuffer &vstInputArray, Audio::SamplesBuffer &outBuffer,
-                         const QList<Midi::MidiMessage> &midiBuffer) override;
+                         const Midi::MidiMessageBuffer &midiBuffer) override;
     void openEditor(const QPoint &centerOfScreen) override;
 
     void closeEditor() override;
@@ -54,6 +54,10 @@ public:
 
     bool canGenerateMidiMessages() const override;
 
+    int getTailLength() const override;
+
+    int getLatency() const override;
+
     inline quint32 getPluginID() const { return effect->resvd1; }
 
 protected:
@@ -73,6 +77,8 @@ private:
 
     bool wantMidi;
 
+    int tailLength; // in samples, reported by the plugin when it is started
+
     QString path;
 
     bool started;
@@ -84,7 +90,7 @@ private:
     float **vstInputArray;
 
     // VstEvents* vstEvents;
-    void fillVstEventsList(const QList<Midi::MidiMessage> &midiBuffer);
+    void fillVstEventsList(const Midi::MidiMessageBuffer &midiBuffer);
 
     template<int N>
     struct VSTEventBlock
@@ -4,6 +4,7 @@
 #include <QLibraryInfo>
 
 #include "log/Logging.h"
+#include "vst/VstPluginChecker.h"
 
 using namespace audio;
 
@@ -38,6 +39,21 @@ QString VSTPluginFinder::getScannerExecutablePath() const
     return "";
 }
 
+bool VSTPluginFinder::canScanInParallel() const
+{
+    return true; // VST plugins are files, so the files are distributed between the scanner processes
+}
+
+bool VSTPluginFinder::isPluginFile(const QFileInfo &file) const
+{
+    return Vst::PluginChecker::isValidPluginFile(file.absoluteFilePath());
+}
+
+QString VSTPluginFinder::getPluginName(const QString &pluginPath) const
+{
+    return Audio::PluginDescriptor::getVstPluginNameFromPath(pluginPath);
+}
+
 void VSTPluginFinder::handleScanningStart(const QString &scannedLine)
 {
     QStringList parts = scannedLine.split(": ");
@@ -47,7 +63,6 @@ void VSTPluginFinder::handleScanningStart(const QString &scannedLine)
     }
 
     QString pluginPath = parts.at(1);
-    lastScannedPlugin = pluginPath;// store the plugin path, if the scanner process crash we can add this bad plugin in the black list
     emit pluginScanStarted(pluginPath);
 }
 
@@ -60,6 +75,6 @@ void VSTPluginFinder::handleScanningFinished(const QString &scannedLine)
     }
 
     QString pluginPath = parts.at(1);
-    QString pluginName = Audio::PluginDescriptor::getVstPluginNameFromPath(pluginPath);
+    QString pluginName = getPluginName(pluginPath);
     emit pluginScanFinished(pluginName, pluginPath);
 }
@@ -16,13 +16,14 @@ public:
 protected:
     QString getScannerExecutablePath() const override;
 
+    bool canScanInParallel() const override;
+    bool isPluginFile(const QFileInfo &file) const override;
+    QString getPluginName(const QString &pluginPath) const override;
+
     void handleScanningStart(const QString &scannedLine) override;
     void handleScanningFinished(const QString &scannedLine) override;
 
 private:
-    QProcess scanProcess;
-    QString lastScannedPlugin;// used to recover the last plugin path when the scanner process crash
-
     Audio::PluginDescriptor getPluginDescriptor(const QFileInfo &f);
 
 };
@@ -11,7 +11,37 @@ VPATH += ../../../src/Common
 HEADERS += audio/core/SamplesBuffer.h
 SOURCES += audio/core/SamplesBuffer.cpp
 
+HEADERS += audio/core/SamplesRingBuffer.h
+SOURCES += audio/core/SamplesRingBuffer.cpp
+
 HEADERS += audio/core/AudioPeak.h
 SOURCES += audio/core/AudioPeak.cpp
 
+HEADERS += audio/core/AudioMixer.h
+SOURCES += audio/core/AudioMixer.cpp
+
+HEADERS += audio/core/AudioNode.h
+SOURCES += audio/core/AudioNode.cpp
+
+HEADERS += audio/core/AudioNodeProcessor.h
+SOURCES += audio/core/AudioNodeProcessor.cpp
+
+HEADERS += audio/core/AudioDriver.h
+SOURCES += audio/core/AudioDriver.cpp
+
+HEADERS += audio/Resampler.h
+SOURCES += audio/Resampler.cpp
+
+HEADERS += audio/SamplesBufferResampler.h
+SOURCES += audio/SamplesBufferResampler.cpp
+
+HEADERS += midi/MidiMessage.h
+SOURCES += midi/MidiMessage.cpp
+
+HEADERS += midi/MidiMessageBuffer.h
+SOURCES += midi/MidiMessageBuffer.cpp
+
+HEADERS += log/Logging.h
+SOURCES += log/logging.cpp
+
 SOURCES += test_Audio.cpp
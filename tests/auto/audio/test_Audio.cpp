@@ -2,6 +2,10 @@
 #include <QtTest/QtTest>
 #include <QString>
 #include "audio/core/SamplesBuffer.h"
+#include "audio/core/SamplesRingBuffer.h"
+#include "audio/core/AudioMixer.h"
+#include "audio/core/AudioNode.h"
+#include "midi/MidiMessageBuffer.h"
 
 using namespace Audio;
 
@@ -32,6 +36,17 @@ private slots:
     void setFrameLenghtIsPreservingSamples();
     void setFrameLenghtIsPreservingSamples_data();
 
+    void deinterleave();
+    void deinterleave_data();
+
+    void interleaveIsReversingDeinterleave();
+    void interleaveIsReversingDeinterleave_data();
+
+    void copyToPlanarIsZeroingExtraChannels();
+
+    void isSilent();
+    void isSilent_data();
+
 private:
     SamplesBuffer createBuffer(QString comaSeparatedValues);
     void checkExpectedValues(QString comaSeparatedExpectedValues, const SamplesBuffer &buffer);
@@ -266,10 +281,445 @@ void TestSamplesBuffer::append_data()
     QTest::newRow("Appending zero samples") << "1,2,3" << "" << "1,2,3";
 }
 
+void TestSamplesBuffer::deinterleave()
+{
+    QFETCH(int, channels);
+    QFETCH(int, frames);
+
+    std::vector<float> interleaved(channels * frames);
+    for (int i = 0; i < frames; ++i) {
+        for (int c = 0; c < channels; ++c)
+            interleaved[i * channels + c] = c * 1000 + i;
+    }
+
+    SamplesBuffer buffer(channels, frames);
+    buffer.deinterleave(&interleaved[0], frames, channels);
+
+    for (int c = 0; c < channels; ++c) {
+        for (int i = 0; i < frames; ++i)
+            QCOMPARE(buffer.get(c, i), (float)(c * 1000 + i));
+    }
+}
+
+void TestSamplesBuffer::deinterleave_data()
+{
+    QTest::addColumn<int>("channels");
+    QTest::addColumn<int>("frames");
+
+    QTest::newRow("Mono") << 1 << 64;
+    QTest::newRow("Stereo") << 2 << 64;
+    QTest::newRow("Stereo, frames not multiple of 4") << 2 << 67;
+    QTest::newRow("3 channels") << 3 << 33;
+    QTest::newRow("8 channels") << 8 << 128;
+}
+
+void TestSamplesBuffer::interleaveIsReversingDeinterleave()
+{
+    QFETCH(int, channels);
+    QFETCH(int, frames);
+
+    std::vector<float> interleaved(channels * frames);
+    for (uint i = 0; i < interleaved.size(); ++i)
+        interleaved[i] = i;
+
+    SamplesBuffer buffer(channels, frames);
+    buffer.deinterleave(&interleaved[0], frames, channels);
+
+    std::vector<float> output(channels * frames, -1.0f);
+    buffer.interleave(&output[0], frames, channels);
+
+    QVERIFY(output == interleaved);
+}
+
+void TestSamplesBuffer::interleaveIsReversingDeinterleave_data()
+{
+    deinterleave_data();
+}
+
+void TestSamplesBuffer::copyToPlanarIsZeroingExtraChannels()
+{
+    SamplesBuffer buffer(1, 4);
+    for (int i = 0; i < 4; ++i)
+        buffer.set(0, i, i + 1);
+
+    float left[4] = {-1, -1, -1, -1};
+    float right[4] = {-1, -1, -1, -1};
+    float *planar[2] = {left, right};
+    buffer.copyToPlanar(planar, 4, 2);
+
+    for (int i = 0; i < 4; ++i) {
+        QCOMPARE(left[i], (float)(i + 1));
+        QCOMPARE(right[i], 0.0f);
+    }
+}
+
+void TestSamplesBuffer::isSilent()
+{
+    QFETCH(QString, samples);
+    QFETCH(float, threshold);
+    QFETCH(bool, expectedResult);
+
+    SamplesBuffer buffer = createBuffer(samples);
+    QCOMPARE(buffer.isSilent(threshold), expectedResult);
+}
+
+void TestSamplesBuffer::isSilent_data()
+{
+    QTest::addColumn<QString>("samples");
+    QTest::addColumn<float>("threshold");
+    QTest::addColumn<bool>("expectedResult");
+
+    QTest::newRow("Empty buffer") << QString("") << 0.001f << true;
+    QTest::newRow("Zeroed buffer") << QString("0,0,0,0") << 0.001f << true;
+    QTest::newRow("Below threshold") << QString("0.0001,-0.0005,0.0009") << 0.001f << true;
+    QTest::newRow("Positive sample above threshold") << QString("0,0,0.5,0") << 0.001f << false;
+    QTest::newRow("Negative sample above threshold") << QString("0,-0.002,0,0") << 0.001f << false;
+    QTest::newRow("Last sample above threshold") << QString("0,0,0,0.001") << 0.001f << false;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestSamplesRingBuffer: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeAndRead();
+    void writeAndReadWrappingAround();
+    void writeIsLimitedByCapacity();
+    void readIsLimitedByAvailableFrames();
+    void monoBufferIsWrittenInAllChannels();
+    void writeFromPlanarArrays();
+    void discard();
+
+private:
+    static SamplesBuffer createSequence(int channels, int frames, float firstValue);
+};
+
+SamplesBuffer TestSamplesRingBuffer::createSequence(int channels, int frames, float firstValue)
+{
+    SamplesBuffer buffer(channels, frames);
+    for (int c = 0; c < channels; ++c) {
+        for (int i = 0; i < frames; ++i)
+            buffer.set(c, i, firstValue + i + c * 100); // right channel values are different
+    }
+    return buffer;
+}
+
+void TestSamplesRingBuffer::writeAndRead()
+{
+    SamplesRingBuffer ring(2, 8);
+    QCOMPARE(ring.write(createSequence(2, 5, 1)), 5u);
+    QCOMPARE(ring.getAvailableFrames(), 5u);
+    QCOMPARE(ring.getFreeFrames(), 3u);
+
+    SamplesBuffer out(2, 3);
+    QCOMPARE(ring.read(out, 3), 3u);
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(out.get(0, i), 1.0f + i);
+        QCOMPARE(out.get(1, i), 101.0f + i);
+    }
+    QCOMPARE(ring.getAvailableFrames(), 2u);
+}
+
+void TestSamplesRingBuffer::writeAndReadWrappingAround()
+{
+    SamplesRingBuffer ring(2, 4);
+    SamplesBuffer out(2, 4);
+
+    QCOMPARE(ring.write(createSequence(2, 3, 1)), 3u);
+    QCOMPARE(ring.read(out, 3), 3u);
+
+    QCOMPARE(ring.write(createSequence(2, 4, 10)), 4u); // wrapping around the ring end
+    QCOMPARE(ring.read(out, 4), 4u);
+    for (int i = 0; i < 4; ++i) {
+        QCOMPARE(out.get(0, i), 10.0f + i);
+        QCOMPARE(out.get(1, i), 110.0f + i);
+    }
+    QCOMPARE(ring.getAvailableFrames(), 0u);
+}
+
+void TestSamplesRingBuffer::writeIsLimitedByCapacity()
+{
+    SamplesRingBuffer ring(2, 4);
+    QCOMPARE(ring.write(createSequence(2, 6, 1)), 4u);
+    QCOMPARE(ring.getFreeFrames(), 0u);
+    QCOMPARE(ring.write(createSequence(2, 1, 1)), 0u);
+
+    SamplesBuffer out(2, 4);
+    QCOMPARE(ring.read(out, 4), 4u);
+    QCOMPARE(out.get(0, 3), 4.0f); // the first samples are preserved
+}
+
+void TestSamplesRingBuffer::readIsLimitedByAvailableFrames()
+{
+    SamplesRingBuffer ring(2, 8);
+    ring.write(createSequence(2, 2, 1));
+
+    SamplesBuffer out(2, 4);
+    out.zero();
+    QCOMPARE(ring.read(out, 4), 2u);
+    QCOMPARE(out.get(0, 1), 2.0f);
+    QCOMPARE(out.get(0, 2), 0.0f); // not touched
+    QCOMPARE(out.getFrameLenght(), 4); // frame lenght is not changed
+}
+
+void TestSamplesRingBuffer::monoBufferIsWrittenInAllChannels()
+{
+    SamplesRingBuffer ring(2, 4);
+    ring.write(createSequence(1, 2, 1));
+
+    SamplesBuffer out(2, 2);
+    QCOMPARE(ring.read(out, 2), 2u);
+    QCOMPARE(out.get(0, 1), 2.0f);
+    QCOMPARE(out.get(1, 1), 2.0f);
+}
+
+void TestSamplesRingBuffer::writeFromPlanarArrays()
+{
+    float left[] = {1, 2, 3};
+    float right[] = {4, 5, 6};
+    const float *stereo[] = {left, right};
+
+    SamplesRingBuffer ring(2, 4);
+    SamplesBuffer out(2, 4);
+    ring.write(stereo, 2, 2);
+    ring.read(out, 2);
+
+    QCOMPARE(ring.write(stereo, 2, 3), 3u); // wrapping around the ring end
+    QCOMPARE(ring.read(out, 4), 3u);
+    QCOMPARE(out.get(0, 2), 3.0f);
+    QCOMPARE(out.get(1, 2), 6.0f);
+
+    const float *mono[] = {left};
+    QCOMPARE(ring.write(mono, 1, 3), 3u);
+    QCOMPARE(ring.read(out, 3), 3u);
+    QCOMPARE(out.get(1, 1), 2.0f); // mono samples are copied to all channels
+}
+
+void TestSamplesRingBuffer::discard()
+{
+    SamplesRingBuffer ring(2, 4);
+    ring.write(createSequence(2, 3, 1));
+    QCOMPARE(ring.discard(2), 2u);
+    QCOMPARE(ring.discard(5), 1u);
+    QCOMPARE(ring.getAvailableFrames(), 0u);
+
+    ring.write(createSequence(2, 4, 20));
+    SamplesBuffer out(2, 1);
+    ring.read(out, 1);
+    QCOMPARE(out.get(0, 0), 20.0f);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+/***
+    Decoded samples FIFO used by audio thread: append the decoded samples and read one audio
+    block. SamplesBuffer is moving the remaining samples in each read, the ring is not.
+ */
+class BenchmarkSamplesFifo: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void samplesBufferAppendAndDiscard();
+    void samplesRingBufferWriteAndRead();
+
+private:
+    static const int DECODED_FRAMES = 4096; // bigger than the audio blocks, the queue is never empty
+    static const int BLOCK_FRAMES = 256;
+    static const int BLOCKS = 1000;
+};
+
+void BenchmarkSamplesFifo::samplesBufferAppendAndDiscard()
+{
+    SamplesBuffer decoded(2, DECODED_FRAMES);
+    decoded.zero();
+    SamplesBuffer fifo(2);
+    SamplesBuffer block(2, BLOCK_FRAMES);
+
+    QBENCHMARK {
+        for (int b = 0; b < BLOCKS; ++b) {
+            if (fifo.getFrameLenght() < BLOCK_FRAMES)
+                fifo.append(decoded);
+
+            block.set(fifo);
+            fifo.discardFirstSamples(BLOCK_FRAMES);
+        }
+    }
+}
+
+void BenchmarkSamplesFifo::samplesRingBufferWriteAndRead()
+{
+    SamplesBuffer decoded(2, DECODED_FRAMES);
+    decoded.zero();
+    SamplesRingBuffer fifo(2, DECODED_FRAMES * 2);
+    SamplesBuffer block(2, BLOCK_FRAMES);
+
+    QBENCHMARK {
+        for (int b = 0; b < BLOCKS; ++b) {
+            if (fifo.getAvailableFrames() < (unsigned int)BLOCK_FRAMES)
+                fifo.write(decoded);
+
+            fifo.read(block, BLOCK_FRAMES);
+        }
+    }
+}
+
+/***
+    Node generating a constant value in the source sample rate, like a remote track.
+ */
+class ConstantSourceNode : public AudioNode
+{
+public:
+    ConstantSourceNode(int sourceSampleRate, float value) :
+        sourceSampleRate(sourceSampleRate),
+        value(value),
+        lastSampleRate(0),
+        lastFrameLenght(0)
+    {
+    }
+
+    void processReplacing(const SamplesBuffer &in, SamplesBuffer &out, int sampleRate,
+                          const Midi::MidiMessageBuffer &midiBuffer) override
+    {
+        Q_UNUSED(in)
+        Q_UNUSED(midiBuffer)
+        lastSampleRate = sampleRate;
+        lastFrameLenght = out.getFrameLenght();
+        for (int c = 0; c < out.getChannels(); ++c) {
+            for (int i = 0; i < out.getFrameLenght(); ++i)
+                out.add(c, i, value);
+        }
+    }
+
+    int getSourceSampleRate() const override
+    {
+        return sourceSampleRate;
+    }
+
+    int sourceSampleRate;
+    float value;
+    int lastSampleRate; // sample rate used in the last processReplacing call
+    int lastFrameLenght;
+};
+
+class TestAudioMixer: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void nodesAreMixedInTheSourceSampleRate();
+    void mutedNodeIsNotMixed();
+    void nodeIsResamplingWhenThereIsNoBus();
+    void nodeIsResamplingWhenBusesAreDisabled();
+
+private:
+    static const int MIXER_SAMPLE_RATE = 48000;
+    static const int FRAMES = 480;
+};
+
+void TestAudioMixer::nodesAreMixedInTheSourceSampleRate()
+{
+    AudioMixer mixer(MIXER_SAMPLE_RATE);
+    ConstantSourceNode node1(44100, 0.25f);
+    ConstantSourceNode node2(44100, 0.25f);
+    mixer.addNode(&node1);
+    mixer.addNode(&node2);
+
+    SamplesBuffer in(2, FRAMES);
+    SamplesBuffer out(2, FRAMES);
+    Midi::MidiMessageBuffer midiBuffer;
+    for (int block = 0; block < 2; ++block) { // the second block is not using samples from the resampler initial state
+        in.zero();
+        out.zero();
+        mixer.process(in, out, MIXER_SAMPLE_RATE, midiBuffer);
+    }
+
+    QCOMPARE(node1.lastSampleRate, 44100);
+    QCOMPARE(node2.lastSampleRate, 44100);
+    QVERIFY(qAbs(node1.lastFrameLenght - 441) <= 1);
+
+    QCOMPARE(out.getFrameLenght(), FRAMES);
+    QVERIFY(qAbs(out.get(0, FRAMES/2) - 0.5f) < 0.01f); // summed in the bus and resampled once
+    QVERIFY(qAbs(out.get(1, FRAMES/2) - 0.5f) < 0.01f);
+}
+
+void TestAudioMixer::mutedNodeIsNotMixed()
+{
+    AudioMixer mixer(MIXER_SAMPLE_RATE);
+    ConstantSourceNode node1(44100, 0.25f);
+    ConstantSourceNode node2(44100, 0.25f);
+    node2.setMute(true);
+    mixer.addNode(&node1);
+    mixer.addNode(&node2);
+
+    SamplesBuffer in(2, FRAMES);
+    SamplesBuffer out(2, FRAMES);
+    Midi::MidiMessageBuffer midiBuffer;
+    for (int block = 0; block < 2; ++block) {
+        in.zero();
+        out.zero();
+        mixer.process(in, out, MIXER_SAMPLE_RATE, midiBuffer);
+    }
+
+    QCOMPARE(node2.lastSampleRate, 44100); // muted nodes are processed in the bus discard buffer
+    QVERIFY(qAbs(out.get(0, FRAMES/2) - 0.25f) < 0.01f);
+}
+
+void TestAudioMixer::nodeIsResamplingWhenThereIsNoBus()
+{
+    AudioMixer mixer(MIXER_SAMPLE_RATE);
+    ConstantSourceNode node(12345, 0.25f); // uncommon sample rate, no bus
+    mixer.addNode(&node);
+
+    SamplesBuffer in(2, FRAMES);
+    SamplesBuffer out(2, FRAMES);
+    in.zero();
+    out.zero();
+    mixer.process(in, out, MIXER_SAMPLE_RATE, Midi::MidiMessageBuffer());
+
+    QCOMPARE(node.lastSampleRate, MIXER_SAMPLE_RATE);
+    QCOMPARE(node.lastFrameLenght, FRAMES);
+    QCOMPARE(out.get(0, 0), 0.25f);
+}
+
+void TestAudioMixer::nodeIsResamplingWhenBusesAreDisabled()
+{
+    AudioMixer mixer(MIXER_SAMPLE_RATE);
+    mixer.setResamplingBusesEnabled(false);
+    ConstantSourceNode node(44100, 0.25f);
+    mixer.addNode(&node);
+
+    SamplesBuffer in(2, FRAMES);
+    SamplesBuffer out(2, FRAMES);
+    in.zero();
+    out.zero();
+    mixer.process(in, out, MIXER_SAMPLE_RATE, Midi::MidiMessageBuffer());
+
+    QCOMPARE(node.lastSampleRate, MIXER_SAMPLE_RATE);
+    QCOMPARE(node.lastFrameLenght, FRAMES);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 int main(int argc, char *argv[])
 {
-    TestSamplesBuffer test;
-    return QTest::qExec(&test, argc, argv);
+    int result = 0;
+
+    TestSamplesBuffer samplesBufferTest;
+    result += QTest::qExec(&samplesBufferTest, argc, argv);
+
+    TestSamplesRingBuffer samplesRingBufferTest;
+    result += QTest::qExec(&samplesRingBufferTest, argc, argv);
+
+    TestAudioMixer audioMixerTest;
+    result += QTest::qExec(&audioMixerTest, argc, argv);
+
+    BenchmarkSamplesFifo samplesFifoBenchmark;
+    result += QTest::qExec(&samplesFifoBenchmark, argc, argv);
+
+    return result;
 }
 
 #include "test_Audio.moc"
@@ -5,6 +5,10 @@ SUBDIRS += \
     audio \
     geo \
     gui/chords \
+    log \
+    loginserver \
     midi \
     ninjam \
+    performance \
     persistence \
+    vorbis \
@@ -10,7 +10,13 @@ VPATH += ../../../src/Common
 
 HEADERS += log/logging.h
 HEADERS += geo/IpToLocationResolver.h
+HEADERS += geo/IP2LocationDatabase.h
+HEADERS += geo/LocationCache.h
+HEADERS += persistence/CacheHeader.h
 
 SOURCES += log/logging.cpp
 SOURCES += geo/IpToLocationResolver.cpp
+SOURCES += geo/IP2LocationDatabase.cpp
+SOURCES += geo/LocationCache.cpp
+SOURCES += persistence/CacheHeader.cpp
 SOURCES += tst_GeoLocation.cpp
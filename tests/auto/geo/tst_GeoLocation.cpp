@@ -2,7 +2,12 @@
 #include <QString>
 #include <QtTest/QtTest>
 #include "geo/IpToLocationResolver.h"
+#include "geo/IP2LocationDatabase.h"
+#include "geo/LocationCache.h"
 #include <QDebug>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include <cstring>
 
 using namespace Geo;
 
@@ -13,6 +18,19 @@ class TestGeoLocation: public QObject
 private slots:
     void stripHtmlTags();
     void stripHtmlTags_data();
+
+    void parseIPv4_data();
+    void parseIPv4();
+
+    void databaseLookup_data();
+    void databaseLookup();
+
+    void locationCacheIsPersistent();
+    void locationCacheIsBounded();
+    void locationCacheDiscardsTruncatedRecord();
+
+private:
+    QByteArray createDatabase() const;
 };
 
 void TestGeoLocation::stripHtmlTags()
@@ -38,6 +56,181 @@ void TestGeoLocation::stripHtmlTags_data()
     QTest::newRow("No Html tags to strip") << "Country name" << "Country name";
 }
 
+void TestGeoLocation::parseIPv4_data()
+{
+    QTest::addColumn<QString>("ip");
+    QTest::addColumn<bool>("valid");
+    QTest::addColumn<quint32>("ipNumber");
+
+    QTest::newRow("Full IP") << "1.2.3.4" << true << (quint32)0x01020304;
+    QTest::newRow("Masked IP") << "177.18.90.x" << true << (quint32)0xB1125A00;
+    QTest::newRow("Out of range") << "1.2.3.256" << false << (quint32)0;
+    QTest::newRow("Missing part") << "1.2.3" << false << (quint32)0;
+    QTest::newRow("Empty") << "" << false << (quint32)0;
+}
+
+void TestGeoLocation::parseIPv4()
+{
+    QFETCH(QString, ip);
+    QFETCH(bool, valid);
+    QFETCH(quint32, ipNumber);
+
+    quint32 parsed = 0;
+    QCOMPARE(IP2LocationDatabase::parseIPv4(ip, parsed), valid);
+    if (valid)
+        QCOMPARE(parsed, ipNumber);
+}
+
+// create a tiny DB5 database (country, region, city, latitude, longitude) with 3 IPv4 ranges
+QByteArray TestGeoLocation::createDatabase() const
+{
+    const int columns = 6;
+    const int rows = 4; // 3 ranges + the upper bound
+    const quint32 headerSize = 64;
+    const quint32 rowsSize = rows * columns * 4;
+
+    QByteArray strings;
+    auto appendString = [&strings, headerSize, rowsSize](const QByteArray &str) -> quint32 {
+        quint32 offset = headerSize + rowsSize + strings.size(); // strings offsets are 0-based
+        strings.append(static_cast<char>(str.size()));
+        strings.append(str);
+        return offset;
+    };
+
+    quint32 brazil = appendString("BR");
+    appendString("Brazil");
+    quint32 germany = appendString("DE");
+    appendString("Germany");
+    quint32 reserved = appendString("-");
+    appendString("-");
+    quint32 city = appendString("UNKNOWN");
+
+    QByteArray data(headerSize + rowsSize, '\0');
+    uchar *buffer = reinterpret_cast<uchar *>(data.data());
+    buffer[0] = 5; // DB5
+    buffer[1] = columns;
+    qToLittleEndian<quint32>(rows - 1, buffer + 5); // IPv4 ranges count
+    qToLittleEndian<quint32>(headerSize + 1, buffer + 9); // IPv4 rows address (1-based)
+
+    const quint32 ipFrom[rows] = { 0x00000000, 0x01000000, 0x02000000, 0xFFFFFFFF };
+    const quint32 countries[rows] = { reserved, brazil, germany, reserved };
+    const float latitudes[rows] = { 0.0f, -23.5f, 52.5f, 0.0f };
+    const float longitudes[rows] = { 0.0f, -46.6f, 13.4f, 0.0f };
+    for (int row = 0; row < rows; ++row) {
+        uchar *rowData = buffer + headerSize + row * columns * 4;
+        qToLittleEndian<quint32>(ipFrom[row], rowData);
+        qToLittleEndian<quint32>(countries[row], rowData + 4);
+        qToLittleEndian<quint32>(city, rowData + 8); // region
+        qToLittleEndian<quint32>(city, rowData + 12);
+        memcpy(rowData + 16, &latitudes[row], 4);
+        memcpy(rowData + 20, &longitudes[row], 4);
+    }
+
+    return data + strings;
+}
+
+void TestGeoLocation::databaseLookup_data()
+{
+    QTest::addColumn<QString>("ip");
+    QTest::addColumn<QString>("countryCode");
+    QTest::addColumn<double>("latitude");
+
+    QTest::newRow("First IP in range") << "1.0.0.0" << "BR" << -23.5;
+    QTest::newRow("Masked IP") << "1.200.3.x" << "BR" << -23.5;
+    QTest::newRow("Last range") << "2.1.1.1" << "DE" << 52.5;
+    QTest::newRow("Reserved range") << "0.0.0.1" << "UNKNOWN" << -200.0;
+    QTest::newRow("Invalid IP") << "invalid" << "UNKNOWN" << -200.0;
+}
+
+void TestGeoLocation::databaseLookup()
+{
+    QFETCH(QString, ip);
+    QFETCH(QString, countryCode);
+    QFETCH(double, latitude);
+
+    QTemporaryDir dir;
+    QFile file(dir.path() + "/IP2LOCATION-LITE-DB5.BIN");
+    QVERIFY(file.open(QFile::WriteOnly));
+    file.write(createDatabase());
+    file.close();
+
+    IP2LocationDatabase database(file.fileName());
+    QVERIFY(database.isOpen());
+
+    Location location = database.lookup(ip);
+    QCOMPARE(location.getCountryCode(), countryCode);
+    QCOMPARE(static_cast<float>(location.getLatitude()), static_cast<float>(latitude));
+}
+
+void TestGeoLocation::locationCacheIsPersistent()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/locations.bin";
+    {
+        LocationCache cache(filePath);
+        cache.insert("1.2.3.x", "BR", QPointF(-23.5, -46.6));
+        cache.insert("4.5.6.x", "DE", QPointF(52.5, 13.4));
+        cache.insert("1.2.3.x", "PT", QPointF(38.7, -9.1)); // updating
+    }
+
+    LocationCache cache(filePath);
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.get("1.2.3.x").countryCode, QStringLiteral("PT"));
+    QCOMPARE(cache.get("4.5.6.x").latLong, QPointF(52.5, 13.4));
+}
+
+void TestGeoLocation::locationCacheIsBounded()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/locations.bin";
+    const int maxEntries = 3;
+    {
+        LocationCache cache(filePath, maxEntries);
+        for (int i = 0; i < 5; ++i)
+            cache.insert(QString("10.0.0.%1").arg(i), "BR", QPointF(i, i));
+
+        QCOMPARE(cache.size(), maxEntries);
+        QVERIFY(!cache.contains("10.0.0.0")); // the oldest entries are evicted
+        QVERIFY(cache.contains("10.0.0.4"));
+    }
+
+    LocationCache cache(filePath, maxEntries);
+    QCOMPARE(cache.size(), maxEntries);
+    QVERIFY(!cache.contains("10.0.0.1"));
+    QVERIFY(cache.contains("10.0.0.2"));
+}
+
+void TestGeoLocation::locationCacheDiscardsTruncatedRecord()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/locations.bin";
+    {
+        LocationCache cache(filePath);
+        cache.insert("1.2.3.x", "BR", QPointF(-23.5, -46.6));
+    }
+
+    QByteArray record;
+    {
+        QDataStream stream(&record, QIODevice::WriteOnly);
+        stream << QString("4.5.6.x") << QString("DE") << QPointF(52.5, 13.4);
+    }
+    QFile file(filePath);
+    QVERIFY(file.open(QFile::WriteOnly | QFile::Append));
+    file.write(record.left(record.size() - 5)); // a crash while appending the record
+    file.close();
+
+    {
+        LocationCache cache(filePath);
+        QCOMPARE(cache.size(), 1);
+        cache.insert("7.8.9.x", "PT", QPointF(38.7, -9.1)); // appended after the truncated record
+    }
+
+    LocationCache cache(filePath);
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.get("1.2.3.x").countryCode, QStringLiteral("BR"));
+    QCOMPARE(cache.get("7.8.9.x").countryCode, QStringLiteral("PT"));
+    QCOMPARE(cache.get("7.8.9.x").latLong, QPointF(38.7, -9.1));
+}
 
 int main(int argc, char *argv[])
 {
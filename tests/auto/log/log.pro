@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase
+TEMPLATE = app
+TARGET = log
+
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+VPATH += ../../../src/Common
+
+HEADERS += log/LogWriter.h
+SOURCES += log/LogWriter.cpp
+
+SOURCES += test_LogWriter.cpp
@@ -0,0 +1,217 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include "log/LogWriter.h"
+
+using namespace Log;
+
+class TestLogRecordQueue: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pushAndPop();
+    void recordsAreDroppedWhenQueueIsFull();
+    void longRecordsAreTruncated();
+};
+
+void TestLogRecordQueue::pushAndPop()
+{
+    LogRecordQueue queue(4);
+    LogRecord record;
+
+    QVERIFY(!queue.pop(record)); // empty queue
+
+    QVERIFY(queue.push("first\n", 6));
+    QVERIFY(queue.push("second\n", 7, 3, "color"));
+
+    QVERIFY(queue.pop(record));
+    QCOMPARE(QByteArray(record.text, record.length), QByteArray("first\n"));
+
+    QVERIFY(queue.pop(record));
+    QCOMPARE(QByteArray(record.text, record.length), QByteArray("second\n"));
+    QCOMPARE(record.coloredLength, 3);
+    QCOMPARE(QByteArray(record.color), QByteArray("color"));
+
+    QVERIFY(!queue.pop(record));
+}
+
+void TestLogRecordQueue::recordsAreDroppedWhenQueueIsFull()
+{
+    LogRecordQueue queue(4);
+    QCOMPARE(queue.getCapacity(), 4);
+
+    for (int i = 0; i < queue.getCapacity(); ++i)
+        QVERIFY(queue.push("record\n", 7));
+
+    QVERIFY(!queue.push("dropped\n", 8));
+    QVERIFY(!queue.push("dropped\n", 8));
+    QCOMPARE(queue.takeDroppedRecords(), (quint32)2);
+    QCOMPARE(queue.takeDroppedRecords(), (quint32)0); // counter is reset
+
+    LogRecord record;
+    QVERIFY(queue.pop(record));
+    QVERIFY(queue.push("reusing the cell\n", 17)); // one free cell after pop
+}
+
+void TestLogRecordQueue::longRecordsAreTruncated()
+{
+    LogRecordQueue queue(2);
+    QByteArray longText(LogRecord::MAX_RECORD_SIZE * 2, 'x');
+    QVERIFY(queue.push(longText.constData(), longText.size()));
+
+    LogRecord record;
+    QVERIFY(queue.pop(record));
+    QCOMPARE(record.length, static_cast<int>(LogRecord::MAX_RECORD_SIZE));
+    QCOMPARE(record.text[record.length - 1], '\n');
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class LogProducerThread : public QThread
+{
+public:
+    LogProducerThread(LogWriter &writer, int records) :
+        writer(writer),
+        records(records),
+        writtenRecords(0)
+    {
+    }
+
+    int getWrittenRecords() const
+    {
+        return writtenRecords;
+    }
+
+protected:
+    void run() override
+    {
+        for (int i = 0; i < records; ++i) {
+            if (writer.write("record\n"))
+                writtenRecords++;
+        }
+    }
+
+private:
+    LogWriter &writer;
+    int records;
+    int writtenRecords;
+};
+
+class TestLogWriter: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void recordsAreWrittenInFile();
+    void fileIsRotated();
+    void writingFromManyThreads();
+    void taskIsExecutedInWriterThread();
+};
+
+void TestLogWriter::recordsAreWrittenInFile()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/log.txt";
+    {
+        LogWriter writer(filePath);
+        writer.start();
+        QVERIFY(writer.write("first line\n", 5, "\033[31;1m"));
+        QVERIFY(writer.write("second line\n"));
+        writer.stop();
+    }
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), QByteArray("first line\nsecond line\n")); // no colors in file
+}
+
+void TestLogWriter::fileIsRotated()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/log.txt";
+    {
+        LogWriter writer(filePath, 10, 2);
+        for (int i = 0; i < 4; ++i) {
+            writer.write(QByteArray("record ") + QByteArray::number(i) + "\n"); // 9 bytes
+            writer.write("12\n");
+            writer.flush(); // 12 bytes in file, rotating
+        }
+    }
+
+    QVERIFY(QFile::exists(filePath));
+    QVERIFY(QFile::exists(LogWriter::getBackupFilePath(filePath, 1)));
+    QVERIFY(QFile::exists(LogWriter::getBackupFilePath(filePath, 2)));
+    QVERIFY(!QFile::exists(LogWriter::getBackupFilePath(filePath, 3)));
+
+    QCOMPARE(LogWriter::getBackupFilePath(filePath, 1), dir.path() + "/log.1.txt");
+
+    QFile lastBackup(LogWriter::getBackupFilePath(filePath, 1));
+    QVERIFY(lastBackup.open(QIODevice::ReadOnly));
+    QCOMPARE(lastBackup.readAll(), QByteArray("record 3\n12\n"));
+}
+
+void TestLogWriter::writingFromManyThreads()
+{
+    QTemporaryDir dir;
+    QString filePath = dir.path() + "/log.txt";
+
+    const int threadsCount = 4;
+    const int recordsPerThread = 200;
+    int writtenRecords = 0;
+    {
+        LogWriter writer(filePath, 0); // no rotation
+        writer.start();
+
+        QList<LogProducerThread *> threads;
+        for (int t = 0; t < threadsCount; ++t) {
+            threads.append(new LogProducerThread(writer, recordsPerThread));
+            threads.last()->start();
+        }
+
+        for (LogProducerThread *thread : threads) {
+            thread->wait();
+            writtenRecords += thread->getWrittenRecords();
+            delete thread;
+        }
+        writer.stop();
+    }
+
+    QVERIFY(writtenRecords > 0);
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll().count("record\n"), writtenRecords); // dropped records are not written
+}
+
+void TestLogWriter::taskIsExecutedInWriterThread()
+{
+    QTemporaryDir dir;
+    LogWriter writer(dir.path() + "/log.txt");
+    writer.start();
+
+    QAtomicPointer<QThread> taskThread;
+    writer.runInWriterThread([&taskThread]() {
+        taskThread.storeRelease(QThread::currentThread());
+    });
+
+    QTRY_VERIFY(taskThread.loadAcquire() != nullptr);
+    QCOMPARE(taskThread.loadAcquire(), static_cast<QThread *>(&writer));
+    writer.stop();
+}
+
+int main(int argc, char *argv[])
+{
+    int result = 0;
+
+    TestLogRecordQueue logRecordQueueTest;
+    result += QTest::qExec(&logRecordQueueTest, argc, argv);
+
+    TestLogWriter logWriterTest;
+    result += QTest::qExec(&logWriterTest, argc, argv);
+
+    return result;
+}
+
+#include "test_LogWriter.moc"
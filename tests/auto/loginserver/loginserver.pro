@@ -0,0 +1,27 @@
+QT += testlib network widgets
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = loginserver
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+VPATH += ../../../src/Common
+
+HEADERS += log/Logging.h
+HEADERS += loginserver/LoginService.h
+HEADERS += loginserver/natmap.h
+HEADERS += ninjam/Server.h
+HEADERS += ninjam/User.h
+HEADERS += ninjam/UserChannel.h
+HEADERS += ninjam/Service.h
+
+SOURCES += log/logging.cpp
+SOURCES += loginserver/LoginService.cpp
+SOURCES += ninjam/Server.cpp
+SOURCES += ninjam/User.cpp
+SOURCES += ninjam/UserChannel.cpp
+SOURCES += ninjam/Service.cpp
+SOURCES += ninjam/ServerMessages.cpp
+SOURCES += ninjam/ServerMessagesHandler.cpp
+SOURCES += ninjam/ClientMessages.cpp
+
+SOURCES += test_RoomsListChanges.cpp
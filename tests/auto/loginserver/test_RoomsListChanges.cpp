@@ -0,0 +1,99 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include "loginserver/LoginService.h"
+
+using namespace Login;
+
+static RoomInfo createRoom(long long id, int users, int bpm = 120)
+{
+    QList<UserInfo> roomUsers;
+    for (int i = 0; i < users; ++i)
+        roomUsers.append(UserInfo(i, "user" + QString::number(i), "127.0.0.1"));
+
+    return RoomInfo(id, "room" + QString::number(id), 2049, RoomTYPE::NINJAM, 8, roomUsers, 2, 16, bpm, QString());
+}
+
+class TestRoomsListChanges: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unchangedList();
+    void addedRooms();
+    void removedRooms();
+    void updatedRooms();
+    void firstList();
+};
+
+void TestRoomsListChanges::unchangedList()
+{
+    QList<RoomInfo> rooms;
+    rooms << createRoom(1, 2) << createRoom(2, 0);
+
+    RoomsListChanges changes(rooms, rooms);
+    QVERIFY(changes.isEmpty());
+}
+
+void TestRoomsListChanges::addedRooms()
+{
+    QList<RoomInfo> previousRooms;
+    previousRooms << createRoom(1, 2);
+    QList<RoomInfo> currentRooms;
+    currentRooms << createRoom(1, 2) << createRoom(2, 1);
+
+    RoomsListChanges changes(previousRooms, currentRooms);
+    QCOMPARE(changes.getAddedRooms().size(), 1);
+    QCOMPARE(changes.getAddedRooms().first().getID(), 2LL);
+    QVERIFY(changes.getUpdatedRooms().isEmpty());
+    QVERIFY(changes.getRemovedRooms().isEmpty());
+}
+
+void TestRoomsListChanges::removedRooms()
+{
+    QList<RoomInfo> previousRooms;
+    previousRooms << createRoom(1, 2) << createRoom(2, 1);
+    QList<RoomInfo> currentRooms;
+    currentRooms << createRoom(2, 1);
+
+    RoomsListChanges changes(previousRooms, currentRooms);
+    QCOMPARE(changes.getRemovedRooms(), QList<long long>() << 1);
+    QVERIFY(changes.getAddedRooms().isEmpty());
+    QVERIFY(changes.getUpdatedRooms().isEmpty());
+}
+
+void TestRoomsListChanges::updatedRooms()
+{
+    QList<RoomInfo> previousRooms;
+    previousRooms << createRoom(1, 2) << createRoom(2, 1) << createRoom(3, 0);
+    QList<RoomInfo> currentRooms;
+    currentRooms << createRoom(1, 3) << createRoom(2, 1, 90) << createRoom(3, 0); // user joined, bpm changed, unchanged
+
+    RoomsListChanges changes(previousRooms, currentRooms);
+    QCOMPARE(changes.getUpdatedRooms().size(), 2);
+    QCOMPARE(changes.getUpdatedRooms().at(0).getID(), 1LL);
+    QCOMPARE(changes.getUpdatedRooms().at(1).getID(), 2LL);
+    QVERIFY(changes.getAddedRooms().isEmpty());
+    QVERIFY(changes.getRemovedRooms().isEmpty());
+}
+
+void TestRoomsListChanges::firstList()
+{
+    QList<RoomInfo> currentRooms;
+    currentRooms << createRoom(1, 2) << createRoom(2, 1);
+
+    RoomsListChanges changes(QList<RoomInfo>(), currentRooms);
+    QCOMPARE(changes.getAddedRooms().size(), 2);
+    QVERIFY(changes.getRemovedRooms().isEmpty());
+}
+
+int main(int argc, char *argv[])
+{
+    int result = 0;
+
+    TestRoomsListChanges roomsListChangesTest;
+    result += QTest::qExec(&roomsListChangesTest, argc, argv);
+
+    return result;
+}
+
+#include "test_RoomsListChanges.moc"
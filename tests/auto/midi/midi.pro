@@ -9,6 +9,10 @@ INCLUDEPATH += ../../../src/Common
 VPATH += ../../../src/Common
 
 HEADERS += midi/MidiMessage.h
+HEADERS += midi/MidiEventQueue.h
+HEADERS += midi/MidiMessageBuffer.h
 SOURCES += midi/MidiMessage.cpp
+SOURCES += midi/MidiEventQueue.cpp
+SOURCES += midi/MidiMessageBuffer.cpp
 
 SOURCES += test_MidiMessage.cpp
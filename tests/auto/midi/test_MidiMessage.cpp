@@ -2,6 +2,8 @@
 #include <QtTest/QtTest>
 #include <QString>
 #include "midi/MidiMessage.h"
+#include "midi/MidiEventQueue.h"
+#include "midi/MidiMessageBuffer.h"
 
 using namespace Midi;
 
@@ -41,10 +43,148 @@ void TestMidiMessage::transpose_data()
 
 }
 
+// +++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestMidiEventQueue: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void pushAndPopArePreservingOrder();
+    void pushIsFailingWhenQueueIsFull();
+    void popIsFailingWhenQueueIsEmpty();
+    void pushAndPopAreWrappingAround();
+};
+
+void TestMidiEventQueue::pushAndPopArePreservingOrder()
+{
+    MidiEventQueue queue(8);
+    for (int i = 0; i < 5; ++i)
+        QVERIFY(queue.push(MidiMessage(0x7F4090 + (i << 8), 0), i * 1000));
+
+    QCOMPARE(queue.getAvailableEvents(), 5);
+
+    MidiMessage message;
+    qint64 timestamp;
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(queue.pop(message, timestamp));
+        QCOMPARE(message.getData1(), 0x40 + i);
+        QCOMPARE(timestamp, (qint64)(i * 1000));
+    }
+    QCOMPARE(queue.getAvailableEvents(), 0);
+}
+
+void TestMidiEventQueue::pushIsFailingWhenQueueIsFull()
+{
+    MidiEventQueue queue(4);
+    for (int i = 0; i < queue.getCapacity(); ++i)
+        QVERIFY(queue.push(MidiMessage(0x7F4090, 0), i));
+
+    QVERIFY(!queue.push(MidiMessage(0x7F4090, 0), 100));
+    QCOMPARE(queue.getAvailableEvents(), queue.getCapacity());
+}
+
+void TestMidiEventQueue::popIsFailingWhenQueueIsEmpty()
+{
+    MidiEventQueue queue(4);
+    MidiMessage message;
+    qint64 timestamp;
+    QVERIFY(!queue.pop(message, timestamp));
+
+    queue.push(MidiMessage(0x7F4090, 0), 1);
+    queue.clear();
+    QVERIFY(!queue.pop(message, timestamp));
+}
+
+void TestMidiEventQueue::pushAndPopAreWrappingAround()
+{
+    MidiEventQueue queue(3);
+    MidiMessage message;
+    qint64 timestamp;
+    for (int i = 0; i < 10; ++i) {
+        QVERIFY(queue.push(MidiMessage(0x7F4090, i), i));
+        QVERIFY(queue.push(MidiMessage(0x7F4090, i + 100), i + 100));
+        QVERIFY(queue.pop(message, timestamp));
+        QCOMPARE(message.getSourceDeviceIndex(), i);
+        QVERIFY(queue.pop(message, timestamp));
+        QCOMPARE(timestamp, (qint64)(i + 100));
+    }
+}
+
+// +++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestMidiMessageBuffer: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void messagesAreDiscardedWhenBufferIsFull();
+    void copyAndAppendArePreservingMessages();
+    void sortByFrameOffsetIsStable();
+};
+
+void TestMidiMessageBuffer::messagesAreDiscardedWhenBufferIsFull()
+{
+    MidiMessageBuffer buffer;
+    for (int i = 0; i < MidiMessageBuffer::MAX_MESSAGES + 10; ++i)
+        buffer.addMessage(MidiMessage(0x7F4090, i));
+
+    QCOMPARE(buffer.getMessagesCount(), MidiMessageBuffer::MAX_MESSAGES);
+    QCOMPARE(buffer.getMessage(MidiMessageBuffer::MAX_MESSAGES - 1).getSourceDeviceIndex(), MidiMessageBuffer::MAX_MESSAGES - 1);
+}
+
+void TestMidiMessageBuffer::copyAndAppendArePreservingMessages()
+{
+    MidiMessageBuffer buffer;
+    buffer.addMessage(MidiMessage(0x7F4090, 0));
+    buffer.addMessage(MidiMessage(0x7F4190, 1));
+
+    MidiMessageBuffer copy(buffer);
+    copy.append(buffer);
+    QCOMPARE(copy.getMessagesCount(), 4);
+    QCOMPARE(copy.getMessage(3).getData1(), 0x41);
+
+    copy = MidiMessageBuffer();
+    QVERIFY(copy.isEmpty());
+
+    int messages = 0;
+    for (const MidiMessage &message : buffer) {
+        QCOMPARE(message.getSourceDeviceIndex(), messages);
+        messages++;
+    }
+    QCOMPARE(messages, 2);
+}
+
+void TestMidiMessageBuffer::sortByFrameOffsetIsStable()
+{
+    MidiMessageBuffer buffer;
+    buffer.addMessage(MidiMessage(0x7F4090, 0, 64));
+    buffer.addMessage(MidiMessage(0x7F4190, 1, 0));
+    buffer.addMessage(MidiMessage(0x7F4290, 2, 64));
+    buffer.addMessage(MidiMessage(0x7F4390, 3, 10));
+
+    buffer.sortByFrameOffset();
+
+    QCOMPARE(buffer.getMessage(0).getSourceDeviceIndex(), 1);
+    QCOMPARE(buffer.getMessage(1).getSourceDeviceIndex(), 3);
+    QCOMPARE(buffer.getMessage(2).getSourceDeviceIndex(), 0);
+    QCOMPARE(buffer.getMessage(3).getSourceDeviceIndex(), 2);
+}
+
 int main(int argc, char *argv[])
 {
-    TestMidiMessage test;
-    return QTest::qExec(&test, argc, argv);
+    int result = 0;
+
+    TestMidiMessage midiMessageTest;
+    result += QTest::qExec(&midiMessageTest, argc, argv);
+
+    TestMidiEventQueue midiEventQueueTest;
+    result += QTest::qExec(&midiEventQueueTest, argc, argv);
+
+    TestMidiMessageBuffer midiMessageBufferTest;
+    result += QTest::qExec(&midiMessageBufferTest, argc, argv);
+
+    return result;
 }
 
 #include "test_MidiMessage.moc"
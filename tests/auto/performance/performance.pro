@@ -0,0 +1,25 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase
+TEMPLATE = app
+TARGET = performance
+
+INCLUDEPATH += .
+INCLUDEPATH += ../../../src/Common
+VPATH += ../../../src/Common
+
+HEADERS += log/Logging.h
+HEADERS += performance/ThreadRoles.h
+HEADERS += performance/AudioCallbackStatistics.h
+HEADERS += performance/PerformanceHistory.h
+HEADERS += performance/PerformanceMonitor.h
+HEADERS += test_PerformanceMonitor.h
+SOURCES += log/logging.cpp
+SOURCES += performance/ThreadRoles.cpp
+SOURCES += performance/AudioCallbackStatistics.cpp
+SOURCES += performance/PerformanceHistory.cpp
+
+linux:SOURCES += performance/LinuxPerformanceMonitor.cpp
+
+SOURCES += test_PerformanceMonitor.cpp
+SOURCES += test_ThreadRoles.cpp
@@ -0,0 +1,127 @@
+#include "test_PerformanceMonitor.h"
+#include "performance/AudioCallbackStatistics.h"
+#include "performance/PerformanceHistory.h"
+#include "performance/PerformanceMonitor.h"
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QDateTime>
+#include <QFile>
+
+void TestAudioCallbackStatistics::dspLoadIsCallbacksTimeByBuffersPeriod()
+{
+    AudioCallbackStatistics statistics;
+    AudioCallbackStatistics::Snapshot start = statistics.getSnapshot();
+
+    for (int i = 0; i < 100; ++i)
+        statistics.addCallback(2500000, 480, 48000); // 2.5 ms processing a 10 ms buffer
+
+    QCOMPARE(statistics.getSnapshot().getDspLoad(start), 25.0);
+}
+
+void TestAudioCallbackStatistics::dspLoadWithoutCallbacksIsZero()
+{
+    AudioCallbackStatistics statistics;
+    statistics.addCallback(1000000, 480, 48000);
+    AudioCallbackStatistics::Snapshot snapshot = statistics.getSnapshot();
+
+    QCOMPARE(statistics.getSnapshot().getDspLoad(snapshot), 0.0);
+}
+
+void TestAudioCallbackStatistics::xrunsAreCounted()
+{
+    AudioCallbackStatistics statistics;
+    statistics.addXruns(true, false, false, false);
+    AudioCallbackStatistics::Snapshot first = statistics.getSnapshot();
+
+    statistics.addXruns(false, true, true, true);
+    AudioCallbackStatistics::Snapshot second = statistics.getSnapshot();
+
+    QCOMPARE(first.getXruns(), 1u);
+    QCOMPARE(second.getXruns(), 4u);
+    QCOMPARE(second.getXruns(first), 3u);
+    QCOMPARE(second.outputUnderflows, 1u);
+}
+
+void TestAudioCallbackStatistics::countersAreWrappingAround()
+{
+    AudioCallbackStatistics::Snapshot previous = AudioCallbackStatistics::Snapshot();
+    previous.processingTime = 0xFFFFFFFF - 999; // 1000 microseconds before wrap around
+    previous.bufferTime = 0xFFFFFFFF - 1999;
+
+    AudioCallbackStatistics::Snapshot current = previous;
+    current.processingTime += 2000; // wrapping around
+    current.bufferTime += 4000;
+
+    QCOMPARE(current.getDspLoad(previous), 50.0);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void TestPerformanceHistory::oldestSamplesAreDiscarded()
+{
+    PerformanceHistory history(3);
+    for (int i = 0; i < 5; ++i) {
+        PerformanceHistory::Sample sample;
+        sample.timestamp = i;
+        history.add(sample);
+    }
+
+    QCOMPARE(history.getSamples().size(), 3);
+    QCOMPARE(history.getSamples().first().timestamp, Q_INT64_C(2));
+    QCOMPARE(history.getSamples().last().timestamp, Q_INT64_C(4));
+}
+
+void TestPerformanceHistory::exportToCsv()
+{
+    PerformanceHistory history;
+    PerformanceHistory::Sample sample;
+    sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+    sample.memoryUsage = 3;
+    sample.residentMemory = 250;
+    sample.dspLoad = 12.34;
+    sample.xruns = 2;
+    history.add(sample); // CPU usage not available
+
+    sample.cpuUsage = 5.0;
+    history.add(sample);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString filePath = dir.path() + "/performance.csv";
+    QVERIFY(history.exportToCsv(filePath));
+
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QList<QByteArray> lines = file.readAll().trimmed().split('\n');
+    QCOMPARE(lines.size(), 3); // header + samples
+
+    QList<QByteArray> firstSample = lines.at(1).split(',');
+    QCOMPARE(firstSample.size(), 6);
+    QVERIFY(firstSample.at(1).isEmpty());
+    QCOMPARE(firstSample.at(3), QByteArray("250"));
+    QCOMPARE(firstSample.at(4), QByteArray("12.3"));
+    QCOMPARE(lines.at(2).split(',').at(1), QByteArray("5.0"));
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void TestPerformanceMonitor::residentMemoryAndCpuUsage()
+{
+#ifdef Q_OS_LINUX
+    PerformanceMonitor monitor;
+    QVERIFY(monitor.getResidentMemory() > 0);
+    QCOMPARE(monitor.getCpuUsage(), 0.0); // the first call is just starting the measurement
+
+    QElapsedTimer timer;
+    timer.start();
+    volatile double value = 0;
+    while (timer.elapsed() < 200) // busy
+        value += 1.0;
+
+    double cpuUsage = monitor.getCpuUsage();
+    QVERIFY(cpuUsage > 0);
+    QVERIFY(cpuUsage <= 100.0);
+#else
+    QSKIP("PerformanceMonitor is implemented only in Linux");
+#endif
+}
@@ -0,0 +1,38 @@
+#ifndef TEST_PERFORMANCE_MONITOR_H
+#define TEST_PERFORMANCE_MONITOR_H
+
+#include <QObject>
+
+class TestAudioCallbackStatistics: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dspLoadIsCallbacksTimeByBuffersPeriod();
+    void dspLoadWithoutCallbacksIsZero();
+    void xrunsAreCounted();
+    void countersAreWrappingAround();
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestPerformanceHistory: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void oldestSamplesAreDiscarded();
+    void exportToCsv();
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestPerformanceMonitor: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void residentMemoryAndCpuUsage();
+};
+
+#endif // TEST_PERFORMANCE_MONITOR_H
@@ -0,0 +1,143 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QThread>
+#include "performance/ThreadRoles.h"
+#include "test_PerformanceMonitor.h"
+
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// apply the role policy in a new thread, twice, and save what the thread is using
+class RoleThread : public QThread
+{
+public:
+    explicit RoleThread(ThreadRoles::Role role) :
+        role(role),
+        niceLevel(0),
+        cpusCount(0),
+        runningInCpu0(false)
+    {
+    }
+
+    ThreadRoles::Role role;
+    int niceLevel;
+    int cpusCount;
+    bool runningInCpu0;
+
+protected:
+    void run() override
+    {
+        ThreadRoles::applyToCurrentThread(role);
+        ThreadRoles::applyToCurrentThread(ThreadRoles::Gui); // ignored, the role is already applied
+
+#ifdef Q_OS_LINUX
+        niceLevel = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+            cpusCount = CPU_COUNT(&cpuSet);
+            runningInCpu0 = CPU_ISSET(0, &cpuSet);
+        }
+#endif
+    }
+};
+
+class TestThreadRoles: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void defaultPolicies();
+    void schedulingNames();
+    void policyIsAppliedOncePerThread();
+    void niceLevelIsApplied();
+    void threadIsPinnedToCpu();
+};
+
+void TestThreadRoles::defaultPolicies()
+{
+    QCOMPARE(ThreadRoles::getPolicy(ThreadRoles::AudioCallback).scheduling, ThreadRoles::FifoScheduling);
+    QCOMPARE(ThreadRoles::getPolicy(ThreadRoles::Encoding).scheduling, ThreadRoles::RoundRobinScheduling);
+    QVERIFY(ThreadRoles::getPolicy(ThreadRoles::Workers).isDefault());
+    QVERIFY(ThreadRoles::getPolicy(ThreadRoles::Gui).isDefault());
+}
+
+void TestThreadRoles::schedulingNames()
+{
+    for (int s = ThreadRoles::DefaultScheduling; s <= ThreadRoles::RoundRobinScheduling; ++s) {
+        ThreadRoles::Scheduling scheduling = static_cast<ThreadRoles::Scheduling>(s);
+        QCOMPARE(ThreadRoles::getSchedulingFromName(ThreadRoles::getSchedulingName(scheduling)), scheduling);
+    }
+    QCOMPARE(ThreadRoles::getSchedulingFromName("invalid"), ThreadRoles::DefaultScheduling);
+}
+
+void TestThreadRoles::policyIsAppliedOncePerThread()
+{
+    int reportSize = ThreadRoles::getReport().size();
+
+    RoleThread thread(ThreadRoles::Workers);
+    thread.start();
+    QVERIFY(thread.wait(5000));
+
+    QStringList report = ThreadRoles::getReport();
+    QCOMPARE(report.size(), reportSize + 1);
+    QVERIFY(report.last().startsWith(ThreadRoles::getRoleName(ThreadRoles::Workers)));
+}
+
+void TestThreadRoles::niceLevelIsApplied()
+{
+#ifdef Q_OS_LINUX
+    ThreadRoles::setPolicy(ThreadRoles::Logging, ThreadRoles::Policy(ThreadRoles::DefaultScheduling, 0, 7)); // positive nice levels are always permitted
+
+    RoleThread thread(ThreadRoles::Logging);
+    thread.start();
+    QVERIFY(thread.wait(5000));
+
+    QCOMPARE(thread.niceLevel, 7);
+#else
+    QSKIP("Thread policies are implemented only in Linux");
+#endif
+}
+
+void TestThreadRoles::threadIsPinnedToCpu()
+{
+#ifdef Q_OS_LINUX
+    ThreadRoles::setPolicy(ThreadRoles::Workers, ThreadRoles::Policy(ThreadRoles::DefaultScheduling, 0, 0, QList<int>() << 0));
+
+    RoleThread thread(ThreadRoles::Workers);
+    thread.start();
+    QVERIFY(thread.wait(5000));
+
+    ThreadRoles::setPolicy(ThreadRoles::Workers, ThreadRoles::getDefaultPolicy(ThreadRoles::Workers));
+
+    QCOMPARE(thread.cpusCount, 1);
+    QVERIFY(thread.runningInCpu0);
+#else
+    QSKIP("Thread policies are implemented only in Linux");
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    int result = 0;
+
+    TestThreadRoles threadRolesTest;
+    result += QTest::qExec(&threadRolesTest, argc, argv);
+
+    TestAudioCallbackStatistics audioCallbackStatisticsTest;
+    result += QTest::qExec(&audioCallbackStatisticsTest, argc, argv);
+
+    TestPerformanceHistory performanceHistoryTest;
+    result += QTest::qExec(&performanceHistoryTest, argc, argv);
+
+    TestPerformanceMonitor performanceMonitorTest;
+    result += QTest::qExec(&performanceMonitorTest, argc, argv);
+
+    return result;
+}
+
+#include "test_ThreadRoles.moc"
@@ -12,8 +12,12 @@ VPATH += ../../../src/Common
 HEADERS += log/logging.h
 HEADERS += persistence/UsersDataCache.h
 HEADERS += persistence/CacheHeader.h
+HEADERS += persistence/PluginScanCache.h
+HEADERS += tst_PluginScanCache.h
 
 SOURCES += log/logging.cpp
 SOURCES += persistence/UsersDataCache.cpp
 SOURCES += persistence/CacheHeader.cpp
+SOURCES += persistence/PluginScanCache.cpp
+SOURCES += tst_PluginScanCache.cpp
 SOURCES += tst_UsersDataCache.cpp
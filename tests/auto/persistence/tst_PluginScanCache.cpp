@@ -0,0 +1,68 @@
+#include "tst_PluginScanCache.h"
+#include "persistence/PluginScanCache.h"
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QJsonArray>
+
+using namespace Persistence;
+
+QFileInfo TestPluginScanCache::createFile(const QString &path, const QByteArray &content)
+{
+    QFile file(path);
+    file.open(QFile::WriteOnly);
+    file.write(content);
+    file.close();
+    return QFileInfo(path);
+}
+
+void TestPluginScanCache::unchangedFilesAreUpToDate()
+{
+    QTemporaryDir dir;
+    QFileInfo plugin = createFile(dir.path() + "/plugin.dll", "plugin");
+    QFileInfo notPlugin = createFile(dir.path() + "/other.dll", "other");
+
+    PluginScanCache cache;
+    QVERIFY(!cache.isUpToDate(plugin));
+
+    cache.update(plugin, true, 150);
+    cache.update(notPlugin, false, 10);
+
+    QVERIFY(cache.isUpToDate(plugin));
+    QVERIFY(cache.isUpToDate(notPlugin));
+    QVERIFY(cache.isValidPlugin(plugin.absoluteFilePath()));
+    QVERIFY(!cache.isValidPlugin(notPlugin.absoluteFilePath()));
+    QCOMPARE(cache.getValidPlugins(), QStringList() << plugin.absoluteFilePath());
+    QCOMPARE(cache.getScanTime(plugin.absoluteFilePath()), (qint64)150);
+    QCOMPARE(cache.getScanTime(dir.path() + "/missing.dll"), (qint64)-1);
+}
+
+void TestPluginScanCache::changedFilesAreNotUpToDate()
+{
+    QTemporaryDir dir;
+    QString path = dir.path() + "/plugin.dll";
+    PluginScanCache cache;
+    cache.update(createFile(path, "plugin"), true, 100);
+
+    QVERIFY(!cache.isUpToDate(createFile(path, "updated plugin"))); // new size
+
+    cache.remove(path);
+    QCOMPARE(cache.size(), 0);
+}
+
+void TestPluginScanCache::entriesAreSurvivingJsonRoundTrip()
+{
+    QTemporaryDir dir;
+    QFileInfo plugin = createFile(dir.path() + "/plugin.dll", "plugin");
+    PluginScanCache cache;
+    cache.update(plugin, true, 4500);
+
+    QJsonArray json;
+    cache.write(json);
+
+    PluginScanCache loadedCache;
+    loadedCache.read(json);
+    QCOMPARE(loadedCache.size(), 1);
+    QVERIFY(loadedCache.isUpToDate(plugin));
+    QVERIFY(loadedCache.isValidPlugin(plugin.absoluteFilePath()));
+    QCOMPARE(loadedCache.getScanTime(plugin.absoluteFilePath()), (qint64)4500);
+}
@@ -0,0 +1,20 @@
+#ifndef TST_PLUGIN_SCAN_CACHE_H
+#define TST_PLUGIN_SCAN_CACHE_H
+
+#include <QObject>
+#include <QFileInfo>
+
+class TestPluginScanCache: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void unchangedFilesAreUpToDate();
+    void changedFilesAreNotUpToDate();
+    void entriesAreSurvivingJsonRoundTrip();
+
+private:
+    static QFileInfo createFile(const QString &path, const QByteArray &content);
+};
+
+#endif // TST_PLUGIN_SCAN_CACHE_H
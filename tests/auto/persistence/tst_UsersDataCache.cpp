@@ -2,8 +2,10 @@
 #include <QObject>
 #include <QString>
 #include <QtTest/QtTest>
+#include <QTemporaryDir>
 #include "persistence/UsersDataCache.h"
 #include "persistence/CacheHeader.h"
+#include "tst_PluginScanCache.h"
 
 using namespace Persistence;
 
@@ -36,12 +38,20 @@ private slots:
     void setPanGuard();
 };
 
-// NOTE: UsersDataCache class was not able to test without side effect
-// because destructor write to storage directly.
+// NOTE: UsersDataCache is tested in temporary dirs, the cache journal is written in the cache dir.
 class TestUsersDataCache: public QObject
 {
     Q_OBJECT
 private slots:
+    void defaultEntryWhenNotCached();
+    void updatesArePersistedImmediately();
+    void lastUpdateWins();
+    void partialRecordIsDiscarded();
+    void leastRecentlyUsedEntriesAreDropped();
+    void loadTime_100k_entries();
+
+private:
+    static CacheEntry createEntry(int index, float gain);
 };
 
 void TestCacheHeader::invalidRevision()
@@ -180,6 +190,118 @@ void TestCacheEntry::setPanGuard()
     QCOMPARE(entry.getPan(), expect);
 }
 
+CacheEntry TestUsersDataCache::createEntry(int index, float gain)
+{
+    CacheEntry entry(QString("10.%1.%2.x").arg(index / 256 % 256).arg(index % 256), QString("user%1").arg(index), index % 4);
+    entry.setGain(gain);
+    return entry;
+}
+
+void TestUsersDataCache::defaultEntryWhenNotCached()
+{
+    QTemporaryDir dir;
+    UsersDataCache cache(dir.path());
+
+    CacheEntry entry = cache.getUserCacheEntry("1.2.3.x", "anon", 1);
+    QCOMPARE(entry.getUserName(), QStringLiteral("anon"));
+    QCOMPARE(entry.getGain(), CacheEntry::DEFAULT_GAIN);
+    QCOMPARE(cache.size(), 0);
+}
+
+void TestUsersDataCache::updatesArePersistedImmediately()
+{
+    QTemporaryDir dir;
+    UsersDataCache cache(dir.path());
+
+    CacheEntry entry("1.2.3.x", "anon", 1);
+    entry.setGain(0.5f);
+    entry.setPan(-1.0f);
+    entry.setMuted(true);
+    entry.setLowCutState(2);
+    cache.updateUserCacheEntry(entry);
+
+    // the first cache is still alive (not destroyed), simulating a crash
+    UsersDataCache recoveredCache(dir.path());
+    CacheEntry recoveredEntry = recoveredCache.getUserCacheEntry("1.2.3.x", "anon", 1);
+    QCOMPARE(recoveredEntry.getGain(), 0.5f);
+    QCOMPARE(recoveredEntry.getPan(), -1.0f);
+    QCOMPARE(recoveredEntry.isMuted(), true);
+    QCOMPARE(recoveredEntry.getLowCutState(), 2);
+
+    // other channel of the same user is not cached
+    QCOMPARE(recoveredCache.getUserCacheEntry("1.2.3.x", "anon", 0).getGain(), CacheEntry::DEFAULT_GAIN);
+}
+
+void TestUsersDataCache::lastUpdateWins()
+{
+    QTemporaryDir dir;
+    {
+        UsersDataCache cache(dir.path());
+        for (int i = 1; i <= 10; ++i)
+            cache.updateUserCacheEntry(createEntry(0, i / 10.0f));
+    }
+
+    UsersDataCache cache(dir.path());
+    QCOMPARE(cache.size(), 1);
+    CacheEntry entry = createEntry(0, 0);
+    QCOMPARE(cache.getUserCacheEntry(entry.getUserIP(), entry.getUserName(), entry.getChannelID()).getGain(), 1.0f);
+}
+
+void TestUsersDataCache::partialRecordIsDiscarded()
+{
+    QTemporaryDir dir;
+    {
+        UsersDataCache cache(dir.path());
+        cache.updateUserCacheEntry(createEntry(0, 0.5f));
+        cache.updateUserCacheEntry(createEntry(1, 0.7f));
+    }
+
+    // simulate a crash while appending the last record
+    QFile journal(QDir(dir.path()).absoluteFilePath("tracks_cache.journal"));
+    QVERIFY(journal.exists());
+    QVERIFY(journal.resize(journal.size() - 5));
+
+    UsersDataCache cache(dir.path());
+    QCOMPARE(cache.size(), 1);
+    CacheEntry entry = createEntry(0, 0);
+    QCOMPARE(cache.getUserCacheEntry(entry.getUserIP(), entry.getUserName(), entry.getChannelID()).getGain(), 0.5f);
+}
+
+void TestUsersDataCache::leastRecentlyUsedEntriesAreDropped()
+{
+    QTemporaryDir dir;
+    const int maxEntries = 10;
+    {
+        UsersDataCache cache(dir.path(), maxEntries);
+        for (int i = 0; i < maxEntries * 2; ++i)
+            cache.updateUserCacheEntry(createEntry(i, 0.5f));
+        QVERIFY(cache.size() <= maxEntries);
+    }
+
+    UsersDataCache cache(dir.path(), maxEntries);
+    QVERIFY(cache.size() <= maxEntries);
+    QVERIFY(cache.size() > 0);
+}
+
+void TestUsersDataCache::loadTime_100k_entries()
+{
+    QTemporaryDir dir;
+    const int entries = 100000;
+    {
+        UsersDataCache cache(dir.path(), entries);
+        for (int i = 0; i < entries; ++i)
+            cache.updateUserCacheEntry(createEntry(i, 0.5f));
+    }
+
+    int loadedEntries = 0;
+    QBENCHMARK {
+        UsersDataCache cache(dir.path(), entries);
+        loadedEntries = cache.size();
+    }
+
+    QCOMPARE(loadedEntries, entries);
+}
+
 int main(int argc, char *argv[])
 {
     int status = 0;
@@ -199,6 +321,11 @@ int main(int argc, char *argv[])
         status |= QTest::qExec(&test, argc, argv);
     }
 
+    {
+        TestPluginScanCache test;
+        status |= QTest::qExec(&test, argc, argv);
+    }
+
     return status;
 }
 
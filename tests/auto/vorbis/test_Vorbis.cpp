@@ -0,0 +1,239 @@
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QScopedPointer>
+#include <cmath>
+#include "audio/core/SamplesBuffer.h"
+#include "audio/core/SamplesRingBuffer.h"
+#include "audio/vorbis/VorbisEncoder.h"
+#include "audio/vorbis/VorbisDecoder.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace Audio;
+
+static const int SAMPLE_RATE = 44100;
+static const int INTERVAL_FRAMES = 22050;
+static const int ENCODING_BLOCK_FRAMES = 512;
+
+static QByteArray encodeInterval(VorbisEncoder &encoder, int frames)
+{
+    SamplesBuffer block(encoder.getChannels(), ENCODING_BLOCK_FRAMES);
+    QByteArray encodedInterval;
+    for (int position = 0; position < frames; position += ENCODING_BLOCK_FRAMES) {
+        block.setFrameLenght(qMin(ENCODING_BLOCK_FRAMES, frames - position));
+        for (int c = 0; c < block.getChannels(); ++c) {
+            for (int i = 0; i < block.getFrameLenght(); ++i)
+                block.set(c, i, 0.5f * std::sin(2 * M_PI * 440 * (position + i) / SAMPLE_RATE));
+        }
+        encodedInterval.append(encoder.encode(block));
+    }
+    encodedInterval.append(encoder.finishIntervalEncoding());
+    return encodedInterval;
+}
+
+static int decodeInterval(VorbisDecoder &decoder, SamplesRingBuffer &ring)
+{
+    int totalDecoded = 0;
+    SamplesBuffer out(ring.getChannels(), ring.getCapacity());
+    forever {
+        unsigned int decoded = decoder.decode(ring, ring.getCapacity());
+        if (decoded == 0)
+            break;
+
+        totalDecoded += ring.read(out, decoded);
+    }
+    return totalDecoded;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+class TestVorbis: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encodeAndDecodeInterval();
+    void reusedEncoderIsStartingNewStreams();
+    void resetEncoderIsDiscardingIntervalInProgress();
+    void resetDecoderIsDecodingNewInterval();
+    void monoIntervalIsDecodedInAllChannels();
+};
+
+void TestVorbis::encodeAndDecodeInterval()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    QByteArray interval = encodeInterval(encoder, INTERVAL_FRAMES);
+    QVERIFY(!interval.isEmpty());
+
+    VorbisDecoder decoder;
+    decoder.setInputData(interval);
+    SamplesRingBuffer ring(2, 4096);
+    QCOMPARE(decodeInterval(decoder, ring), INTERVAL_FRAMES);
+    QCOMPARE(decoder.getSampleRate(), SAMPLE_RATE);
+}
+
+void TestVorbis::reusedEncoderIsStartingNewStreams()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    encodeInterval(encoder, INTERVAL_FRAMES);
+    QByteArray secondInterval = encodeInterval(encoder, INTERVAL_FRAMES);
+
+    VorbisDecoder decoder; // the second interval is decoded without the first
+    decoder.setInputData(secondInterval);
+    SamplesRingBuffer ring(2, 4096);
+    QCOMPARE(decodeInterval(decoder, ring), INTERVAL_FRAMES);
+}
+
+void TestVorbis::resetEncoderIsDiscardingIntervalInProgress()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    SamplesBuffer block(2, ENCODING_BLOCK_FRAMES);
+    block.zero();
+    encoder.encode(block); // interval in progress
+    encoder.reset();
+
+    QByteArray interval = encodeInterval(encoder, INTERVAL_FRAMES);
+
+    VorbisDecoder decoder;
+    decoder.setInputData(interval);
+    SamplesRingBuffer ring(2, 4096);
+    QCOMPARE(decodeInterval(decoder, ring), INTERVAL_FRAMES);
+}
+
+void TestVorbis::resetDecoderIsDecodingNewInterval()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    QByteArray firstInterval = encodeInterval(encoder, INTERVAL_FRAMES);
+    QByteArray secondInterval = encodeInterval(encoder, INTERVAL_FRAMES / 2);
+
+    VorbisDecoder decoder;
+    decoder.setInputData(firstInterval);
+    SamplesRingBuffer ring(2, 4096);
+    QVERIFY(decoder.decode(ring, 256) > 0); // first interval is not finished
+
+    decoder.reset(secondInterval);
+    ring.clear();
+    QCOMPARE(decodeInterval(decoder, ring), INTERVAL_FRAMES / 2);
+}
+
+void TestVorbis::monoIntervalIsDecodedInAllChannels()
+{
+    VorbisEncoder encoder(1, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    QByteArray interval = encodeInterval(encoder, INTERVAL_FRAMES);
+
+    VorbisDecoder decoder;
+    decoder.setInputData(interval);
+    SamplesRingBuffer ring(2, INTERVAL_FRAMES);
+    QCOMPARE(decoder.decode(ring, INTERVAL_FRAMES), (unsigned int)INTERVAL_FRAMES);
+    QVERIFY(decoder.isMono());
+
+    SamplesBuffer out(2, INTERVAL_FRAMES);
+    ring.read(out, INTERVAL_FRAMES);
+    for (int i = 0; i < INTERVAL_FRAMES; i += 100)
+        QCOMPARE(out.get(0, i), out.get(1, i));
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+/***
+    Per interval setup cost: a new decoder (or encoder) for each interval versus one reused
+    decoder (or encoder) reset in each interval. Only the first samples are decoded, like the
+    interval decoders are doing when the interval is downloaded.
+ */
+class BenchmarkVorbisIntervalSetup: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void newDecoderPerInterval();
+    void reusedDecoder();
+
+    void newEncoderPerInterval();
+    void reusedEncoder();
+
+private:
+    QByteArray interval;
+
+    static const int INTERVALS = 40; // one interval for each channel in a big room
+    static const int FIRST_DECODED_FRAMES = 256;
+    static const int DECODED_SAMPLES_CAPACITY = 16384;
+};
+
+void BenchmarkVorbisIntervalSetup::initTestCase()
+{
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+    interval = encodeInterval(encoder, INTERVAL_FRAMES);
+}
+
+void BenchmarkVorbisIntervalSetup::newDecoderPerInterval()
+{
+    QBENCHMARK {
+        for (int i = 0; i < INTERVALS; ++i) {
+            QScopedPointer<VorbisDecoder> decoder(new VorbisDecoder());
+            SamplesRingBuffer decodedSamples(2, DECODED_SAMPLES_CAPACITY);
+            decoder->setInputData(interval);
+            decoder->decode(decodedSamples, FIRST_DECODED_FRAMES);
+        }
+    }
+}
+
+void BenchmarkVorbisIntervalSetup::reusedDecoder()
+{
+    VorbisDecoder decoder;
+    SamplesRingBuffer decodedSamples(2, DECODED_SAMPLES_CAPACITY);
+
+    QBENCHMARK {
+        for (int i = 0; i < INTERVALS; ++i) {
+            decoder.reset(interval);
+            decodedSamples.clear();
+            decoder.decode(decodedSamples, FIRST_DECODED_FRAMES);
+        }
+    }
+}
+
+void BenchmarkVorbisIntervalSetup::newEncoderPerInterval()
+{
+    SamplesBuffer block(2, ENCODING_BLOCK_FRAMES);
+    block.zero();
+
+    QBENCHMARK {
+        for (int i = 0; i < INTERVALS; ++i) {
+            VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+            encoder.encode(block);
+            encoder.finishIntervalEncoding();
+        }
+    }
+}
+
+void BenchmarkVorbisIntervalSetup::reusedEncoder()
+{
+    SamplesBuffer block(2, ENCODING_BLOCK_FRAMES);
+    block.zero();
+    VorbisEncoder encoder(2, SAMPLE_RATE, VorbisEncoder::QUALITY_NORMAL);
+
+    QBENCHMARK {
+        for (int i = 0; i < INTERVALS; ++i) {
+            encoder.encode(block);
+            encoder.finishIntervalEncoding();
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int result = 0;
+
+    TestVorbis vorbisTest;
+    result += QTest::qExec(&vorbisTest, argc, argv);
+
+    BenchmarkVorbisIntervalSetup intervalSetupBenchmark;
+    result += QTest::qExec(&intervalSetupBenchmark, argc, argv);
+
+    return result;
+}
+
+#include "test_Vorbis.moc"
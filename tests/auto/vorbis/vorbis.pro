@@ -0,0 +1,70 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase c++11
+TEMPLATE = app
+TARGET = vorbis
+
+ROOT_PATH = ../../..
+
+INCLUDEPATH += .
+INCLUDEPATH += $$ROOT_PATH/src/Common
+INCLUDEPATH += $$ROOT_PATH/libs/includes/ogg
+INCLUDEPATH += $$ROOT_PATH/libs/includes/vorbis
+VPATH += $$ROOT_PATH/src/Common
+
+DEFINES += OV_EXCLUDE_STATIC_CALLBACKS
+
+HEADERS += audio/core/SamplesBuffer.h
+SOURCES += audio/core/SamplesBuffer.cpp
+
+HEADERS += audio/core/SamplesRingBuffer.h
+SOURCES += audio/core/SamplesRingBuffer.cpp
+
+HEADERS += audio/core/AudioPeak.h
+SOURCES += audio/core/AudioPeak.cpp
+
+HEADERS += audio/vorbis/VorbisDecoder.h
+SOURCES += audio/vorbis/VorbisDecoder.cpp
+
+HEADERS += audio/vorbis/VorbisEncoder.h
+SOURCES += audio/vorbis/VorbisEncoder.cpp
+
+HEADERS += log/Logging.h
+SOURCES += log/logging.cpp
+
+SOURCES += test_Vorbis.cpp
+
+win32-msvc*{
+    !contains(QMAKE_TARGET.arch, x86_64) {
+        LIBS_PATH = "static/win32-msvc"
+    } else {
+        LIBS_PATH = "static/win64-msvc"
+    }
+}
+
+win32-g++{
+    LIBS_PATH = "static/win32-mingw"
+}
+
+macx{
+    !contains(QMAKE_HOST.arch, x86_64) {
+        LIBS_PATH = "static/mac32"
+    } else {
+        LIBS_PATH = "static/mac64"
+    }
+}
+
+linux{
+    contains(QMAKE_HOST.arch, x86_64) {
+        LIBS_PATH = "static/linux64"
+    } else {
+        LIBS_PATH = "static/linux32"
+    }
+}
+
+win32-msvc*{ # same debug/release libs used in Standalone.pro
+    CONFIG(release, debug|release): LIBS += -L$$PWD/$$ROOT_PATH/libs/$$LIBS_PATH -lvorbisfile -lvorbis -logg
+    else:CONFIG(debug, debug|release): LIBS += -L$$PWD/$$ROOT_PATH/libs/$$LIBS_PATH/ -lvorbisfiled -lvorbisd -loggd
+} else {
+    LIBS += -L$$PWD/$$ROOT_PATH/libs/$$LIBS_PATH -lvorbisfile -lvorbisenc -lvorbis -logg
+}